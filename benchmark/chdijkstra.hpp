@@ -1,19 +1,13 @@
 #pragma once
 
+#include "queries.hpp"
 #include <algorithms/distoracle/ch/CHDijkstra.hpp>
 #include <benchmark/benchmark.h>
-#include <graphs/edges/FMIEdge.hpp>
-#include <graphs/nodes/FMINode.hpp>
-#include <parsing/offsetarray/Parser.hpp>
-#include <random>
 
 inline auto CHDijkstraInitialization(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/ch-stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph).value();
-    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
-
+    const auto& graph = bench::chDijkstraGraph();
     for(auto _ : state) {
         algorithms::distoracle::CHDijkstra dijk{graph};
         (void)dijk;
@@ -23,33 +17,55 @@ inline auto CHDijkstraInitialization(benchmark::State& state)
 inline auto CHDijkstraGraphPreparation(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/ch-stgtregbz.txt";
     for(auto _ : state) {
         state.PauseTiming();
-        auto graph = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph).value();
+        auto graph = bench::chGraph();
         state.ResumeTiming();
         benchmark::DoNotOptimize(algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph)));
     }
 }
 
-inline auto CHDijkstraOneToOne(benchmark::State& state)
+inline auto CHSearchGraphConstruction(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/ch-stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph).value();
-    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(graphs::CHSearchGraph{bench::chGraph()});
+    }
+}
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<std::size_t> distr(0, graph.numberOfNodes() - 1);
-    algorithms::distoracle::CHDijkstra dijk{graph};
+inline auto CHDijkstraOneToOne(benchmark::State& state)
+    -> void
+{
+    bench::runOneToOne(state, bench::chDijkstra());
+}
 
-    while(state.KeepRunning()) {
-        state.PauseTiming();
-        common::NodeID s{distr(gen)};
-        common::NodeID t{distr(gen)};
-        state.ResumeTiming();
+inline auto CHDijkstraInterleavedOneToOne(benchmark::State& state)
+    -> void
+{
+    const auto& engine = bench::chDijkstra();
 
-        benchmark::DoNotOptimize(dijk.distanceBetween(s, t));
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const auto& [source, target] = bench::queryFor(state, i++);
+        benchmark::DoNotOptimize(engine.distanceBetweenInterleaved(source, target));
     }
+    state.SetItemsProcessed(state.iterations());
+}
+
+inline auto CHDijkstraDistanceTable(benchmark::State& state)
+    -> void
+{
+    bench::runDistanceTable(state, bench::chDijkstra());
+}
+
+inline auto CHDijkstraSearchGraphOneToOne(benchmark::State& state)
+    -> void
+{
+    bench::runOneToOne(state, bench::chSearchGraphDijkstra());
+}
+
+inline auto CHDijkstraSearchGraphDistanceTable(benchmark::State& state)
+    -> void
+{
+    bench::runDistanceTable(state, bench::chSearchGraphDijkstra());
 }
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "grid.hpp"
+#include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelCalculator.hpp>
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/CHSearchGraph.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+using SimpleGraph = graphs::OffsetArray<graphs::FMINode<false>, graphs::FMIEdge<false>>;
+using CHGraph = graphs::OffsetArray<graphs::FMINode<true>, graphs::FMIEdge<true>>;
+using Query = std::pair<common::NodeID, common::NodeID>;
+
+/**
+ * the input of the benchmarks, every value can be given as environment variable
+ * or as command line argument, the command line wins. without graph files a grid
+ * graph is generated, such that the benchmarks run without external data
+ *
+ *   GPF_GRAPH       --graph=<fmi file>
+ *   GPF_CH_GRAPH    --ch-graph=<fmi file with levels and shortcuts>
+ *   GPF_QUERIES     --queries=<file with one "source target" pair per line>
+ *   GPF_GRID_SIZE   --grid-size=<nodes per side of the generated grid>
+ *   GPF_SEED        --seed=<seed of the generated grid and queries>
+ *   GPF_TRANSIT_NODES --transit-nodes=<maximal number of transit nodes of the tnr oracle>
+ */
+struct Config
+{
+    std::string graph_file_;
+    std::string ch_graph_file_;
+    std::string query_file_;
+    std::size_t grid_size_ = 100;
+    std::size_t number_of_queries_ = 10000;
+    std::uint64_t seed_ = 42;
+    std::size_t number_of_transit_nodes_ = 1024;
+};
+
+inline auto config() noexcept
+    -> Config&
+{
+    static Config config;
+    return config;
+}
+
+namespace impl {
+
+inline auto applyOption(std::string_view name, std::string_view value) noexcept
+    -> bool
+{
+    auto& cfg = config();
+    if(name == "graph") {
+        cfg.graph_file_ = value;
+    } else if(name == "ch-graph") {
+        cfg.ch_graph_file_ = value;
+    } else if(name == "queries") {
+        cfg.query_file_ = value;
+    } else if(name == "grid-size") {
+        std::from_chars(value.data(), value.data() + value.size(), cfg.grid_size_);
+    } else if(name == "seed") {
+        std::from_chars(value.data(), value.data() + value.size(), cfg.seed_);
+    } else if(name == "transit-nodes") {
+        std::from_chars(value.data(), value.data() + value.size(), cfg.number_of_transit_nodes_);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace impl
+
+/**
+ * reads the environment and removes the options of the suite from argv,
+ * the remaining arguments are passed to google benchmark
+ */
+inline auto configure(int* argc, char** argv) noexcept
+    -> void
+{
+    const std::pair<const char*, const char*> environment[] = {
+        {"GPF_GRAPH", "graph"},
+        {"GPF_CH_GRAPH", "ch-graph"},
+        {"GPF_QUERIES", "queries"},
+        {"GPF_GRID_SIZE", "grid-size"},
+        {"GPF_SEED", "seed"},
+        {"GPF_TRANSIT_NODES", "transit-nodes"}};
+
+    for(const auto& [variable, name] : environment) {
+        if(const auto* value = std::getenv(variable)) {
+            impl::applyOption(name, value);
+        }
+    }
+
+    int kept = 1;
+    for(int i = 1; i < *argc; i++) {
+        const std::string_view argument{argv[i]};
+        const auto equal = argument.find('=');
+
+        if(argument.starts_with("--")
+           and equal != std::string_view::npos
+           and impl::applyOption(argument.substr(2, equal - 2), argument.substr(equal + 1))) {
+            continue;
+        }
+
+        argv[kept++] = argv[i];
+    }
+    *argc = kept;
+}
+
+/**
+ * generates the grid graphs into the temp directory if no graph files are configured
+ */
+inline auto ensureGraphFiles() noexcept
+    -> void
+{
+    static const bool generated = [] {
+        auto& cfg = config();
+        if(!cfg.graph_file_.empty() and !cfg.ch_graph_file_.empty()) {
+            return false;
+        }
+
+        const auto dir = std::filesystem::temp_directory_path();
+        const auto name = fmt::format("gpf-grid-{}-{}", cfg.grid_size_, cfg.seed_);
+        const auto graph_file = (dir / (name + ".txt")).string();
+        const auto ch_graph_file = (dir / ("ch-" + name + ".txt")).string();
+
+        if(!writeGridGraphs(graph_file, ch_graph_file, cfg.grid_size_, cfg.seed_)) {
+            fmt::print(stderr, "unable to write the grid graphs to {}\n", dir.string());
+            std::exit(1);
+        }
+
+        if(cfg.graph_file_.empty()) {
+            cfg.graph_file_ = graph_file;
+        }
+        if(cfg.ch_graph_file_.empty()) {
+            cfg.ch_graph_file_ = ch_graph_file;
+        }
+        return true;
+    }();
+    (void)generated;
+}
+
+inline auto graphFile() noexcept
+    -> const std::string&
+{
+    ensureGraphFiles();
+    return config().graph_file_;
+}
+
+inline auto chGraphFile() noexcept
+    -> const std::string&
+{
+    ensureGraphFiles();
+    return config().ch_graph_file_;
+}
+
+template<class Graph>
+[[nodiscard]] inline auto parseGraph(const std::string& file) noexcept
+    -> Graph
+{
+    using Node = typename Graph::NodeType;
+    using Edge = typename Graph::EdgeType;
+
+    auto graph_opt = parsing::parseFromFMIFile<Node, Edge>(file);
+    if(!graph_opt) {
+        fmt::print(stderr, "unable to parse {}\n", file);
+        std::exit(1);
+    }
+    return std::move(graph_opt.value());
+}
+
+/**
+ * the graphs are parsed and prepared once and shared by all benchmarks and threads
+ */
+inline auto simpleGraph() noexcept
+    -> const SimpleGraph&
+{
+    static const auto graph = parseGraph<SimpleGraph>(graphFile());
+    return graph;
+}
+
+inline auto chGraph() noexcept
+    -> const CHGraph&
+{
+    static const auto graph = parseGraph<CHGraph>(chGraphFile());
+    return graph;
+}
+
+inline auto chDijkstraGraph() noexcept
+    -> const CHGraph&
+{
+    static const auto graph = algorithms::distoracle::prepareGraphForCHDijkstra(chGraph());
+    return graph;
+}
+
+inline auto phastGraph() noexcept
+    -> const CHGraph&
+{
+    static const auto graph = algorithms::distoracle::prepareGraphForPHAST(chGraph());
+    return graph;
+}
+
+inline auto chSearchGraph() noexcept
+    -> const graphs::CHSearchGraph&
+{
+    static const graphs::CHSearchGraph graph{chGraph()};
+    return graph;
+}
+
+inline auto hubLabelGraph() noexcept
+    -> const CHGraph&
+{
+    static const auto graph = algorithms::distoracle::prepareGraphForHubLabelCalculator(chGraph());
+    return graph;
+}
+
+/**
+ * the query set is read from the configured query file, if the file does not exist the
+ * queries are drawn with the configured seed and written to it, such that later runs
+ * answer exactly the same queries
+ */
+inline auto queries() noexcept
+    -> const std::vector<Query>&
+{
+    static const auto query_set = [] {
+        const auto& cfg = config();
+        const auto number_of_nodes = chGraph().numberOfNodes();
+        std::vector<Query> queries;
+
+        if(!cfg.query_file_.empty()) {
+            std::ifstream input(cfg.query_file_);
+            std::size_t source;
+            std::size_t target;
+            while(input >> source >> target) {
+                if(source < number_of_nodes and target < number_of_nodes) {
+                    queries.emplace_back(common::NodeID{source}, common::NodeID{target});
+                }
+            }
+        }
+
+        if(!queries.empty()) {
+            return queries;
+        }
+
+        std::mt19937_64 gen(cfg.seed_);
+        std::uniform_int_distribution<std::size_t> distr(0, number_of_nodes - 1);
+        for(std::size_t i = 0; i < cfg.number_of_queries_; i++) {
+            queries.emplace_back(common::NodeID{distr(gen)}, common::NodeID{distr(gen)});
+        }
+
+        if(!cfg.query_file_.empty()) {
+            std::ofstream output(cfg.query_file_);
+            for(const auto& [source, target] : queries) {
+                output << source.get() << ' ' << target.get() << '\n';
+            }
+        }
+
+        return queries;
+    }();
+
+    return query_set;
+}
+
+/**
+ * the i-th query of the calling benchmark thread, the threads
+ * of a benchmark walk through disjoint parts of the query set
+ */
+inline auto queryFor(const benchmark::State& state, std::size_t i) noexcept
+    -> const Query&
+{
+    const auto& query_set = queries();
+    const auto idx = i * static_cast<std::size_t>(state.threads())
+        + static_cast<std::size_t>(state.thread_index());
+    return query_set[idx % query_set.size()];
+}
+
+/**
+ * the targets of the first count queries
+ */
+inline auto queryTargets(std::size_t count) noexcept
+    -> std::vector<common::NodeID>
+{
+    std::vector<common::NodeID> targets;
+    targets.reserve(count);
+    for(std::size_t i = 0; i < count; i++) {
+        targets.emplace_back(queries()[i % queries().size()].second);
+    }
+    return targets;
+}
+
+/**
+ * records the input of the run in the context section of the json output
+ */
+inline auto addContext() noexcept
+    -> void
+{
+    const auto& cfg = config();
+    benchmark::AddCustomContext("graph", graphFile());
+    benchmark::AddCustomContext("ch_graph", chGraphFile());
+    benchmark::AddCustomContext("queries", cfg.query_file_.empty() ? "generated" : cfg.query_file_);
+    benchmark::AddCustomContext("seed", std::to_string(cfg.seed_));
+}
+
+} // namespace bench
@@ -1,18 +1,16 @@
 #pragma once
 
+#include "queries.hpp"
+#include <algorithms/distoracle/dijkstra/DeltaStepping.hpp>
 #include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
 #include <benchmark/benchmark.h>
-#include <graphs/edges/FMIEdge.hpp>
-#include <graphs/nodes/FMINode.hpp>
-#include <parsing/offsetarray/Parser.hpp>
-#include <random>
+#include <tbb/global_control.h>
 
 
 inline auto DijkstraInitialization(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph).value();
+    const auto& graph = bench::simpleGraph();
     for(auto _ : state) {
         algorithms::distoracle::Dijkstra dijk{graph};
         (void)dijk;
@@ -22,40 +20,30 @@ inline auto DijkstraInitialization(benchmark::State& state)
 inline auto DijkstraOneToOne(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph).value();
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<std::size_t> distr(0, graph.numberOfNodes() - 1);
-    algorithms::distoracle::Dijkstra dijk{graph};
-
-    while(state.KeepRunning()) {
-        state.PauseTiming();
-        common::NodeID s{distr(gen)};
-        common::NodeID t{distr(gen)};
-        state.ResumeTiming();
-
-        benchmark::DoNotOptimize(dijk.distanceBetween(s, t));
-    }
+    bench::runOneToOne(state, bench::dijkstra());
 }
 
 inline auto DijkstraOneToAll(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph).value();
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<std::size_t> distr(0, graph.numberOfNodes() - 1);
-    algorithms::distoracle::Dijkstra dijk{graph};
+    bench::runOneToAll(state, bench::dijkstra());
+}
 
-    while(state.KeepRunning()) {
-        state.PauseTiming();
-        common::NodeID s{distr(gen)};
-        state.ResumeTiming();
+inline auto DijkstraDistanceTable(benchmark::State& state)
+    -> void
+{
+    bench::runDistanceTable(state, bench::dijkstra());
+}
 
-        benchmark::DoNotOptimize(dijk.distancesFrom(s));
-    }
+/**
+ * a single query uses all threads, range(0) limits the number of threads, such that
+ * the scaling can be compared to the sequential DijkstraOneToAll
+ */
+inline auto DeltaSteppingOneToAll(benchmark::State& state)
+    -> void
+{
+    const auto& engine = bench::deltaStepping();
+    const tbb::global_control limit{tbb::global_control::max_allowed_parallelism,
+                                    static_cast<std::size_t>(state.range(0))};
+    bench::runOneToAll(state, engine);
 }
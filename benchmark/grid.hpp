@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fmt/core.h>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bench {
+
+namespace impl {
+
+struct GridEdge
+{
+    std::size_t src_;
+    std::size_t trg_;
+    std::int64_t weight_;
+    std::int64_t first_child_ = -1;
+    std::int64_t second_child_ = -1;
+};
+
+// deterministic pseudo random number in [0, 2^32), such that the same seed always
+// generates the same graph independent of the standard library
+inline auto splitmix(std::uint64_t x) noexcept
+    -> std::uint64_t
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return (x ^ (x >> 31)) >> 32;
+}
+
+// the remaining graph of a running contraction, the maps hold the best edge
+// between every pair of not yet contracted nodes
+class Contraction
+{
+public:
+    Contraction(std::vector<GridEdge>& edges, std::size_t number_of_nodes) noexcept
+        : edges_(edges),
+          outgoing_(number_of_nodes),
+          ingoing_(number_of_nodes),
+          contracted_(number_of_nodes, false),
+          distances_(number_of_nodes, std::numeric_limits<std::int64_t>::max())
+    {
+        for(std::size_t id = 0; id < edges_.size(); id++) {
+            outgoing_[edges_[id].src_][edges_[id].trg_] = id;
+            ingoing_[edges_[id].trg_][edges_[id].src_] = id;
+        }
+    }
+
+    // the edge difference of a node, i.e. the number of shortcuts its contraction
+    // adds minus the number of edges it removes
+    [[nodiscard]] auto edgeDifference(std::size_t node) noexcept
+        -> std::int64_t
+    {
+        const auto shortcuts = static_cast<std::int64_t>(contract(node, true));
+        const auto removed = static_cast<std::int64_t>(outgoing_[node].size() + ingoing_[node].size());
+        return shortcuts - removed;
+    }
+
+    /**
+     * adds the shortcuts needed to remove the node from the remaining graph,
+     * if simulate is set the shortcuts are only counted
+     * @returns the number of shortcuts
+     */
+    auto contract(std::size_t node, bool simulate) noexcept
+        -> std::size_t
+    {
+        std::size_t shortcuts = 0;
+
+        for(const auto& [src, in_id] : ingoing_[node]) {
+            std::int64_t limit = 0;
+            for(const auto& [trg, out_id] : outgoing_[node]) {
+                limit = std::max(limit, edges_[in_id].weight_ + edges_[out_id].weight_);
+            }
+
+            witnessSearch(src, node, limit);
+
+            for(const auto& [trg, out_id] : outgoing_[node]) {
+                const auto weight = edges_[in_id].weight_ + edges_[out_id].weight_;
+                if(trg == src or distances_[trg] <= weight) {
+                    continue;
+                }
+
+                shortcuts++;
+                if(simulate) {
+                    continue;
+                }
+
+                const auto id = edges_.size();
+                edges_.push_back(GridEdge{src,
+                                          trg,
+                                          weight,
+                                          static_cast<std::int64_t>(in_id),
+                                          static_cast<std::int64_t>(out_id)});
+                outgoing_[src][trg] = id;
+                ingoing_[trg][src] = id;
+            }
+
+            for(const auto touched_node : touched_) {
+                distances_[touched_node] = std::numeric_limits<std::int64_t>::max();
+            }
+            touched_.clear();
+        }
+
+        if(!simulate) {
+            for(const auto& [neig, _] : outgoing_[node]) {
+                ingoing_[neig].erase(node);
+            }
+            for(const auto& [neig, _] : ingoing_[node]) {
+                outgoing_[neig].erase(node);
+            }
+            outgoing_[node].clear();
+            ingoing_[node].clear();
+            contracted_[node] = true;
+        }
+
+        return shortcuts;
+    }
+
+    [[nodiscard]] auto neighboursOf(std::size_t node) const noexcept
+        -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> neighbours;
+        for(const auto& [neig, _] : outgoing_[node]) {
+            neighbours.emplace_back(neig);
+        }
+        for(const auto& [neig, _] : ingoing_[node]) {
+            neighbours.emplace_back(neig);
+        }
+        return neighbours;
+    }
+
+private:
+    // distances of the shortest paths from src within limit which avoid the node currently
+    // contracted, the search is bounded, a missed witness only adds a superfluous shortcut
+    auto witnessSearch(std::size_t src, std::size_t avoid, std::int64_t limit) noexcept
+        -> void
+    {
+        constexpr std::size_t max_settled = 500;
+
+        using Entry = std::pair<std::int64_t, std::size_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+
+        distances_[src] = 0;
+        touched_.emplace_back(src);
+        heap.emplace(0, src);
+
+        std::size_t settled = 0;
+        while(!heap.empty() and settled < max_settled) {
+            const auto [dist, node] = heap.top();
+            heap.pop();
+
+            if(dist > distances_[node]) {
+                continue;
+            }
+            if(dist > limit) {
+                break;
+            }
+            settled++;
+
+            for(const auto& [trg, id] : outgoing_[node]) {
+                if(trg == avoid) {
+                    continue;
+                }
+
+                const auto new_dist = dist + edges_[id].weight_;
+                if(new_dist < distances_[trg]) {
+                    if(distances_[trg] == std::numeric_limits<std::int64_t>::max()) {
+                        touched_.emplace_back(trg);
+                    }
+                    distances_[trg] = new_dist;
+                    heap.emplace(new_dist, trg);
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<GridEdge>& edges_;
+    std::vector<std::unordered_map<std::size_t, std::size_t>> outgoing_;
+    std::vector<std::unordered_map<std::size_t, std::size_t>> ingoing_;
+    std::vector<bool> contracted_;
+    std::vector<std::int64_t> distances_;
+    std::vector<std::size_t> touched_;
+};
+
+} // namespace impl
+
+/**
+ * writes a road like grid graph of size x size nodes to graph_file and a contraction
+ * hierarchy of it to ch_graph_file, both in the fmi format. every eighth row and column
+ * is a fast road, all other edges get a random travel time. the hierarchy is contracted
+ * in edge difference order with bounded witness searches
+ */
+inline auto writeGridGraphs(const std::string& graph_file,
+                            const std::string& ch_graph_file,
+                            std::size_t size,
+                            std::uint64_t seed) noexcept
+    -> bool
+{
+    const auto number_of_nodes = size * size;
+
+    std::vector<impl::GridEdge> edges;
+    const auto add_road = [&](std::size_t src, std::size_t trg, bool fast) {
+        const auto base = fast ? 40 : 100;
+        const auto noise = static_cast<std::int64_t>(impl::splitmix(seed ^ edges.size()) % 50);
+        edges.push_back(impl::GridEdge{src, trg, base + noise});
+        edges.push_back(impl::GridEdge{trg, src, base + noise});
+    };
+
+    for(std::size_t y = 0; y < size; y++) {
+        for(std::size_t x = 0; x < size; x++) {
+            const auto node = y * size + x;
+            if(x + 1 < size) {
+                add_road(node, node + 1, y % 8 == 0);
+            }
+            if(y + 1 < size) {
+                add_road(node, node + size, x % 8 == 0);
+            }
+        }
+    }
+
+    const auto number_of_original_edges = edges.size();
+
+    // contract the node with the smallest edge difference first, the priorities are
+    // updated lazily when a node is popped and for the neighbours of contracted nodes
+    impl::Contraction contraction{edges, number_of_nodes};
+    std::vector<std::int64_t> deleted_neighbours(number_of_nodes, 0);
+    std::vector<std::size_t> levels(number_of_nodes, 0);
+
+    const auto priority = [&](std::size_t node) {
+        return contraction.edgeDifference(node) + deleted_neighbours[node];
+    };
+
+    using Entry = std::pair<std::int64_t, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+    for(std::size_t node = 0; node < number_of_nodes; node++) {
+        queue.emplace(priority(node), node);
+    }
+
+    std::vector<bool> contracted(number_of_nodes, false);
+    std::size_t rank = 0;
+    while(!queue.empty()) {
+        const auto [old_priority, node] = queue.top();
+        queue.pop();
+
+        if(contracted[node]) {
+            continue;
+        }
+
+        const auto new_priority = priority(node);
+        if(!queue.empty() and new_priority > queue.top().first) {
+            queue.emplace(new_priority, node);
+            continue;
+        }
+
+        const auto neighbours = contraction.neighboursOf(node);
+        contraction.contract(node, false);
+        contracted[node] = true;
+        levels[node] = rank++;
+
+        for(const auto neig : neighbours) {
+            deleted_neighbours[neig]++;
+        }
+    }
+
+    std::ofstream graph_out(graph_file);
+    std::ofstream ch_graph_out(ch_graph_file);
+    if(!graph_out or !ch_graph_out) {
+        return false;
+    }
+
+    graph_out << fmt::format("# grid {}x{} seed {}\n\n{}\n{}\n",
+                             size,
+                             size,
+                             seed,
+                             number_of_nodes,
+                             number_of_original_edges);
+    ch_graph_out << fmt::format("# grid {}x{} seed {}\n\n{}\n{}\n",
+                                size,
+                                size,
+                                seed,
+                                number_of_nodes,
+                                edges.size());
+
+    for(std::size_t node = 0; node < number_of_nodes; node++) {
+        const auto lat = 48.7 + static_cast<double>(node / size) * 0.001;
+        const auto lng = 9.1 + static_cast<double>(node % size) * 0.0015;
+
+        graph_out << fmt::format("{} {} {:.7f} {:.7f} 0\n", node, node, lat, lng);
+        ch_graph_out << fmt::format("{} {} {:.7f} {:.7f} 0 {}\n", node, node, lat, lng, levels[node]);
+    }
+
+    for(std::size_t id = 0; id < edges.size(); id++) {
+        const auto& edge = edges[id];
+
+        if(id < number_of_original_edges) {
+            graph_out << fmt::format("{} {} {} 3 50\n", edge.src_, edge.trg_, edge.weight_);
+            ch_graph_out << fmt::format("{} {} {} 3 50 -1 -1\n", edge.src_, edge.trg_, edge.weight_);
+        } else {
+            ch_graph_out << fmt::format("{} {} {} 0 -1 {} {}\n",
+                                        edge.src_,
+                                        edge.trg_,
+                                        edge.weight_,
+                                        edge.first_child_,
+                                        edge.second_child_);
+        }
+    }
+
+    return true;
+}
+
+} // namespace bench
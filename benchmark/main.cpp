@@ -1,10 +1,20 @@
 #include <benchmark/benchmark.h>
 
-#include "parsing.hpp"
-#include "dijkstra.hpp"
+#include "config.hpp"
+
 #include "chdijkstra.hpp"
+#include "dijkstra.hpp"
 #include "hublabels.hpp"
+#include "parsing.hpp"
 #include "phast.hpp"
+#include "reordering.hpp"
+#include "tnr.hpp"
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+static const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
 
 //parsing
 BENCHMARK(FMINodeWithoutLevelParsing);
@@ -13,23 +23,76 @@ BENCHMARK(FMIEdgeWithoutShortcutParsing);
 BENCHMARK(FMIEdgeWithShortcutParsing);
 BENCHMARK(SimpleToyGraphParsing)->Unit(benchmark::kMicrosecond);
 BENCHMARK(CHToyGraphParsing)->Unit(benchmark::kMicrosecond);
-BENCHMARK(SimpleStgGraphParsing)->Unit(benchmark::kSecond);
-BENCHMARK(CHStgGraphParsing)->Unit(benchmark::kSecond);
-
-BENCHMARK(DijkstraInitialization)->Unit(benchmark::kMicrosecond);
-BENCHMARK(DijkstraOneToOne)->Unit(benchmark::kMillisecond)->Iterations(100);
-BENCHMARK(DijkstraOneToAll)->Unit(benchmark::kMillisecond)->Iterations(50);
+BENCHMARK(SimpleGraphParsing)->Unit(benchmark::kMillisecond);
+BENCHMARK(CHGraphParsing)->Unit(benchmark::kMillisecond);
 
+//preparation
 BENCHMARK(CHDijkstraGraphPreparation)->Unit(benchmark::kMillisecond)->Iterations(10);
-BENCHMARK(CHDijkstraInitialization)->Unit(benchmark::kMillisecond);
-BENCHMARK(CHDijkstraOneToOne)->Unit(benchmark::kMicrosecond)->Iterations(10000);
-
+BENCHMARK(PHASTGraphPreparation)->Unit(benchmark::kMillisecond)->Iterations(10);
+BENCHMARK(CHSearchGraphConstruction)->Unit(benchmark::kMillisecond)->Iterations(10);
 BENCHMARK(HubLabelsGraphPreparation)->Unit(benchmark::kMillisecond)->Iterations(10);
-BENCHMARK(HubLabelsComputation)->Unit(benchmark::kSecond);
-BENCHMARK(HubLabelsOneToOne)->Unit(benchmark::kMicrosecond);
+BENCHMARK(HubLabelsComputation)->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK(TransitNodeRoutingPreprocessing)->Unit(benchmark::kMillisecond)->Iterations(1);
 
-BENCHMARK(PHASTGraphPreparation)->Unit(benchmark::kMillisecond)->Iterations(10);
+BENCHMARK(DijkstraInitialization)->Unit(benchmark::kMicrosecond);
+BENCHMARK(CHDijkstraInitialization)->Unit(benchmark::kMicrosecond);
 BENCHMARK(PHASTInitialization)->Unit(benchmark::kMicrosecond);
-BENCHMARK(PHASTOneToAll)->Unit(benchmark::kMillisecond)->Iterations(50);
 
-BENCHMARK_MAIN();
+//one to one, the engines are shared by all threads
+BENCHMARK(DijkstraOneToOne)->Unit(benchmark::kMillisecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(CHDijkstraOneToOne)->Unit(benchmark::kMicrosecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(CHDijkstraInterleavedOneToOne)->Unit(benchmark::kMicrosecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(CHDijkstraSearchGraphOneToOne)->Unit(benchmark::kMicrosecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(HubLabelsOneToOne)->Unit(benchmark::kMicrosecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(TransitNodeRoutingOneToOne)->Unit(benchmark::kMicrosecond)->ThreadRange(1, max_threads)->UseRealTime();
+
+//one to all
+BENCHMARK(DijkstraOneToAll)->Unit(benchmark::kMillisecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(DeltaSteppingOneToAll)->Unit(benchmark::kMillisecond)->RangeMultiplier(2)->Range(1, max_threads)->UseRealTime();
+BENCHMARK(PHASTOneToAll)->Unit(benchmark::kMillisecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(PHASTSearchGraphOneToAll)->Unit(benchmark::kMillisecond)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(PHASTIsochrone15Minutes)->Unit(benchmark::kMillisecond)->ThreadRange(1, max_threads)->UseRealTime();
+
+//one to many and many to many, {sources, targets}
+BENCHMARK(DijkstraDistanceTable)->Unit(benchmark::kMillisecond)->Args({1, 1000})->Args({100, 100})->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(CHDijkstraDistanceTable)->Unit(benchmark::kMillisecond)->Args({1, 1000})->Args({100, 100})->Args({1000, 1000})->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(CHDijkstraSearchGraphDistanceTable)->Unit(benchmark::kMillisecond)->Args({1, 1000})->Args({100, 100})->Args({1000, 1000})->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(PHASTDistanceTable)->Unit(benchmark::kMillisecond)->Args({1, 1000})->Args({100, 100})->Args({1000, 1000})->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(HubLabelsDistanceTable)->Unit(benchmark::kMillisecond)->Args({1, 1000})->Args({100, 100})->Args({1000, 1000})->ThreadRange(1, max_threads)->UseRealTime();
+
+//node orderings
+BENCHMARK(CHDijkstraOneToOneFileOrder)->Unit(benchmark::kMicrosecond)->Iterations(10000);
+BENCHMARK(CHDijkstraOneToOneHilbertOrder)->Unit(benchmark::kMicrosecond)->Iterations(10000);
+BENCHMARK(CHDijkstraOneToOneBFSOrder)->Unit(benchmark::kMicrosecond)->Iterations(10000);
+BENCHMARK(CHDijkstraOneToOneLevelThenHilbertOrder)->Unit(benchmark::kMicrosecond)->Iterations(10000);
+BENCHMARK(PHASTOneToAllLevelThenHilbertOrder)->Unit(benchmark::kMillisecond)->Iterations(50);
+
+// the results are written as json for regression tracking unless
+// another output file is given with --benchmark_out
+auto main(int argc, char** argv)
+    -> int
+{
+    bench::configure(&argc, argv);
+
+    std::vector<char*> arguments(argv, argv + argc);
+    const auto has_output = std::any_of(std::begin(arguments), std::end(arguments), [](const auto* argument) {
+        return std::string_view{argument}.starts_with("--benchmark_out=");
+    });
+
+    std::string output = "--benchmark_out=benchmark-results.json";
+    std::string format = "--benchmark_out_format=json";
+    if(!has_output) {
+        arguments.emplace_back(output.data());
+        arguments.emplace_back(format.data());
+    }
+
+    auto number_of_arguments = static_cast<int>(arguments.size());
+    benchmark::Initialize(&number_of_arguments, arguments.data());
+    if(benchmark::ReportUnrecognizedArguments(number_of_arguments, arguments.data())) {
+        return 1;
+    }
+
+    bench::addContext();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "config.hpp"
 #include <benchmark/benchmark.h>
 #include <graphs/edges/FMIEdge.hpp>
 #include <graphs/nodes/FMINode.hpp>
@@ -52,17 +53,17 @@ inline void CHToyGraphParsing(benchmark::State& state)
     }
 }
 
-inline void SimpleStgGraphParsing(benchmark::State& state)
+inline void SimpleGraphParsing(benchmark::State& state)
 {
-    const auto* const example_graph = "../data/stgtregbz.txt";
+    const auto& example_graph = bench::graphFile();
     for(auto _ : state) {
         benchmark::DoNotOptimize(parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph));
     }
 }
 
-inline void CHStgGraphParsing(benchmark::State& state)
+inline void CHGraphParsing(benchmark::State& state)
 {
-    const auto* const example_graph = "../data/ch-stgtregbz.txt";
+    const auto& example_graph = bench::chGraphFile();
     for(auto _ : state) {
         benchmark::DoNotOptimize(parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph));
     }
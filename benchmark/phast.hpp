@@ -1,20 +1,17 @@
 #pragma once
 
+#include "queries.hpp"
 #include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/PHASTIsochrone.hpp>
 #include <benchmark/benchmark.h>
-#include <graphs/edges/FMIEdge.hpp>
-#include <graphs/nodes/FMINode.hpp>
-#include <parsing/offsetarray/Parser.hpp>
-#include <random>
 
 
 inline auto PHASTGraphPreparation(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/ch-stgtregbz.txt";
     for(auto _ : state) {
         state.PauseTiming();
-        auto graph = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph).value();
+        auto graph = bench::chGraph();
         state.ResumeTiming();
         benchmark::DoNotOptimize(algorithms::distoracle::prepareGraphForPHAST(std::move(graph)));
     }
@@ -23,10 +20,7 @@ inline auto PHASTGraphPreparation(benchmark::State& state)
 inline auto PHASTInitialization(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/ch-stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph).value();
-    graph = algorithms::distoracle::prepareGraphForPHAST(std::move(graph));
-
+    const auto& graph = bench::phastGraph();
     while(state.KeepRunning()) {
         algorithms::distoracle::PHAST phast{graph};
         (void)phast;
@@ -36,21 +30,32 @@ inline auto PHASTInitialization(benchmark::State& state)
 inline auto PHASTOneToAll(benchmark::State& state)
     -> void
 {
-    const char* const example_graph = "../data/ch-stgtregbz.txt";
-    auto graph = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph).value();
-    graph = algorithms::distoracle::prepareGraphForPHAST(std::move(graph));
-    algorithms::distoracle::PHAST phast{graph};
+    bench::runOneToAll(state, bench::phast());
+}
 
+inline auto PHASTDistanceTable(benchmark::State& state)
+    -> void
+{
+    bench::runDistanceTable(state, bench::phast());
+}
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<std::size_t> distr(0, graph.numberOfNodes() - 1);
+inline auto PHASTSearchGraphOneToAll(benchmark::State& state)
+    -> void
+{
+    bench::runOneToAll(state, bench::chSearchGraphPHAST());
+}
 
-    while(state.KeepRunning()) {
-        state.PauseTiming();
-        common::NodeID s{distr(gen)};
-        state.ResumeTiming();
+inline auto PHASTIsochrone15Minutes(benchmark::State& state)
+    -> void
+{
+    static const algorithms::distoracle::PHASTIsochrone isochrone{bench::phastGraph()};
+
+    // the weights are travel times in 1/100 seconds
+    const auto limit = common::Weight{15 * 60 * 100};
 
-        benchmark::DoNotOptimize(phast.distancesFrom(s));
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const auto& [source, _target] = bench::queryFor(state, i++);
+        benchmark::DoNotOptimize(isochrone.isochroneFrom(source, limit));
     }
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "config.hpp"
+#include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/dijkstra/DeltaStepping.hpp>
+#include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelCalculator.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelLookup.hpp>
+#include <algorithms/distoracle/tnr/TransitNodeRouting.hpp>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace bench {
+
+/**
+ * the engines are built once and shared by all threads of a benchmark,
+ * every thread queries them with its own thread local search context
+ */
+inline auto dijkstra() noexcept
+    -> const algorithms::distoracle::Dijkstra<SimpleGraph>&
+{
+    static const algorithms::distoracle::Dijkstra engine{simpleGraph()};
+    return engine;
+}
+
+inline auto deltaStepping() noexcept
+    -> const algorithms::distoracle::DeltaStepping<SimpleGraph>&
+{
+    static const algorithms::distoracle::DeltaStepping engine{simpleGraph()};
+    return engine;
+}
+
+inline auto chDijkstra() noexcept
+    -> const algorithms::distoracle::CHDijkstra<CHGraph>&
+{
+    static const algorithms::distoracle::CHDijkstra engine{chDijkstraGraph()};
+    return engine;
+}
+
+inline auto phast() noexcept
+    -> const algorithms::distoracle::PHAST<graphs::FMINode<true>, graphs::FMIEdge<true>>&
+{
+    static const algorithms::distoracle::PHAST engine{phastGraph()};
+    return engine;
+}
+
+/**
+ * the engines on the ch search graph answer the same queries, but the ids
+ * are ranks of the search graph, i.e. the queried node pairs differ
+ */
+inline auto chSearchGraphDijkstra() noexcept
+    -> const algorithms::distoracle::CHDijkstra<graphs::CHSearchGraph>&
+{
+    static const algorithms::distoracle::CHDijkstra engine{chSearchGraph()};
+    return engine;
+}
+
+inline auto chSearchGraphPHAST() noexcept
+    -> const algorithms::distoracle::BasicPHAST<graphs::CHSearchGraph>&
+{
+    static const algorithms::distoracle::BasicPHAST engine{chSearchGraph()};
+    return engine;
+}
+
+inline auto hubLabels() noexcept
+    -> const algorithms::distoracle::HubLabelLookup&
+{
+    static const auto lookup = [] {
+        algorithms::distoracle::HubLabelCalculator calculator{hubLabelGraph()};
+        return calculator.constructHubLabelLookupInParallel();
+    }();
+    return lookup;
+}
+
+inline auto transitNodeRouting() noexcept
+    -> const algorithms::distoracle::TransitNodeRouting<CHGraph>&
+{
+    static const algorithms::distoracle::TransitNodeRouting engine{chDijkstraGraph(),
+                                                                   config().number_of_transit_nodes_};
+    return engine;
+}
+
+template<class Oracle>
+auto runOneToOne(benchmark::State& state, const Oracle& oracle) noexcept
+    -> void
+{
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const auto& [source, target] = queryFor(state, i++);
+        benchmark::DoNotOptimize(oracle.distanceBetween(source, target));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<class Oracle>
+auto runOneToAll(benchmark::State& state, const Oracle& oracle) noexcept
+    -> void
+{
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const auto& [source, _target] = queryFor(state, i++);
+        benchmark::DoNotOptimize(oracle.distancesFrom(source).data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * computes tables of range(0) sources times range(1) targets, a single source is the
+ * one to many case. the sources change with every iteration, such that no engine can
+ * answer from the search of the previous iteration
+ */
+template<class Oracle>
+auto runDistanceTable(benchmark::State& state, const Oracle& oracle) noexcept
+    -> void
+{
+    const auto number_of_sources = static_cast<std::size_t>(state.range(0));
+    const auto number_of_targets = static_cast<std::size_t>(state.range(1));
+
+    const auto targets = queryTargets(number_of_targets);
+    std::vector<common::NodeID> sources(number_of_sources);
+    std::vector<common::Weight> out(number_of_sources * number_of_targets);
+
+    std::size_t i = 0;
+    for(auto _ : state) {
+        for(auto& source : sources) {
+            source = queryFor(state, i++).first;
+        }
+
+        benchmark::DoNotOptimize(oracle.distanceTable(sources, targets, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+}
+
+} // namespace bench
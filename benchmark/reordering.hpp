@@ -0,0 +1,86 @@
+#pragma once
+
+#include "config.hpp"
+#include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <benchmark/benchmark.h>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/NodeOrdering.hpp>
+#include <numeric>
+
+namespace impl {
+
+// the queries of the query set are given in the original node ids and mapped
+// into the reordered graph, such that every ordering answers the same queries
+template<class Reorder>
+auto runReorderedCHDijkstraOneToOne(benchmark::State& state, Reorder&& reorder)
+    -> void
+{
+    auto graph = bench::chGraph();
+    const auto inv_perm = reorder(graph);
+    graphs::reorderEdgesBySource(graph);
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    algorithms::distoracle::CHDijkstra dijk{graph};
+
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const auto& [source, target] = bench::queryFor(state, i++);
+        const common::NodeID s{inv_perm[source.get()]};
+        const common::NodeID t{inv_perm[target.get()]};
+
+        benchmark::DoNotOptimize(dijk.distanceBetween(s, t));
+    }
+}
+
+} // namespace impl
+
+inline auto CHDijkstraOneToOneFileOrder(benchmark::State& state)
+    -> void
+{
+    impl::runReorderedCHDijkstraOneToOne(state, [](const auto& graph) {
+        std::vector<std::size_t> identity(graph.numberOfNodes());
+        std::iota(std::begin(identity), std::end(identity), 0);
+        return identity;
+    });
+}
+
+inline auto CHDijkstraOneToOneHilbertOrder(benchmark::State& state)
+    -> void
+{
+    impl::runReorderedCHDijkstraOneToOne(state, [](auto& graph) {
+        return graphs::reorderNodesByHilbertCurve(graph).second;
+    });
+}
+
+inline auto CHDijkstraOneToOneBFSOrder(benchmark::State& state)
+    -> void
+{
+    impl::runReorderedCHDijkstraOneToOne(state, [](auto& graph) {
+        return graphs::reorderNodesByBFS(graph).second;
+    });
+}
+
+inline auto CHDijkstraOneToOneLevelThenHilbertOrder(benchmark::State& state)
+    -> void
+{
+    impl::runReorderedCHDijkstraOneToOne(state, [](auto& graph) {
+        return graphs::reorderNodesByLevelThenHilbertCurve(graph).second;
+    });
+}
+
+inline auto PHASTOneToAllLevelThenHilbertOrder(benchmark::State& state)
+    -> void
+{
+    auto graph = bench::chGraph();
+    graphs::reorderNodesByLevelThenHilbertCurve(graph);
+    graph = algorithms::distoracle::prepareGraphForPHAST(std::move(graph));
+    algorithms::distoracle::PHAST phast{graph};
+
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const auto& [source, _target] = bench::queryFor(state, i++);
+        benchmark::DoNotOptimize(phast.distancesFrom(source).data());
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "queries.hpp"
+#include <algorithms/distoracle/tnr/TransitNodeRouting.hpp>
+#include <benchmark/benchmark.h>
+
+inline auto TransitNodeRoutingPreprocessing(benchmark::State& state)
+    -> void
+{
+    const auto& graph = bench::chDijkstraGraph();
+    for(auto _ : state) {
+        algorithms::distoracle::TransitNodeRouting tnr{graph, bench::config().number_of_transit_nodes_};
+        benchmark::DoNotOptimize(tnr.numberOfAccessNodes());
+
+        state.counters["access_nodes"] = static_cast<double>(tnr.numberOfAccessNodes());
+        state.counters["bytes"] = benchmark::Counter(static_cast<double>(tnr.memoryUsage()),
+                                                     benchmark::Counter::kDefaults,
+                                                     benchmark::Counter::kIs1024);
+    }
+}
+
+inline auto TransitNodeRoutingOneToOne(benchmark::State& state)
+    -> void
+{
+    bench::runOneToOne(state, bench::transitNodeRouting());
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/PathOracle.hpp>
+#include <concepts>
+#include <functional>
+#include <graphs/Path.hpp>
+#include <optional>
+#include <tbb/enumerable_thread_specific.h>
+#include <type_traits>
+#include <utility>
+#include <utils/ConcurrentClockCache.hpp>
+
+namespace algorithms::distoracle {
+
+namespace impl {
+
+struct NodePairHash
+{
+    [[nodiscard]] auto operator()(const std::pair<common::NodeID, common::NodeID>& key) const noexcept
+        -> std::size_t
+    {
+        const auto src = std::hash<std::size_t>{}(key.first.get());
+        const auto trg = std::hash<std::size_t>{}(key.second.get());
+        return src ^ (trg + 0x9e3779b97f4a7c15ul + (src << 6) + (src >> 2));
+    }
+};
+
+/**
+ * a threadsafe oracle is shared by all threads, every other oracle
+ * is created once per thread by the factory
+ */
+template<class Oracle, bool Shared = Oracle::is_threadsafe>
+class OracleStorage
+{
+public:
+    template<class Factory>
+    explicit OracleStorage(Factory&& factory) noexcept
+        : oracle_(std::invoke(std::forward<Factory>(factory))) {}
+
+    [[nodiscard]] auto local() const noexcept
+        -> const Oracle&
+    {
+        return oracle_;
+    }
+
+private:
+    Oracle oracle_;
+};
+
+template<class Oracle>
+class OracleStorage<Oracle, false>
+{
+public:
+    template<class Factory>
+    explicit OracleStorage(Factory&& factory) noexcept
+        : oracles_(std::forward<Factory>(factory)) {}
+
+    [[nodiscard]] auto local() const noexcept
+        -> Oracle&
+    {
+        return oracles_.local();
+    }
+
+private:
+    mutable tbb::enumerable_thread_specific<Oracle> oracles_;
+};
+
+} // namespace impl
+
+/**
+ * caches the results of a distance or path oracle in front of it. the caches are shared by all
+ * threads, oracles which are not threadsafe are created once per thread by the factory, such
+ * that the cached oracle is always threadsafe. the memory budget is split evenly between the
+ * distance and the path cache if the oracle answers both. after the weights of the graph of the
+ * oracle changed invalidate has to be called, afterwards no cached result is returned anymore
+ */
+template<class Oracle>
+// clang-format off
+requires concepts::DistanceOracle<Oracle> || concepts::PathOracle<Oracle>
+// clang-format on
+class CachedOracle
+{
+    constexpr static inline bool has_distances = concepts::DistanceOracle<Oracle>;
+    constexpr static inline bool has_paths = concepts::PathOracle<Oracle>;
+
+    using Key = std::pair<common::NodeID, common::NodeID>;
+
+public:
+    constexpr static inline bool is_threadsafe = true;
+
+    using DistanceCache = util::ConcurrentClockCache<Key, common::Weight, impl::NodePairHash>;
+    using PathCache = util::ConcurrentClockCache<Key, std::optional<graphs::Path>, impl::NodePairHash>;
+
+    // clang-format off
+    template<class Factory>
+    requires std::invocable<Factory>
+          && std::same_as<std::invoke_result_t<Factory>, Oracle>
+    // clang-format on
+    CachedOracle(Factory&& factory,
+                 std::size_t memory_budget,
+                 std::size_t number_of_shards = 16) noexcept
+        : oracle_(std::forward<Factory>(factory)),
+          distance_cache_(has_paths ? memory_budget / 2 : memory_budget, number_of_shards),
+          path_cache_(has_distances ? memory_budget / 2 : memory_budget, number_of_shards)
+    {
+        static_assert(!has_distances or concepts::DistanceOracle<CachedOracle>,
+                      "CachedOracle should fullfill the DistanceOracle concept");
+
+        static_assert(!has_paths or concepts::PathOracle<CachedOracle>,
+                      "CachedOracle should fullfill the PathOracle concept");
+    }
+
+    // clang-format off
+    CachedOracle(Oracle oracle,
+                 std::size_t memory_budget,
+                 std::size_t number_of_shards = 16) noexcept
+        requires Oracle::is_threadsafe
+    // clang-format on
+        : CachedOracle([&]() -> Oracle { return std::move(oracle); },
+                       memory_budget,
+                       number_of_shards) {}
+
+    CachedOracle(const CachedOracle&) = delete;
+    auto operator=(const CachedOracle&) -> CachedOracle& = delete;
+
+    // clang-format off
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+        requires has_distances
+    // clang-format on
+    {
+        const Key key{source, target};
+        if(auto cached = distance_cache_.find(key)) {
+            return cached.value();
+        }
+
+        // a result computed on the weights before an invalidation must not be cached
+        const auto epoch = distance_cache_.epoch();
+        const auto distance = oracle_.local().distanceBetween(source, target);
+        distance_cache_.insert(key, distance, epoch);
+        return distance;
+    }
+
+    // clang-format off
+    [[nodiscard]] auto pathBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> std::optional<graphs::Path>
+        requires has_paths
+    // clang-format on
+    {
+        const Key key{source, target};
+        if(auto cached = path_cache_.find(key)) {
+            return std::move(cached.value());
+        }
+
+        const auto epoch = path_cache_.epoch();
+        auto path = oracle_.local().pathBetween(source, target);
+        const auto path_bytes = path ? path->getNumberOfNodes() * sizeof(common::NodeID) : 0;
+        path_cache_.insert(key, path, epoch, path_bytes);
+        return path;
+    }
+
+    /**
+     * drops all cached results, has to be called after the weights of the graph changed
+     */
+    auto invalidate() noexcept
+        -> void
+    {
+        distance_cache_.invalidate();
+        path_cache_.invalidate();
+    }
+
+    [[nodiscard]] auto distanceCache() const noexcept
+        -> const DistanceCache&
+    {
+        return distance_cache_;
+    }
+
+    [[nodiscard]] auto pathCache() const noexcept
+        -> const PathCache&
+    {
+        return path_cache_;
+    }
+
+private:
+    impl::OracleStorage<Oracle> oracle_;
+    mutable DistanceCache distance_cache_;
+    mutable PathCache path_cache_;
+};
+
+// clang-format off
+template<class Factory>
+requires std::invocable<Factory>
+CachedOracle(Factory&&, std::size_t, std::size_t = 16)
+    -> CachedOracle<std::invoke_result_t<Factory>>;
+// clang-format on
+
+} // namespace algorithms::distoracle
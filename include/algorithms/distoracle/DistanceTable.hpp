@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <common/BasicGraphTypes.hpp>
+#include <common/Range.hpp>
+#include <execution>
+#include <span>
+
+namespace algorithms::distoracle {
+
+/**
+ * distance tables are stored row major, the distance from sources[i] to targets[j]
+ * is written to out[i * targets.size() + j]
+ */
+[[nodiscard]] inline auto isValidDistanceTable(std::span<const common::NodeID> sources,
+                                               std::span<const common::NodeID> targets,
+                                               std::span<const common::Weight> out) noexcept
+    -> bool
+{
+    return out.size() == sources.size() * targets.size();
+}
+
+/**
+ * calls fill_row(source, row) for every source in parallel,
+ * row is the part of the table which belongs to the source
+ */
+template<class F>
+auto forEachDistanceTableRow(std::span<const common::NodeID> sources,
+                             std::span<const common::NodeID> targets,
+                             std::span<common::Weight> out,
+                             F&& fill_row) noexcept
+    -> void
+{
+    const auto range = common::range(sources.size());
+    std::for_each(std::execution::par,
+                  std::begin(range),
+                  std::end(range),
+                  [&](const auto i) {
+                      fill_row(sources[i], out.subspan(i * targets.size(), targets.size()));
+                  });
+}
+
+} // namespace algorithms::distoracle
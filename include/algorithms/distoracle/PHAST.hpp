@@ -1,99 +1,201 @@
 #pragma once
 
+#include <algorithms/distoracle/DistanceTable.hpp>
 #include <algorithms/distoracle/ch/CHDijkstraBackwardHelper.hpp>
 #include <algorithms/distoracle/ch/CHDijkstraForwardHelper.hpp>
+#include <algorithms/distoracle/ch/UpwardArcs.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
 #include <concepts/DistanceOracle.hpp>
+#include <concepts/UpwardArcs.hpp>
 #include <fmt/core.h>
 #include <graphs/offsetarray/OffsetArray.hpp>
 #include <numeric>
 #include <queue>
+#include <tbb/enumerable_thread_specific.h>
 #include <type_traits>
 #include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::distoracle {
 
-template<class Node, class Edge>
-class PHAST
+/**
+ * one to all queries on a graph prepared by prepareGraphForPHAST or on a CHSearchGraph,
+ * both number the nodes by level descending
+ */
+template<class Graph, class Statistics = util::NoStatistics>
+class BasicPHAST
 {
 public:
-    constexpr static inline bool is_threadsafe = false;
+    constexpr static inline bool is_threadsafe = true;
 
-    constexpr PHAST(const graphs::OffsetArray<Node, Edge>& graph) noexcept
+    /**
+     * the distance array of a single one to many query, a context can be reused
+     * for many queries but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : upward_distances_(number_of_nodes, common::INFINITY_WEIGHT),
+              distances_(number_of_nodes, common::INFINITY_WEIGHT) {}
+
+    private:
+        friend BasicPHAST;
+        util::VersionedArray<common::Weight> upward_distances_;
+        // every entry is written by the downward sweep, so it is never reset
+        std::vector<common::Weight> distances_;
+        std::optional<common::NodeID> last_src_;
+    };
+
+    BasicPHAST(const Graph& graph) noexcept
         : graph_(graph),
-          distances_(graph_.numberOfNodes(), common::INFINITY_WEIGHT)
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
     {
-        static_assert(concepts::OneToManyDistanceOracle<PHAST>,
+        static_assert(concepts::OneToManyDistanceOracle<BasicPHAST>,
                       "PHAST should fullfill the OneToManyDistanceOracle concept");
+
+        static_assert(concepts::ManyToManyDistanceOracle<BasicPHAST>,
+                      "PHAST should fullfill the ManyToManyDistanceOracle concept");
+    }
+
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
     }
 
-    [[nodiscard]] auto distancesFrom(common::NodeID src) noexcept
+    /**
+     * uses the context of the calling thread, the returned distances stay valid
+     * until the calling thread issues its next query
+     */
+    [[nodiscard]] auto distancesFrom(common::NodeID src) const noexcept
         -> const std::vector<common::Weight>&
     {
-        if(last_src_ == src) {
-            return distances_;
+        return distancesFrom(contexts_.local(), src);
+    }
+
+    [[nodiscard]] auto distancesFrom(SearchContext& context, common::NodeID src) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        if(context.last_src_ == src) {
+            return context.distances_;
         }
 
-        resetFor(src);
-        upward(src);
-        downward();
-        return distances_;
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        resetFor(context, src);
+        upward(context, src, statistics);
+        downward(context, statistics);
+        return context.distances_;
     }
 
-private:
-    auto resetFor(common::NodeID src) noexcept
-        -> void
+    /**
+     * one sweep per source, the sweeps of different sources run in parallel
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
     {
-        for(auto& distance : distances_) {
-            distance = common::INFINITY_WEIGHT;
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
         }
 
-        last_src_ = src;
+        forEachDistanceTableRow(sources, targets, out, [&](const auto source, auto row) {
+            const auto& distances = distancesFrom(contexts_.local(), source);
+            for(std::size_t j = 0; j < targets.size(); j++) {
+                row[j] = distances[targets[j].get()];
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
     }
 
-    auto upward(common::NodeID src) noexcept
+    auto clearStatistics() noexcept
         -> void
     {
+        statistics_.clear();
+    }
+
+private:
+    static auto resetFor(SearchContext& context, common::NodeID src) noexcept
+        -> void
+    {
+        context.upward_distances_.clear();
+        context.last_src_ = src;
+    }
+
+    auto upward(SearchContext& context,
+                common::NodeID src,
+                Statistics& statistics) const noexcept
+        -> void
+    {
+        auto& distances = context.upward_distances_;
+
         pathfinding::DijkstraQueue heap;
         heap.emplace(src, 0);
-        distances_[src.get()] = common::Weight{0};
+        distances.set(src.get(), common::Weight{0});
 
         while(!heap.empty()) {
             const auto [current_node, cost_to_current] = heap.top();
             heap.pop();
+            statistics.count(util::QueryCounter::SETTLED_NODES);
 
-            const auto edge_ids = graph_.getForwardEdgeIDsOf(current_node);
-
-            if(shouldStall(cost_to_current, edge_ids)) {
+            if(shouldStall(context, cost_to_current, backwardArcsOf(graph_, current_node))) {
+                statistics.count(util::QueryCounter::STALLED_NODES);
                 continue;
             }
 
-
-            for(const auto& id : edge_ids) {
-                const auto edge = graph_.getEdge(id);
-                const auto neig = edge->getTrg();
-                const auto cost = edge->getWeight();
+            for(const auto arc : forwardArcsOf(graph_, current_node)) {
+                const auto neig = arc.getTrg();
+                const auto cost = arc.getWeight();
                 const auto new_dist = cost + cost_to_current;
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
 
-                if(new_dist < distances_[neig.get()]) {
+                if(new_dist < distances[neig.get()]) {
                     heap.emplace(neig, new_dist);
-                    distances_[neig.get()] = new_dist;
+                    distances.set(neig.get(), new_dist);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
                 }
             }
         }
     }
 
-    constexpr auto shouldStall(common::Weight cost_to_current,
-                               const std::span<const common::EdgeID>& edge_ids) const noexcept
+    // a node is stalled if it can be reached cheaper over an edge from a higher node
+    template<class Arcs>
+    constexpr auto shouldStall(const SearchContext& context,
+                               common::Weight cost_to_current,
+                               Arcs&& ingoing_arcs) const noexcept
         -> bool
     {
-        for(const auto& id : edge_ids) {
-            const auto& edge = graph_.getEdge(id);
-            const auto neig = edge->getTrg();
-            const auto cost = edge->getWeight();
-            const auto current_dist_to_neig = distances_[neig.get()];
+        for(const auto arc : ingoing_arcs) {
+            const auto neig = arc.getTrg();
+            const auto cost = arc.getWeight();
+            const auto current_dist_to_neig = context.upward_distances_[neig.get()];
 
             if(current_dist_to_neig == common::INFINITY_WEIGHT) {
                 continue;
@@ -107,31 +209,45 @@ private:
         return false;
     }
 
-    auto downward() noexcept
+    auto downward(SearchContext& context, Statistics& statistics) const noexcept
         -> void
     {
-        for(const auto& edge_id : graph_.backward_neigbours_) {
-            const auto* edge = graph_.getEdge(edge_id);
-            const auto src = edge->getSrc().get();
-            const auto trg = edge->getTrg().get();
-            const auto weight = edge->getWeight();
-
-            // skip if src is not reachable from current node
-            if(distances_[src] == common::INFINITY_WEIGHT) {
-                continue;
+        // the sweep settles every node and relaxes every downward edge
+        statistics.count(util::QueryCounter::SETTLED_NODES, graph_.numberOfNodes());
+
+        // the nodes are sorted by level descending, therefore all nodes above
+        // a node are final when it is scanned and every distance is written once
+        for(std::size_t n = 0; n < graph_.numberOfNodes(); n++) {
+            auto distance = context.upward_distances_[n];
+
+            const auto arcs = backwardArcsOf(graph_, common::NodeID{n});
+            statistics.count(util::QueryCounter::RELAXED_EDGES, std::ranges::size(arcs));
+
+            for(const auto arc : arcs) {
+                const auto upper = arc.getTrg().get();
+                const auto weight = arc.getWeight();
+
+                // skip if the upper node is not reachable from current node
+                if(context.distances_[upper] == common::INFINITY_WEIGHT) {
+                    continue;
+                }
+
+                distance = std::min(distance, context.distances_[upper] + weight);
             }
 
-            distances_[trg] = std::min(distances_[trg],
-                                       distances_[src] + weight);
+            context.distances_[n] = distance;
         }
     }
 
 private:
-    const graphs::OffsetArray<Node, Edge>& graph_;
-    std::vector<common::Weight> distances_;
-    std::optional<common::NodeID> last_src_;
+    const Graph& graph_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
 };
 
+template<class Node, class Edge, class Statistics = util::NoStatistics>
+using PHAST = BasicPHAST<graphs::OffsetArray<Node, Edge>, Statistics>;
+
 
 // clang-format off
 template<class Node, class Edge>
@@ -193,7 +309,10 @@ template<class Node, class Edge>
         return [&](const auto lhs, const auto rhs) {
             const auto lhs_lvl = graph.getNodeLevelUnsafe(lhs);
             const auto rhs_lvl = graph.getNodeLevelUnsafe(rhs);
-            return lhs_lvl > rhs_lvl;
+
+            // keep the current order inside of a level, such that a locality
+            // order applied before, e.g. reorderNodesByLevelThenHilbertCurve, survives
+            return lhs_lvl > rhs_lvl or (lhs_lvl == rhs_lvl and lhs < rhs);
         };
     });
 
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <common/Range.hpp>
+#include <concepts/Edges.hpp>
+#include <execution>
+#include <functional>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <utils/VersionedArray.hpp>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * the result of an isochrone query, the reachable nodes are ordered by node id
+ * and the boundary edges are the edges of the original graph which leave the
+ * reachable area, shortcuts are never boundary edges
+ */
+struct Isochrone
+{
+    std::vector<std::pair<common::NodeID, common::Weight>> reachable_;
+    std::vector<common::EdgeID> boundary_edges_;
+};
+
+/**
+ * calculates all nodes reachable from a source within a limit on a graph prepared by
+ * prepareGraphForPHAST. the upward search is pruned at the limit and the downward sweep
+ * only visits nodes reached with a distance within the limit. because the nodes are
+ * sorted by level, a heap over node ids scans every reached node after all nodes above it
+ */
+template<class Node, class Edge>
+class PHASTIsochrone
+{
+public:
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the scratch arrays of a single query, a context can be reused for many queries
+     * but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : upward_distances_(number_of_nodes, common::INFINITY_WEIGHT),
+              distances_(number_of_nodes, common::INFINITY_WEIGHT) {}
+
+    private:
+        friend PHASTIsochrone;
+        util::VersionedArray<common::Weight> upward_distances_;
+        util::VersionedArray<common::Weight> distances_;
+        std::vector<common::NodeID> upward_settled_;
+    };
+
+    PHASTIsochrone(const graphs::OffsetArray<Node, Edge>& graph) noexcept
+        : graph_(graph),
+          downward_offset_(graph.numberOfNodes() + 1, 0),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
+    {
+        // the backward edges of a node are the edges coming from higher nodes,
+        // regrouped by their source they become the downward edges of the higher nodes
+        const auto number_of_nodes = graph.numberOfNodes();
+        for(std::size_t n = 0; n < number_of_nodes; n++) {
+            for(const auto id : graph.getBackwardEdgeIDsOf(common::NodeID{n})) {
+                downward_offset_[graph.getEdge(id)->getSrc().get() + 1]++;
+            }
+        }
+
+        std::inclusive_scan(std::begin(downward_offset_),
+                            std::end(downward_offset_),
+                            std::begin(downward_offset_));
+
+        auto positions = downward_offset_;
+        downward_edges_.resize(downward_offset_.back(), common::UNKNOWN_EDGE_ID);
+        for(std::size_t n = 0; n < number_of_nodes; n++) {
+            for(const auto id : graph.getBackwardEdgeIDsOf(common::NodeID{n})) {
+                const auto src = graph.getEdge(id)->getSrc();
+                downward_edges_[positions[src.get()]++] = id;
+            }
+        }
+    }
+
+    PHASTIsochrone(PHASTIsochrone&&) noexcept = default;
+    PHASTIsochrone(const PHASTIsochrone&) noexcept = delete;
+    auto operator=(PHASTIsochrone&&) noexcept -> PHASTIsochrone& = default;
+    auto operator=(const PHASTIsochrone&) noexcept -> PHASTIsochrone& = delete;
+
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    [[nodiscard]] auto isochroneFrom(common::NodeID source, common::Weight limit) const noexcept
+        -> Isochrone
+    {
+        return isochroneFrom(contexts_.local(), source, limit);
+    }
+
+    [[nodiscard]] auto isochroneFrom(SearchContext& context,
+                                     common::NodeID source,
+                                     common::Weight limit) const noexcept
+        -> Isochrone
+    {
+        context.upward_distances_.clear();
+        context.distances_.clear();
+        context.upward_settled_.clear();
+
+        upward(context, source, limit);
+
+        Isochrone isochrone;
+        downward(context, limit, isochrone);
+        collectBoundaryEdges(context, isochrone);
+
+        return isochrone;
+    }
+
+    /**
+     * calculates the isochrones of all sources in parallel
+     */
+    [[nodiscard]] auto isochronesFrom(std::span<const common::NodeID> sources,
+                                      common::Weight limit) const noexcept
+        -> std::vector<Isochrone>
+    {
+        std::vector<Isochrone> isochrones(sources.size());
+
+        const auto range = common::range(sources.size());
+        std::for_each(std::execution::par,
+                      std::begin(range),
+                      std::end(range),
+                      [&](const auto i) {
+                          isochrones[i] = isochroneFrom(sources[i], limit);
+                      });
+
+        return isochrones;
+    }
+
+private:
+    auto upward(SearchContext& context,
+                common::NodeID source,
+                common::Weight limit) const noexcept
+        -> void
+    {
+        auto& distances = context.upward_distances_;
+
+        pathfinding::DijkstraQueue heap;
+        heap.emplace(source, 0);
+        distances.set(source.get(), common::Weight{0});
+
+        while(!heap.empty()) {
+            const auto [current_node, cost_to_current] = heap.top();
+            heap.pop();
+
+            if(distances.isSettled(current_node.get())) {
+                continue;
+            }
+            distances.settle(current_node.get());
+            context.upward_settled_.emplace_back(current_node);
+
+            for(const auto id : graph_.getForwardEdgeIDsOf(current_node)) {
+                const auto* edge = graph_.getEdge(id);
+                const auto neig = edge->getTrg();
+                const auto new_dist = cost_to_current + edge->getWeight();
+
+                // the downward edges only increase the distance, nodes above the
+                // limit cannot lead to a node within the limit
+                if(new_dist <= limit and new_dist < distances[neig.get()]) {
+                    heap.emplace(neig, new_dist);
+                    distances.set(neig.get(), new_dist);
+                }
+            }
+        }
+    }
+
+    auto downward(SearchContext& context,
+                  common::Weight limit,
+                  Isochrone& isochrone) const noexcept
+        -> void
+    {
+        auto& distances = context.distances_;
+
+        // smaller ids are higher in the hierarchy and have to be scanned first
+        std::priority_queue<std::size_t,
+                            std::vector<std::size_t>,
+                            std::greater<>>
+            heap;
+
+        for(const auto node : context.upward_settled_) {
+            distances.set(node.get(), context.upward_distances_[node.get()]);
+            heap.emplace(node.get());
+        }
+
+        while(!heap.empty()) {
+            const auto current_node = heap.top();
+            heap.pop();
+
+            if(distances.isSettled(current_node)) {
+                continue;
+            }
+            distances.settle(current_node);
+
+            const auto cost_to_current = distances[current_node];
+            isochrone.reachable_.emplace_back(common::NodeID{current_node}, cost_to_current);
+
+            for(const auto id : getDownwardEdgeIDsOf(current_node)) {
+                const auto* edge = graph_.getEdge(id);
+                const auto neig = edge->getTrg().get();
+                const auto new_dist = cost_to_current + edge->getWeight();
+
+                if(new_dist <= limit and new_dist < distances[neig]) {
+                    if(!distances.isSet(neig)) {
+                        heap.emplace(neig);
+                    }
+                    distances.set(neig, new_dist);
+                }
+            }
+        }
+    }
+
+    auto collectBoundaryEdges(const SearchContext& context,
+                              Isochrone& isochrone) const noexcept
+        -> void
+    {
+        const auto check_edge = [&](const auto id) {
+            const auto* edge = graph_.getEdge(id);
+
+            if constexpr(concepts::CanHaveShortcuts<Edge>) {
+                if(edge->isShortcut()) {
+                    return;
+                }
+            }
+
+            if(!context.distances_.isSettled(edge->getTrg().get())) {
+                isochrone.boundary_edges_.emplace_back(id);
+            }
+        };
+
+        for(const auto& [node, _] : isochrone.reachable_) {
+            for(const auto id : graph_.getForwardEdgeIDsOf(node)) {
+                check_edge(id);
+            }
+            for(const auto id : getDownwardEdgeIDsOf(node.get())) {
+                check_edge(id);
+            }
+        }
+    }
+
+    [[nodiscard]] auto getDownwardEdgeIDsOf(std::size_t node) const noexcept
+        -> std::span<const common::EdgeID>
+    {
+        const auto first = downward_offset_[node];
+        const auto last = downward_offset_[node + 1];
+        return std::span{downward_edges_.data() + first, last - first};
+    }
+
+private:
+    const graphs::OffsetArray<Node, Edge>& graph_;
+
+    // the downward edges of every node as offsetarray of edge ids
+    std::vector<std::size_t> downward_offset_;
+    std::vector<common::EdgeID> downward_edges_;
+
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+};
+
+} // namespace algorithms::distoracle
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithms/distoracle/DistanceTable.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <optional>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <utils/VersionedArray.hpp>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * breadth first search on unweighted graphs, i.e. the distances are hop counts. a node is
+ * final as soon as it is reached, therefore the search of a source is resumed by the next
+ * query of the same source until its target is reached
+ */
+template<class Graph, class Statistics = util::NoStatistics>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasTarget<typename Graph::EdgeType>
+      && (!concepts::HasWeight<typename Graph::EdgeType>)
+// clang-format on
+class BFS
+{
+public:
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the distances and the queue of a single search, a context can be reused
+     * for many queries but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : distances_(number_of_nodes, common::INFINITY_WEIGHT) {}
+
+    private:
+        friend BFS;
+        util::VersionedArray<common::Weight> distances_;
+        // plain copy of distances_ returned by one to all queries
+        std::vector<common::Weight> all_distances_;
+        // the queue is never popped, head_ is the next node to expand
+        std::vector<common::NodeID> queue_;
+        std::size_t head_ = 0;
+        std::optional<common::NodeID> last_source_;
+    };
+
+    BFS(const Graph& graph) noexcept
+        : graph_(graph),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
+    {
+        static_assert(concepts::DistanceOracle<BFS>,
+                      "BFS should fullfill the DistanceOracle concept");
+
+        static_assert(concepts::OneToManyDistanceOracle<BFS>,
+                      "BFS should fullfill the OneToManyDistanceOracle concept");
+
+        static_assert(concepts::ManyToManyDistanceOracle<BFS>,
+                      "BFS should fullfill the ManyToManyDistanceOracle concept");
+    }
+
+    BFS(BFS&&) noexcept = default;
+    BFS(const BFS&) noexcept = delete;
+    auto operator=(const BFS&) -> BFS& = delete;
+    auto operator=(BFS&&) noexcept -> BFS& = delete;
+
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        return distanceBetween(contexts_.local(), source, target);
+    }
+
+    [[nodiscard]] auto distanceBetween(SearchContext& context,
+                                       common::NodeID source,
+                                       common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        if(source != context.last_source_) {
+            resetFor(context, source);
+        }
+
+        while(!context.distances_.isSet(target.get())
+              and context.head_ < context.queue_.size()) {
+            expandNext(context, statistics);
+        }
+
+        return context.distances_[target.get()];
+    }
+
+    /**
+     * uses the context of the calling thread, the returned distances stay valid
+     * until the calling thread issues its next query
+     */
+    [[nodiscard]] auto distancesFrom(common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        return distancesFrom(contexts_.local(), source);
+    }
+
+    [[nodiscard]] auto distancesFrom(SearchContext& context,
+                                     common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        if(source != context.last_source_) {
+            resetFor(context, source);
+        }
+
+        while(context.head_ < context.queue_.size()) {
+            expandNext(context, statistics);
+        }
+
+        context.distances_.exportTo(context.all_distances_);
+        return context.all_distances_;
+    }
+
+    /**
+     * runs one search per source in parallel, the search of a source
+     * stops as soon as all targets are reached
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
+    {
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
+        }
+
+        forEachDistanceTableRow(sources, targets, out, [&](const auto source, auto row) {
+            auto& context = contexts_.local();
+            for(std::size_t j = 0; j < targets.size(); j++) {
+                row[j] = distanceBetween(context, source, targets[j]);
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
+private:
+    static auto resetFor(SearchContext& context, common::NodeID source) noexcept
+        -> void
+    {
+        context.distances_.clear();
+        context.queue_.clear();
+        context.head_ = 0;
+
+        context.last_source_ = source;
+        context.queue_.emplace_back(source);
+        context.distances_.set(source.get(), common::Weight{0});
+    }
+
+    auto expandNext(SearchContext& context, Statistics& statistics) const noexcept
+        -> void
+    {
+        const auto current = context.queue_[context.head_++];
+        const auto next_dist = context.distances_[current.get()] + common::Weight{1};
+        statistics.count(util::QueryCounter::SETTLED_NODES);
+
+        for(const auto id : graph_.getForwardEdgeIDsOf(current)) {
+            const auto neig = graph_.getEdge(id)->getTrg();
+            statistics.count(util::QueryCounter::RELAXED_EDGES);
+
+            if(!context.distances_.isSet(neig.get())) {
+                context.distances_.set(neig.get(), next_dist);
+                context.queue_.emplace_back(neig);
+                statistics.count(util::QueryCounter::QUEUE_PUSHES);
+            }
+        }
+    }
+
+private:
+    const Graph& graph_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
+};
+
+} // namespace algorithms::distoracle
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/distoracle/DistanceTable.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/BackwardConnections.hpp>
+#include <concepts/BackwardEdges.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <optional>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * level synchronous breadth first search which switches between two directions. top down
+ * expands the edges of the frontier, bottom up scans the backward edges of every unreached
+ * node until one of them comes from the frontier. bottom up is cheaper while the frontier
+ * holds a large part of the unexplored edges, because most unreached nodes find a parent
+ * after a few edges
+ */
+template<class Graph, class Statistics = util::NoStatistics>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::BackwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasBackwardEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasTarget<typename Graph::EdgeType>
+      && (!concepts::HasWeight<typename Graph::EdgeType>)
+// clang-format on
+class DirectionOptimizingBFS
+{
+    // the switching thresholds proposed by Beamer et al., the search turns bottom up once
+    // the frontier has more than 1/ALPHA of the unexplored edges and turns top down again
+    // once the frontier has less than 1/BETA of all nodes
+    constexpr static inline std::size_t ALPHA = 14;
+    constexpr static inline std::size_t BETA = 24;
+
+public:
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the distances and the frontiers of a single search, a context can be reused
+     * for many queries but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : distances_(number_of_nodes, common::INFINITY_WEIGHT),
+              in_frontier_(number_of_nodes, false) {}
+
+    private:
+        friend DirectionOptimizingBFS;
+        std::vector<common::Weight> distances_;
+        std::vector<bool> in_frontier_;
+        std::vector<common::NodeID> frontier_;
+        std::vector<common::NodeID> next_;
+        std::optional<common::NodeID> last_source_;
+        common::Weight level_{0};
+        // the forward edges of all nodes which were not reached yet
+        std::size_t unexplored_edges_ = 0;
+        bool bottom_up_ = false;
+        bool finished_ = false;
+    };
+
+    DirectionOptimizingBFS(const Graph& graph) noexcept
+        : graph_(graph),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
+    {
+        static_assert(concepts::DistanceOracle<DirectionOptimizingBFS>,
+                      "DirectionOptimizingBFS should fullfill the DistanceOracle concept");
+
+        static_assert(concepts::OneToManyDistanceOracle<DirectionOptimizingBFS>,
+                      "DirectionOptimizingBFS should fullfill the OneToManyDistanceOracle concept");
+    }
+
+    DirectionOptimizingBFS(DirectionOptimizingBFS&&) noexcept = default;
+    DirectionOptimizingBFS(const DirectionOptimizingBFS&) noexcept = delete;
+    auto operator=(const DirectionOptimizingBFS&) -> DirectionOptimizingBFS& = delete;
+    auto operator=(DirectionOptimizingBFS&&) noexcept -> DirectionOptimizingBFS& = delete;
+
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    /**
+     * the search stops after the level in which the target is reached
+     */
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        return distanceBetween(contexts_.local(), source, target);
+    }
+
+    [[nodiscard]] auto distanceBetween(SearchContext& context,
+                                       common::NodeID source,
+                                       common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        if(source != context.last_source_) {
+            resetFor(context, source);
+        }
+
+        while(context.distances_[target.get()] == common::INFINITY_WEIGHT
+              and !context.finished_) {
+            expandLevel(context, statistics);
+        }
+
+        return context.distances_[target.get()];
+    }
+
+    /**
+     * uses the context of the calling thread, the returned distances stay valid
+     * until the calling thread issues its next query
+     */
+    [[nodiscard]] auto distancesFrom(common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        return distancesFrom(contexts_.local(), source);
+    }
+
+    [[nodiscard]] auto distancesFrom(SearchContext& context,
+                                     common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        if(source != context.last_source_) {
+            resetFor(context, source);
+        }
+
+        while(!context.finished_) {
+            expandLevel(context, statistics);
+        }
+
+        return context.distances_;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
+private:
+    auto resetFor(SearchContext& context, common::NodeID source) const noexcept
+        -> void
+    {
+        std::fill(std::begin(context.distances_),
+                  std::end(context.distances_),
+                  common::INFINITY_WEIGHT);
+
+        context.frontier_.clear();
+        context.next_.clear();
+        context.last_source_ = source;
+        context.finished_ = false;
+        context.bottom_up_ = false;
+        context.level_ = common::Weight{0};
+        context.unexplored_edges_ = graph_.numberOfEdges();
+
+        context.distances_[source.get()] = common::Weight{0};
+        context.frontier_.emplace_back(source);
+        context.unexplored_edges_ -= graph_.getForwardEdgeIDsOf(source).size();
+    }
+
+    auto expandLevel(SearchContext& context, Statistics& statistics) const noexcept
+        -> void
+    {
+        if(context.frontier_.empty()) {
+            context.finished_ = true;
+            return;
+        }
+
+        std::size_t frontier_edges = 0;
+        for(const auto node : context.frontier_) {
+            frontier_edges += graph_.getForwardEdgeIDsOf(node).size();
+        }
+
+        if(!context.bottom_up_ and frontier_edges > context.unexplored_edges_ / ALPHA) {
+            context.bottom_up_ = true;
+        } else if(context.bottom_up_ and context.frontier_.size() < graph_.numberOfNodes() / BETA) {
+            context.bottom_up_ = false;
+        }
+
+        statistics.count(util::QueryCounter::SETTLED_NODES, context.frontier_.size());
+        context.level_ += common::Weight{1};
+
+        if(context.bottom_up_) {
+            bottomUp(context, statistics);
+        } else {
+            topDown(context, statistics);
+        }
+
+        for(const auto node : context.next_) {
+            context.unexplored_edges_ -= graph_.getForwardEdgeIDsOf(node).size();
+        }
+
+        std::swap(context.frontier_, context.next_);
+        context.next_.clear();
+    }
+
+    auto topDown(SearchContext& context, Statistics& statistics) const noexcept
+        -> void
+    {
+        for(const auto node : context.frontier_) {
+            for(const auto id : graph_.getForwardEdgeIDsOf(node)) {
+                const auto neig = graph_.getEdge(id)->getTrg();
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
+
+                if(context.distances_[neig.get()] == common::INFINITY_WEIGHT) {
+                    context.distances_[neig.get()] = context.level_;
+                    context.next_.emplace_back(neig);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
+                }
+            }
+        }
+    }
+
+    auto bottomUp(SearchContext& context, Statistics& statistics) const noexcept
+        -> void
+    {
+        for(const auto node : context.frontier_) {
+            context.in_frontier_[node.get()] = true;
+        }
+
+        for(std::size_t n = 0; n < graph_.numberOfNodes(); n++) {
+            if(context.distances_[n] != common::INFINITY_WEIGHT) {
+                continue;
+            }
+
+            for(const auto id : graph_.getBackwardEdgeIDsOf(common::NodeID{n})) {
+                const auto parent = graph_.getBackwardEdge(id)->getTrg();
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
+
+                if(context.in_frontier_[parent.get()]) {
+                    context.distances_[n] = context.level_;
+                    context.next_.emplace_back(n);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
+                    break;
+                }
+            }
+        }
+
+        for(const auto node : context.frontier_) {
+            context.in_frontier_[node.get()] = false;
+        }
+    }
+
+private:
+    const Graph& graph_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
+};
+
+} // namespace algorithms::distoracle
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/distoracle/DistanceTable.hpp>
+#include <bit>
+#include <common/BasicGraphTypes.hpp>
+#include <common/Range.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * bit parallel breadth first search of up to 64 sources at once. every node holds a bitset of
+ * the sources which already reached it and of the sources which reach it in the current level,
+ * such that a node which is reached by many sources in the same level is expanded only once
+ * for all of them
+ */
+template<class Graph, class Statistics = util::NoStatistics>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasTarget<typename Graph::EdgeType>
+      && (!concepts::HasWeight<typename Graph::EdgeType>)
+// clang-format on
+class MultiSourceBFS
+{
+public:
+    using SourceSet = std::uint64_t;
+
+    constexpr static inline std::size_t SOURCES_PER_SEARCH = 64;
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the bitsets of a single search, a context can be reused for many
+     * searches but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : seen_(number_of_nodes, 0),
+              visit_(number_of_nodes, 0),
+              visit_next_(number_of_nodes, 0) {}
+
+    private:
+        friend MultiSourceBFS;
+        std::vector<SourceSet> seen_;
+        std::vector<SourceSet> visit_;
+        std::vector<SourceSet> visit_next_;
+        std::vector<common::NodeID> frontier_;
+        std::vector<common::NodeID> next_;
+    };
+
+    MultiSourceBFS(const Graph& graph) noexcept
+        : graph_(graph),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
+    {
+        static_assert(concepts::ManyToManyDistanceOracle<MultiSourceBFS>,
+                      "MultiSourceBFS should fullfill the ManyToManyDistanceOracle concept");
+    }
+
+    MultiSourceBFS(MultiSourceBFS&&) noexcept = default;
+    MultiSourceBFS(const MultiSourceBFS&) noexcept = delete;
+    auto operator=(const MultiSourceBFS&) -> MultiSourceBFS& = delete;
+    auto operator=(MultiSourceBFS&&) noexcept -> MultiSourceBFS& = delete;
+
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    /**
+     * searches from at most 64 sources at once and calls visitor(node, sources, distance)
+     * for every node and level, bit i of sources is set if sources[i] reaches the node
+     * with the given distance. the sources themselves are visited with distance 0
+     * @returns false if there are more than 64 sources
+     */
+    template<class Visitor>
+    auto visitFrom(std::span<const common::NodeID> sources, Visitor&& visitor) const noexcept
+        -> bool
+    {
+        return visitFrom(contexts_.local(), sources, std::forward<Visitor>(visitor));
+    }
+
+    template<class Visitor>
+    auto visitFrom(SearchContext& context,
+                   std::span<const common::NodeID> sources,
+                   Visitor&& visitor) const noexcept
+        -> bool
+    {
+        if(sources.size() > SOURCES_PER_SEARCH) {
+            return false;
+        }
+
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        auto& seen = context.seen_;
+        auto& visit = context.visit_;
+        auto& visit_next = context.visit_next_;
+
+        std::fill(std::begin(seen), std::end(seen), 0);
+        context.frontier_.clear();
+
+        for(std::size_t i = 0; i < sources.size(); i++) {
+            const auto idx = sources[i].get();
+            if(visit[idx] == 0) {
+                context.frontier_.emplace_back(sources[i]);
+            }
+
+            const auto bit = SourceSet{1} << i;
+            seen[idx] |= bit;
+            visit[idx] |= bit;
+        }
+
+        for(const auto node : context.frontier_) {
+            visitor(node, visit[node.get()], common::Weight{0});
+        }
+
+        common::Weight level{0};
+        while(!context.frontier_.empty()) {
+            level += common::Weight{1};
+            context.next_.clear();
+            statistics.count(util::QueryCounter::SETTLED_NODES, context.frontier_.size());
+
+            for(const auto node : context.frontier_) {
+                const auto reaching = visit[node.get()];
+                visit[node.get()] = 0;
+
+                for(const auto id : graph_.getForwardEdgeIDsOf(node)) {
+                    const auto neig = graph_.getEdge(id)->getTrg();
+                    const auto new_sources = reaching & ~seen[neig.get()];
+                    statistics.count(util::QueryCounter::RELAXED_EDGES);
+
+                    if(new_sources == 0) {
+                        continue;
+                    }
+
+                    if(visit_next[neig.get()] == 0) {
+                        context.next_.emplace_back(neig);
+                        statistics.count(util::QueryCounter::QUEUE_PUSHES);
+                    }
+
+                    visit_next[neig.get()] |= new_sources;
+                }
+            }
+
+            // seen is only updated after the level, such that all sources
+            // reaching a node in this level are collected first
+            for(const auto node : context.next_) {
+                seen[node.get()] |= visit_next[node.get()];
+                visitor(node, visit_next[node.get()], level);
+            }
+
+            std::swap(visit, visit_next);
+            std::swap(context.frontier_, context.next_);
+        }
+
+        return true;
+    }
+
+    /**
+     * the sources are split into groups of 64 which are searched in parallel
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
+    {
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
+        }
+
+        std::fill(std::begin(out), std::end(out), common::INFINITY_WEIGHT);
+
+        // the indices of the targets of every node as offsetarray, a node can be a target twice
+        std::vector<std::size_t> target_offset(graph_.numberOfNodes() + 1, 0);
+        for(const auto target : targets) {
+            target_offset[target.get() + 1]++;
+        }
+        std::inclusive_scan(std::begin(target_offset),
+                            std::end(target_offset),
+                            std::begin(target_offset));
+
+        auto positions = target_offset;
+        std::vector<std::size_t> target_indices(targets.size());
+        for(std::size_t j = 0; j < targets.size(); j++) {
+            target_indices[positions[targets[j].get()]++] = j;
+        }
+
+        const auto number_of_groups = (sources.size() + SOURCES_PER_SEARCH - 1) / SOURCES_PER_SEARCH;
+        const auto range = common::range(number_of_groups);
+        std::for_each(std::execution::par,
+                      std::begin(range),
+                      std::end(range),
+                      [&](const auto group) {
+                          const auto first = group * SOURCES_PER_SEARCH;
+                          const auto group_sources = sources.subspan(first, std::min(SOURCES_PER_SEARCH, sources.size() - first));
+
+                          [[maybe_unused]] const auto valid = visitFrom(group_sources, [&](const auto node, auto reached, const auto distance) {
+                              const auto first_target = target_offset[node.get()];
+                              const auto last_target = target_offset[node.get() + 1];
+                              if(first_target == last_target) {
+                                  return;
+                              }
+
+                              while(reached != 0) {
+                                  const auto i = static_cast<std::size_t>(std::countr_zero(reached));
+                                  reached &= reached - 1;
+
+                                  for(auto t = first_target; t < last_target; t++) {
+                                      out[(first + i) * targets.size() + target_indices[t]] = distance;
+                                  }
+                              }
+                          });
+                      });
+
+        return true;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
+private:
+    const Graph& graph_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
+};
+
+} // namespace algorithms::distoracle
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithms/distoracle/DistanceTable.hpp>
 #include <algorithms/distoracle/ch/CHDijkstraBackwardHelper.hpp>
 #include <algorithms/distoracle/ch/CHDijkstraForwardHelper.hpp>
+#include <algorithms/distoracle/ch/SearchSpaceCache.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
@@ -11,65 +13,111 @@
 #include <concepts/Edges.hpp>
 #include <concepts/ForwardConnections.hpp>
 #include <concepts/NodeLevels.hpp>
+#include <concepts/UpwardArcs.hpp>
+#include <execution>
 #include <fmt/core.h>
+#include <memory>
+#include <numeric>
 #include <queue>
+#include <ranges>
+#include <tbb/enumerable_thread_specific.h>
 #include <type_traits>
 #include <utility>
+#include <utils/QueryStatistics.hpp>
 
 namespace algorithms::distoracle {
 
-template<class Graph, bool UseStallOnDemand = true>
+/**
+ * the graph is either prepared by prepareGraphForCHDijkstra or a CHSearchGraph,
+ * the latter only holds the upward arcs with their targets and weights inline
+ */
+template<class Graph, bool UseStallOnDemand = true, class Statistics = util::NoStatistics>
 // clang-format off
-  requires concepts::ForwardConnections<Graph>
-  && concepts::BackwardConnections<Graph>
-  && concepts::ReadableNodeLevels<Graph>
-  && concepts::HasEdges<Graph>
-  && concepts::HasBackwardEdges<Graph>
-  && concepts::HasNodes<Graph>
-  && concepts::HasTarget<typename Graph::EdgeType>
+  requires (concepts::ForwardConnections<Graph>
+            && concepts::BackwardConnections<Graph>
+            && concepts::ReadableNodeLevels<Graph>
+            && concepts::HasEdges<Graph>
+            && concepts::HasBackwardEdges<Graph>
+            && concepts::HasNodes<Graph>
+            && concepts::HasTarget<typename Graph::EdgeType>)
+        || concepts::HasUpwardArcs<Graph>
 // clang-format on
-class CHDijkstra : public CHDijkstraForwardHelper<
-                       CHDijkstra<Graph, UseStallOnDemand>,
-                       UseStallOnDemand>,
-                   public CHDijkstraBackwardHelper<
-                       CHDijkstra<Graph, UseStallOnDemand>,
-                       UseStallOnDemand>
+class CHDijkstra
 {
     using ForwardHelper = CHDijkstraForwardHelper<CHDijkstra, UseStallOnDemand>;
     using BackwardHelper = CHDijkstraBackwardHelper<CHDijkstra, UseStallOnDemand>;
-    friend ForwardHelper;
-    friend BackwardHelper;
 
 public:
-    constexpr static inline bool is_threadsafe = false;
-
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the scratch arrays of a single query, a context can be reused for many queries
+     * but must only be used by one thread at a time
+     */
+    class SearchContext : public ForwardHelper,
+                          public BackwardHelper
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : ForwardHelper(number_of_nodes),
+              BackwardHelper(number_of_nodes) {}
+    };
 
     template<bool SortGraphEdges = true>
-    constexpr CHDijkstra(const Graph& graph) noexcept
-        : ForwardHelper(graph.numberOfNodes()),
-          BackwardHelper(graph.numberOfNodes()),
-          graph_(graph)
+    CHDijkstra(const Graph& graph) noexcept
+        : graph_(graph),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
     {
         static_assert(concepts::DistanceOracle<CHDijkstra>,
                       "CHDijkstra should fullfill the DistanceOracle concept");
+
+        static_assert(concepts::ManyToManyDistanceOracle<CHDijkstra>,
+                      "CHDijkstra should fullfill the ManyToManyDistanceOracle concept");
     }
 
-    constexpr CHDijkstra(CHDijkstra&&) noexcept = default;
-    constexpr CHDijkstra(const CHDijkstra&) noexcept = delete;
+    CHDijkstra(CHDijkstra&&) noexcept = default;
+    CHDijkstra(const CHDijkstra&) noexcept = delete;
 
-    constexpr auto operator=(CHDijkstra&&) noexcept
+    auto operator=(CHDijkstra&&) noexcept
         -> CHDijkstra& = default;
 
-    constexpr auto operator=(const CHDijkstra&) noexcept
+    auto operator=(const CHDijkstra&) noexcept
         -> CHDijkstra& = delete;
 
-    [[nodiscard]] constexpr auto distanceBetween(common::NodeID source, common::NodeID target) noexcept
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    /**
+     * uses the context of the calling thread, contexts are created lazily
+     * the first time a thread queries the engine
+     */
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        return distanceBetween(contexts_.local(), source, target);
+    }
+
+    [[nodiscard]] auto distanceBetween(SearchContext& context,
+                                       common::NodeID source,
+                                       common::NodeID target) const noexcept
         -> common::Weight
     {
-        this->fillForwardInfo(source);
-        this->fillBackwardInfo(target);
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
 
-        const auto top_node_opt = findShortestPathCommonNode();
+        if(source_cache_) {
+            return cachedDistanceBetween(context, source, target, statistics);
+        }
+
+        context.fillForwardInfo(graph_, source, statistics);
+        context.fillBackwardInfo(graph_, target, statistics);
+
+        const auto top_node_opt = findShortestPathCommonNode(context);
 
         if(!top_node_opt) {
             return common::INFINITY_WEIGHT;
@@ -77,41 +125,336 @@ public:
 
         const auto top_node = top_node_opt.value();
 
-        return this->forward_distances_[top_node.get()]
-            + this->backward_distances_[top_node.get()];
+        return context.forward_distances_[top_node.get()]
+            + context.backward_distances_[top_node.get()];
     }
 
+    [[nodiscard]] auto distanceBetweenInterleaved(common::NodeID source,
+                                                  common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        return distanceBetweenInterleaved(contexts_.local(), source, target);
+    }
+
+    /**
+     * alternates between steps of the forward and the backward search and keeps the length mu
+     * of the shortest path found so far. a search stops as soon as the minimum of its queue is
+     * not below mu, so no sorting or merging of the search spaces is needed. other than
+     * distanceBetween the searches are not reused by the next query with the same source
+     */
+    [[nodiscard]] auto distanceBetweenInterleaved(SearchContext& context,
+                                                  common::NodeID source,
+                                                  common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        context.beginInterleavedForward(source);
+        context.beginInterleavedBackward(target);
+
+        pathfinding::DijkstraQueue forward_heap;
+        pathfinding::DijkstraQueue backward_heap;
+        forward_heap.emplace(source, 0);
+        backward_heap.emplace(target, 0);
+
+        auto mu = source == target ? common::Weight{0} : common::INFINITY_WEIGHT;
+
+        while(true) {
+            const auto forward_done = forward_heap.empty() or forward_heap.top().second >= mu;
+            const auto backward_done = backward_heap.empty() or backward_heap.top().second >= mu;
+
+            if(forward_done and backward_done) {
+                return mu;
+            }
+
+            if(!forward_done) {
+                context.interleavedForwardStep(graph_,
+                                               forward_heap,
+                                               context.backward_distances_,
+                                               mu,
+                                               statistics);
+            }
+
+            if(!backward_done) {
+                context.interleavedBackwardStep(graph_,
+                                                backward_heap,
+                                                context.forward_distances_,
+                                                mu,
+                                                statistics);
+            }
+        }
+    }
+
+    /**
+     * bucket based many to many query, the backward search of every target stores its
+     * distances in buckets at the nodes of its search space. afterwards the forward search of
+     * every source only has to scan the buckets of the nodes it settles.
+     * the searches of both phases run in parallel, the statistics record every
+     * search as a query and the scanned bucket entries as label entries
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
+    {
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
+        }
+
+        const auto [bucket_offsets, buckets] = fillBuckets(targets);
+
+        forEachDistanceTableRow(sources, targets, out, [&](const auto source, auto row) {
+            std::fill(std::begin(row), std::end(row), common::INFINITY_WEIGHT);
+
+            auto& context = contexts_.local();
+            auto& statistics = statistics_.local();
+            const util::QueryScope scope{statistics};
+            context.fillForwardInfo(graph_, source, statistics);
+
+            for(const auto node : context.forward_settled_) {
+                const auto forward_dist = context.forward_distances_[node.get()];
+                const auto first = bucket_offsets[node.get()];
+                const auto last = bucket_offsets[node.get() + 1];
+                statistics.count(util::QueryCounter::SCANNED_LABEL_ENTRIES, last - first);
+
+                for(auto i = first; i < last; i++) {
+                    const auto [target_idx, backward_dist] = buckets[i];
+                    row[target_idx] = std::min(row[target_idx], forward_dist + backward_dist);
+                }
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     * enables the caches of the upward search spaces of hot sources and hot targets, which are
+     * shared by all threads. each cache holds up to capacity search spaces, if both nodes of a
+     * query hit the cache no search runs at all and the two cached search spaces are merged
+     */
+    auto enableSearchSpaceCache(std::size_t capacity,
+                                std::size_t number_of_shards = 16,
+                                std::size_t admission_threshold = 2) noexcept
+        -> void
+    {
+        source_cache_ = std::make_unique<SearchSpaceCache>(capacity, number_of_shards, admission_threshold);
+        target_cache_ = std::make_unique<SearchSpaceCache>(capacity, number_of_shards, admission_threshold);
+    }
+
+    /**
+     * @returns the cache of the forward search spaces, null if the caches are not enabled
+     */
+    [[nodiscard]] auto sourceSearchSpaceCache() const noexcept
+        -> const SearchSpaceCache*
+    {
+        return source_cache_.get();
+    }
+
+    /**
+     * @returns the cache of the backward search spaces, null if the caches are not enabled
+     */
+    [[nodiscard]] auto targetSearchSpaceCache() const noexcept
+        -> const SearchSpaceCache*
+    {
+        return target_cache_.get();
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
 
 private:
-    [[nodiscard]] constexpr auto findShortestPathCommonNode() const noexcept
+    using BucketEntry = std::pair<std::size_t, common::Weight>;
+
+    /**
+     * @returns the buckets of all nodes as offsetarray, a bucket entry holds
+     * the index of the target and the backward distance from the node to it
+     */
+    [[nodiscard]] auto fillBuckets(std::span<const common::NodeID> targets) const noexcept
+        -> std::pair<std::vector<std::size_t>, std::vector<BucketEntry>>
+    {
+        tbb::enumerable_thread_specific<std::vector<std::pair<common::NodeID, BucketEntry>>> local_entries;
+
+        const auto range = common::range(targets.size());
+        std::for_each(std::execution::par,
+                      std::begin(range),
+                      std::end(range),
+                      [&](const auto j) {
+                          auto& context = contexts_.local();
+                          auto& entries = local_entries.local();
+                          auto& statistics = statistics_.local();
+                          const util::QueryScope scope{statistics};
+                          context.fillBackwardInfo(graph_, targets[j], statistics);
+
+                          for(const auto node : context.backward_settled_) {
+                              entries.emplace_back(node, BucketEntry{j, context.backward_distances_[node.get()]});
+                          }
+                      });
+
+        std::vector<std::size_t> offsets(graph_.numberOfNodes() + 1, 0);
+        for(const auto& entries : local_entries) {
+            for(const auto& [node, _] : entries) {
+                offsets[node.get() + 1]++;
+            }
+        }
+
+        std::inclusive_scan(std::begin(offsets),
+                            std::end(offsets),
+                            std::begin(offsets));
+
+        auto positions = offsets;
+        std::vector<BucketEntry> buckets(offsets.back());
+        for(const auto& entries : local_entries) {
+            for(const auto& [node, entry] : entries) {
+                buckets[positions[node.get()]++] = entry;
+            }
+        }
+
+        return std::pair{std::move(offsets), std::move(buckets)};
+    }
+
+    /**
+     * only the sides which miss the cache are searched, the search spaces of missing nodes
+     * which are hot enough are compacted and inserted afterwards
+     */
+    [[nodiscard]] auto cachedDistanceBetween(SearchContext& context,
+                                             common::NodeID source,
+                                             common::NodeID target,
+                                             Statistics& statistics) const noexcept
+        -> common::Weight
+    {
+        const auto forward = source_cache_->lookup(source);
+        const auto backward = target_cache_->lookup(target);
+
+        if(!forward.search_space_) {
+            context.fillForwardInfo(graph_, source, statistics);
+            if(forward.admit_) {
+                source_cache_->insert(source, context.compactForwardSearchSpace(graph_));
+            }
+        }
+
+        if(!backward.search_space_) {
+            context.fillBackwardInfo(graph_, target, statistics);
+            if(backward.admit_) {
+                target_cache_->insert(target, context.compactBackwardSearchSpace(graph_));
+            }
+        }
+
+        const auto live_forward = context.forward_settled_
+            | std::views::transform([&](const auto node) {
+                  return SearchSpaceEntry{node, context.forward_distances_[node.get()]};
+              });
+
+        const auto live_backward = context.backward_settled_
+            | std::views::transform([&](const auto node) {
+                  return SearchSpaceEntry{node, context.backward_distances_[node.get()]};
+              });
+
+        if(forward.search_space_ and backward.search_space_) {
+            return distanceOverCommonNodes(*forward.search_space_, *backward.search_space_, statistics);
+        }
+
+        if(forward.search_space_) {
+            return distanceOverCommonNodes(*forward.search_space_, live_backward, statistics);
+        }
+
+        if(backward.search_space_) {
+            return distanceOverCommonNodes(live_forward, *backward.search_space_, statistics);
+        }
+
+        return distanceOverCommonNodes(live_forward, live_backward, statistics);
+    }
+
+    /**
+     * merges two search spaces which are sorted by node id
+     * @returns the shortest distance over a node contained in both of them
+     */
+    template<class Forward, class Backward>
+    [[nodiscard]] static auto distanceOverCommonNodes(const Forward& forward,
+                                                      const Backward& backward,
+                                                      Statistics& statistics) noexcept
+        -> common::Weight
+    {
+        statistics.count(util::QueryCounter::SCANNED_LABEL_ENTRIES,
+                         std::ranges::size(forward) + std::ranges::size(backward));
+
+        auto best_dist = common::INFINITY_WEIGHT;
+        auto forward_iter = std::ranges::begin(forward);
+        auto backward_iter = std::ranges::begin(backward);
+
+        while(forward_iter != std::ranges::end(forward)
+              and backward_iter != std::ranges::end(backward)) {
+            const SearchSpaceEntry forward_entry = *forward_iter;
+            const SearchSpaceEntry backward_entry = *backward_iter;
+
+            if(forward_entry.node_ < backward_entry.node_) {
+                ++forward_iter;
+                continue;
+            }
+
+            if(forward_entry.node_ > backward_entry.node_) {
+                ++backward_iter;
+                continue;
+            }
+
+            best_dist = std::min(best_dist, forward_entry.distance_ + backward_entry.distance_);
+            ++forward_iter;
+            ++backward_iter;
+        }
+
+        return best_dist;
+    }
+
+    [[nodiscard]] static constexpr auto findShortestPathCommonNode(const SearchContext& context) noexcept
         -> std::optional<common::NodeID>
     {
-        if(this->forward_settled_.empty() or this->backward_settled_.empty()) {
+        if(context.forward_settled_.empty() or context.backward_settled_.empty()) {
             return std::nullopt;
         }
 
-        auto best_node = this->forward_settled_[0];
+        auto best_node = context.forward_settled_[0];
         auto best_dist = common::INFINITY_WEIGHT;
 
         auto forward_idx = 0ul;
         auto backward_idx = 0ul;
 
-        while(forward_idx < this->forward_settled_.size()
-              and backward_idx < this->backward_settled_.size()) {
+        while(forward_idx < context.forward_settled_.size()
+              and backward_idx < context.backward_settled_.size()) {
 
-            if(this->forward_settled_[forward_idx] < this->backward_settled_[backward_idx]) {
+            if(context.forward_settled_[forward_idx] < context.backward_settled_[backward_idx]) {
                 forward_idx++;
                 continue;
             }
 
-            if(this->forward_settled_[forward_idx] > this->backward_settled_[backward_idx]) {
+            if(context.forward_settled_[forward_idx] > context.backward_settled_[backward_idx]) {
                 backward_idx++;
                 continue;
             }
 
-            const auto common = this->forward_settled_[forward_idx];
-            const auto new_dist = this->forward_distances_[common.get()]
-                + this->backward_distances_[common.get()];
+            const auto common = context.forward_settled_[forward_idx];
+            const auto new_dist = context.forward_distances_[common.get()]
+                + context.backward_distances_[common.get()];
 
             if(new_dist < best_dist) {
                 best_dist = new_dist;
@@ -131,6 +474,10 @@ private:
 
 private:
     const Graph& graph_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    std::unique_ptr<SearchSpaceCache> source_cache_;
+    std::unique_ptr<SearchSpaceCache> target_cache_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
 };
 
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <algorithms/distoracle/ch/SearchSpaceCache.hpp>
+#include <algorithms/distoracle/ch/UpwardArcs.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
@@ -8,10 +11,16 @@
 #include <span>
 #include <type_traits>
 #include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::distoracle {
 
-template<class CRTP, bool UseStallOnDemand>
+/**
+ * scratch arrays of the backward search of a ch query, the helper is part of
+ * a search context and the graph is passed in by the engine which owns the context
+ */
+template<class Engine, bool UseStallOnDemand>
 class CHDijkstraBackwardHelper
 {
 public:
@@ -20,16 +29,19 @@ public:
     constexpr auto operator=(const CHDijkstraBackwardHelper&) noexcept
         -> CHDijkstraBackwardHelper& = delete;
 
-private:
+protected:
     constexpr CHDijkstraBackwardHelper(std::size_t number_of_nodes)
-        : backward_distances_(number_of_nodes, common::INFINITY_WEIGHT),
-          backward_already_settled_(number_of_nodes, false) {}
+        : backward_distances_(number_of_nodes, common::INFINITY_WEIGHT) {}
     constexpr CHDijkstraBackwardHelper(CHDijkstraBackwardHelper&&) noexcept = default;
 
     constexpr auto operator=(CHDijkstraBackwardHelper&&) noexcept
         -> CHDijkstraBackwardHelper& = default;
 
-    auto fillBackwardInfo(common::NodeID source) noexcept
+private:
+    template<class Graph, class Statistics>
+    auto fillBackwardInfo(const Graph& graph,
+                          common::NodeID source,
+                          Statistics& statistics) noexcept
         -> void
     {
         if(last_source_ == source) {
@@ -45,32 +57,32 @@ private:
             const auto [current_node, cost_to_current] = heap.top();
             heap.pop();
 
-            if(backward_already_settled_[current_node.get()]) {
+            if(backward_distances_.isSettled(current_node.get())) {
                 continue;
             }
 
-            backward_already_settled_[current_node.get()] = true;
-
-            const auto edge_ids = getGraph().getBackwardEdgeIDsOf(current_node);
+            backward_distances_.settle(current_node.get());
+            statistics.count(util::QueryCounter::SETTLED_NODES);
 
             if constexpr(UseStallOnDemand) {
-                if(shouldStall(cost_to_current, edge_ids)) {
+                if(shouldStall(cost_to_current, forwardArcsOf(graph, current_node))) {
+                    statistics.count(util::QueryCounter::STALLED_NODES);
                     continue;
                 }
             }
 
             backward_settled_.emplace_back(current_node);
 
-            for(const auto& id : edge_ids) {
-                const auto edge = getGraph().getBackwardEdge(id);
-                const auto neig = edge->getTrg();
-                const auto cost = edge->getWeight();
+            for(const auto arc : backwardArcsOf(graph, current_node)) {
+                const auto neig = arc.getTrg();
+                const auto cost = arc.getWeight();
                 const auto new_dist = cost + cost_to_current;
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
 
                 if(new_dist < backward_distances_[neig.get()]) {
                     heap.emplace(neig, new_dist);
-                    backward_distances_[neig.get()] = new_dist;
-                    backward_touched_.emplace_back(neig);
+                    backward_distances_.set(neig.get(), new_dist);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
                 }
             }
         }
@@ -79,14 +91,16 @@ private:
                   std::end(backward_settled_));
     }
 
+    // a node is stalled if it can be reached cheaper over an edge from a higher node,
+    // in the backward search these are the forward edges of the node
+    template<class Arcs>
     [[nodiscard]] constexpr auto shouldStall(common::Weight cost_to_current,
-                                             const std::span<const common::EdgeID>& edge_ids) const noexcept
+                                             Arcs&& ingoing_arcs) const noexcept
         -> bool
     {
-        for(const auto& id : edge_ids) {
-            const auto& edge = getGraph().getBackwardEdge(id);
-            const auto neig = edge->getTrg();
-            const auto cost = edge->getWeight();
+        for(const auto arc : ingoing_arcs) {
+            const auto neig = arc.getTrg();
+            const auto cost = arc.getWeight();
             const auto current_dist_to_neig = backward_distances_[neig.get()];
 
             if(current_dist_to_neig == common::INFINITY_WEIGHT) {
@@ -101,35 +115,120 @@ private:
         return false;
     }
 
-    constexpr auto resetBackwardFor(common::NodeID node) noexcept
+    /**
+     * @returns the search space of the last backward search sorted by node id. the search does not
+     * track the parents, they are recovered from the distances of the search space
+     */
+    template<class Graph>
+    [[nodiscard]] auto compactBackwardSearchSpace(const Graph& graph) const noexcept
+        -> SearchSpace
+    {
+        SearchSpace search_space;
+        search_space.reserve(backward_settled_.size());
+        for(const auto node : backward_settled_) {
+            search_space.push_back(SearchSpaceEntry{node, backward_distances_[node.get()]});
+        }
+
+        for(const auto node : backward_settled_) {
+            const auto distance = backward_distances_[node.get()];
+
+            for(const auto arc : backwardArcsOf(graph, node)) {
+                const auto neig = arc.getTrg();
+                const auto iter = std::lower_bound(std::begin(search_space),
+                                                   std::end(search_space),
+                                                   neig,
+                                                   [](const auto& entry, const auto id) {
+                                                       return entry.node_ < id;
+                                                   });
+
+                if(iter == std::end(search_space)
+                   or iter->node_ != neig
+                   or iter->node_ == last_source_
+                   or iter->parent_ != common::UNKNOWN_NODE_ID
+                   or iter->distance_ != distance + arc.getWeight()) {
+                    continue;
+                }
+
+                iter->parent_ = node;
+            }
+        }
+
+        return search_space;
+    }
+
+    /**
+     * starts a backward search which is interleaved with the forward search, it stops early
+     * and is therefore never reused by fillBackwardInfo
+     */
+    constexpr auto beginInterleavedBackward(common::NodeID source) noexcept
+        -> void
+    {
+        resetBackwardFor(source);
+        last_source_ = std::nullopt;
+    }
+
+    /**
+     * settles the next node of the heap, mu is lowered whenever a node is
+     * reached which was already reached by the forward search
+     */
+    template<class Graph, class Statistics>
+    auto interleavedBackwardStep(const Graph& graph,
+                             pathfinding::DijkstraQueue& heap,
+                             const util::VersionedArray<common::Weight>& forward_distances,
+                             common::Weight& mu,
+                             Statistics& statistics) noexcept
         -> void
     {
-        for(const auto& node : backward_touched_) {
-            const auto n = node.get();
-            backward_distances_[n] = common::INFINITY_WEIGHT;
-            backward_already_settled_[n] = false;
+        const auto [current_node, cost_to_current] = heap.top();
+        heap.pop();
+
+        if(backward_distances_.isSettled(current_node.get())) {
+            return;
         }
-        backward_settled_.clear();
-        backward_touched_.clear();
 
-        last_source_ = node;
-        backward_touched_.emplace_back(node);
-        backward_distances_[node.get()] = common::Weight{0};
+        backward_distances_.settle(current_node.get());
+        statistics.count(util::QueryCounter::SETTLED_NODES);
+
+        if constexpr(UseStallOnDemand) {
+            if(shouldStall(cost_to_current, forwardArcsOf(graph, current_node))) {
+                statistics.count(util::QueryCounter::STALLED_NODES);
+                return;
+            }
+        }
+
+        for(const auto arc : backwardArcsOf(graph, current_node)) {
+            const auto neig = arc.getTrg();
+            const auto new_dist = arc.getWeight() + cost_to_current;
+            statistics.count(util::QueryCounter::RELAXED_EDGES);
+
+            if(new_dist < backward_distances_[neig.get()]) {
+                heap.emplace(neig, new_dist);
+                backward_distances_.set(neig.get(), new_dist);
+                statistics.count(util::QueryCounter::QUEUE_PUSHES);
+
+                const auto forward_dist = forward_distances[neig.get()];
+                if(forward_dist != common::INFINITY_WEIGHT) {
+                    mu = std::min(mu, new_dist + forward_dist);
+                }
+            }
+        }
     }
 
-    [[nodiscard]] constexpr auto getGraph() const noexcept
-        -> decltype(auto)
+    constexpr auto resetBackwardFor(common::NodeID node) noexcept
+        -> void
     {
-        return static_cast<const CRTP*>(this)->graph_;
+        backward_distances_.clear();
+        backward_settled_.clear();
+
+        last_source_ = node;
+        backward_distances_.set(node.get(), common::Weight{0});
     }
 
 private:
-    friend CRTP;
+    friend Engine;
     std::vector<common::NodeID> backward_settled_;
-    std::vector<common::Weight> backward_distances_;
-    std::vector<common::NodeID> backward_touched_;
+    util::VersionedArray<common::Weight> backward_distances_;
     std::optional<common::NodeID> last_source_;
-    std::vector<bool> backward_already_settled_;
 };
 
 } // namespace algorithms::distoracle
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <algorithms/distoracle/ch/SearchSpaceCache.hpp>
+#include <algorithms/distoracle/ch/UpwardArcs.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
@@ -8,10 +11,16 @@
 #include <span>
 #include <type_traits>
 #include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::distoracle {
 
-template<class CRTP, bool UseStallOnDemand>
+/**
+ * scratch arrays of the forward search of a ch query, the helper is part of
+ * a search context and the graph is passed in by the engine which owns the context
+ */
+template<class Engine, bool UseStallOnDemand>
 class CHDijkstraForwardHelper
 {
 public:
@@ -20,17 +29,20 @@ public:
 
     constexpr CHDijkstraForwardHelper(const CHDijkstraForwardHelper&) noexcept = delete;
 
-private:
+protected:
     constexpr CHDijkstraForwardHelper(std::size_t number_of_nodes)
-        : forward_distances_(number_of_nodes, common::INFINITY_WEIGHT),
-          forward_already_settled_(number_of_nodes, false) {}
+        : forward_distances_(number_of_nodes, common::INFINITY_WEIGHT) {}
 
     constexpr CHDijkstraForwardHelper(CHDijkstraForwardHelper&&) noexcept = default;
 
     constexpr auto operator=(CHDijkstraForwardHelper&&) noexcept
         -> CHDijkstraForwardHelper& = default;
 
-    auto fillForwardInfo(common::NodeID source) noexcept
+private:
+    template<class Graph, class Statistics>
+    auto fillForwardInfo(const Graph& graph,
+                         common::NodeID source,
+                         Statistics& statistics) noexcept
         -> void
     {
         if(last_source_ == source) {
@@ -42,38 +54,36 @@ private:
         pathfinding::DijkstraQueue heap;
         heap.emplace(source, 0);
 
-        const auto& graph = getGraph();
-
         while(!heap.empty()) {
             const auto [current_node, cost_to_current] = heap.top();
             heap.pop();
 
-            if(forward_already_settled_[current_node.get()]) {
+            if(forward_distances_.isSettled(current_node.get())) {
                 continue;
             }
 
-            forward_already_settled_[current_node.get()] = true;
-
-            const auto edge_ids = graph.getForwardEdgeIDsOf(current_node);
+            forward_distances_.settle(current_node.get());
+            statistics.count(util::QueryCounter::SETTLED_NODES);
 
             if constexpr(UseStallOnDemand) {
-                if(shouldStall(cost_to_current, edge_ids)) {
+                if(shouldStall(cost_to_current, backwardArcsOf(graph, current_node))) {
+                    statistics.count(util::QueryCounter::STALLED_NODES);
                     continue;
                 }
             }
 
             forward_settled_.emplace_back(current_node);
 
-            for(const auto& id : edge_ids) {
-                const auto edge = graph.getEdge(id);
-                const auto neig = edge->getTrg();
-                const auto cost = edge->getWeight();
+            for(const auto arc : forwardArcsOf(graph, current_node)) {
+                const auto neig = arc.getTrg();
+                const auto cost = arc.getWeight();
                 const auto new_dist = cost + cost_to_current;
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
 
                 if(new_dist < forward_distances_[neig.get()]) {
                     heap.emplace(neig, new_dist);
-                    forward_distances_[neig.get()] = new_dist;
-                    forward_touched_.emplace_back(neig);
+                    forward_distances_.set(neig.get(), new_dist);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
                 }
             }
         }
@@ -82,14 +92,16 @@ private:
                   std::end(forward_settled_));
     }
 
+    // a node is stalled if it can be reached cheaper over an edge from a higher node,
+    // in the forward search these are the backward edges of the node
+    template<class Arcs>
     constexpr auto shouldStall(common::Weight cost_to_current,
-                               const std::span<const common::EdgeID>& edge_ids) const noexcept
+                               Arcs&& ingoing_arcs) const noexcept
         -> bool
     {
-        for(const auto& id : edge_ids) {
-            const auto* edge = getGraph().getEdge(id);
-            const auto neig = edge->getTrg();
-            const auto cost = edge->getWeight();
+        for(const auto arc : ingoing_arcs) {
+            const auto neig = arc.getTrg();
+            const auto cost = arc.getWeight();
             const auto current_dist_to_neig = forward_distances_[neig.get()];
 
             if(current_dist_to_neig == common::INFINITY_WEIGHT) {
@@ -104,34 +116,119 @@ private:
         return false;
     }
 
-    constexpr auto resetForwardFor(common::NodeID node) noexcept
+    /**
+     * @returns the search space of the last forward search sorted by node id. the search does not
+     * track the parents, they are recovered from the distances of the search space
+     */
+    template<class Graph>
+    [[nodiscard]] auto compactForwardSearchSpace(const Graph& graph) const noexcept
+        -> SearchSpace
+    {
+        SearchSpace search_space;
+        search_space.reserve(forward_settled_.size());
+        for(const auto node : forward_settled_) {
+            search_space.push_back(SearchSpaceEntry{node, forward_distances_[node.get()]});
+        }
+
+        for(const auto node : forward_settled_) {
+            const auto distance = forward_distances_[node.get()];
+
+            for(const auto arc : forwardArcsOf(graph, node)) {
+                const auto neig = arc.getTrg();
+                const auto iter = std::lower_bound(std::begin(search_space),
+                                                   std::end(search_space),
+                                                   neig,
+                                                   [](const auto& entry, const auto id) {
+                                                       return entry.node_ < id;
+                                                   });
+
+                if(iter == std::end(search_space)
+                   or iter->node_ != neig
+                   or iter->node_ == last_source_
+                   or iter->parent_ != common::UNKNOWN_NODE_ID
+                   or iter->distance_ != distance + arc.getWeight()) {
+                    continue;
+                }
+
+                iter->parent_ = node;
+            }
+        }
+
+        return search_space;
+    }
+
+    /**
+     * starts a forward search which is interleaved with the backward search, it stops early
+     * and is therefore never reused by fillForwardInfo
+     */
+    constexpr auto beginInterleavedForward(common::NodeID source) noexcept
         -> void
     {
-        for(const auto& node : forward_touched_) {
-            const auto n = node.get();
-            forward_distances_[n] = common::INFINITY_WEIGHT;
-            forward_already_settled_[n] = false;
+        resetForwardFor(source);
+        last_source_ = std::nullopt;
+    }
+
+    /**
+     * settles the next node of the heap, mu is lowered whenever a node is
+     * reached which was already reached by the backward search
+     */
+    template<class Graph, class Statistics>
+    auto interleavedForwardStep(const Graph& graph,
+                             pathfinding::DijkstraQueue& heap,
+                             const util::VersionedArray<common::Weight>& backward_distances,
+                             common::Weight& mu,
+                             Statistics& statistics) noexcept
+        -> void
+    {
+        const auto [current_node, cost_to_current] = heap.top();
+        heap.pop();
+
+        if(forward_distances_.isSettled(current_node.get())) {
+            return;
         }
-        forward_settled_.clear();
-        forward_touched_.clear();
 
-        last_source_ = node;
-        forward_touched_.emplace_back(node);
-        forward_distances_[node.get()] = common::Weight{0};
+        forward_distances_.settle(current_node.get());
+        statistics.count(util::QueryCounter::SETTLED_NODES);
+
+        if constexpr(UseStallOnDemand) {
+            if(shouldStall(cost_to_current, backwardArcsOf(graph, current_node))) {
+                statistics.count(util::QueryCounter::STALLED_NODES);
+                return;
+            }
+        }
+
+        for(const auto arc : forwardArcsOf(graph, current_node)) {
+            const auto neig = arc.getTrg();
+            const auto new_dist = arc.getWeight() + cost_to_current;
+            statistics.count(util::QueryCounter::RELAXED_EDGES);
+
+            if(new_dist < forward_distances_[neig.get()]) {
+                heap.emplace(neig, new_dist);
+                forward_distances_.set(neig.get(), new_dist);
+                statistics.count(util::QueryCounter::QUEUE_PUSHES);
+
+                const auto backward_dist = backward_distances[neig.get()];
+                if(backward_dist != common::INFINITY_WEIGHT) {
+                    mu = std::min(mu, new_dist + backward_dist);
+                }
+            }
+        }
     }
 
-    [[nodiscard]] constexpr auto getGraph() const noexcept
-        -> decltype(auto)
+    constexpr auto resetForwardFor(common::NodeID node) noexcept
+        -> void
     {
-        return static_cast<const CRTP*>(this)->graph_;
+        forward_distances_.clear();
+        forward_settled_.clear();
+
+        last_source_ = node;
+        forward_distances_.set(node.get(), common::Weight{0});
     }
 
 private:
-    friend CRTP;
-    std::vector<common::Weight> forward_distances_;
-    std::vector<common::NodeID> forward_touched_;
+    friend Engine;
+    util::VersionedArray<common::Weight> forward_distances_;
     std::optional<common::NodeID> last_source_;
-    std::vector<bool> forward_already_settled_;
     std::vector<common::NodeID> forward_settled_;
 };
 
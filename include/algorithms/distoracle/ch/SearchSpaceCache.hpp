@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <common/BasicGraphTypes.hpp>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * a node of a compacted upward search space, the parent is the node the distance
+ * was relaxed from and UNKNOWN_NODE_ID for the root of the search
+ */
+struct SearchSpaceEntry
+{
+    common::NodeID node_;
+    common::Weight distance_;
+    common::NodeID parent_ = common::UNKNOWN_NODE_ID;
+};
+
+/**
+ * the settled and not stalled nodes of an upward search sorted by node id
+ */
+using SearchSpace = std::vector<SearchSpaceEntry>;
+
+/**
+ * a bounded cache of the upward search spaces of hot sources or targets which is shared by
+ * all threads of an engine. the nodes are spread over shards which are locked independently
+ * and every shard evicts its least recently used search space. a search space is only admitted
+ * after its node missed the cache admission_threshold times, such that cold nodes do not
+ * evict the hot ones
+ */
+class SearchSpaceCache
+{
+public:
+    /**
+     * the result of a lookup, on a miss admit tells if the search space of the node
+     * should be inserted after it was computed
+     */
+    struct Lookup
+    {
+        std::shared_ptr<const SearchSpace> search_space_;
+        bool admit_ = false;
+    };
+
+    explicit SearchSpaceCache(std::size_t capacity,
+                              std::size_t number_of_shards = 16,
+                              std::size_t admission_threshold = 2) noexcept
+        : shards_(std::max(number_of_shards, std::size_t{1})),
+          capacity_per_shard_(std::max(std::size_t{1}, (capacity + shards_.size() - 1) / shards_.size())),
+          admission_threshold_(admission_threshold) {}
+
+    SearchSpaceCache(const SearchSpaceCache&) = delete;
+    auto operator=(const SearchSpaceCache&) -> SearchSpaceCache& = delete;
+
+    [[nodiscard]] auto lookup(common::NodeID node) noexcept
+        -> Lookup
+    {
+        auto& shard = shardOf(node);
+        const std::lock_guard lock{shard.mutex_};
+
+        if(const auto iter = shard.entries_.find(node.get()); iter != std::end(shard.entries_)) {
+            // move the entry to the front of the lru list
+            shard.lru_.splice(std::begin(shard.lru_), shard.lru_, iter->second);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return Lookup{iter->second->second, false};
+        }
+
+        misses_.fetch_add(1, std::memory_order_relaxed);
+
+        // the miss counts are forgotten from time to time, such that only nodes which
+        // are queried often within a short time are admitted
+        if(shard.misses_.size() > MISS_COUNTS_PER_ENTRY * capacity_per_shard_) {
+            shard.misses_.clear();
+        }
+
+        const auto misses = ++shard.misses_[node.get()];
+        return Lookup{nullptr, misses >= admission_threshold_};
+    }
+
+    /**
+     * @returns the cached search space of the node or null, other than lookup
+     * it neither counts as hit or miss nor changes the eviction order
+     */
+    [[nodiscard]] auto peek(common::NodeID node) const noexcept
+        -> std::shared_ptr<const SearchSpace>
+    {
+        const auto& shard = shards_[node.get() % shards_.size()];
+        const std::lock_guard lock{shard.mutex_};
+
+        if(const auto iter = shard.entries_.find(node.get()); iter != std::end(shard.entries_)) {
+            return iter->second->second;
+        }
+
+        return nullptr;
+    }
+
+    auto insert(common::NodeID node, SearchSpace search_space) noexcept
+        -> void
+    {
+        auto shared = std::make_shared<const SearchSpace>(std::move(search_space));
+
+        auto& shard = shardOf(node);
+        const std::lock_guard lock{shard.mutex_};
+
+        if(shard.entries_.contains(node.get())) {
+            return;
+        }
+
+        if(shard.lru_.size() >= capacity_per_shard_) {
+            shard.entries_.erase(shard.lru_.back().first);
+            shard.lru_.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        shard.lru_.emplace_front(node.get(), std::move(shared));
+        shard.entries_.emplace(node.get(), std::begin(shard.lru_));
+        shard.misses_.erase(node.get());
+        insertions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto clear() noexcept
+        -> void
+    {
+        for(auto& shard : shards_) {
+            const std::lock_guard lock{shard.mutex_};
+            shard.lru_.clear();
+            shard.entries_.clear();
+            shard.misses_.clear();
+        }
+
+        hits_ = 0;
+        misses_ = 0;
+        insertions_ = 0;
+        evictions_ = 0;
+    }
+
+    [[nodiscard]] auto hits() const noexcept
+        -> std::size_t
+    {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto misses() const noexcept
+        -> std::size_t
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto insertions() const noexcept
+        -> std::size_t
+    {
+        return insertions_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto evictions() const noexcept
+        -> std::size_t
+    {
+        return evictions_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @returns the fraction of lookups which hit the cache, 0 if there were no lookups
+     */
+    [[nodiscard]] auto hitRate() const noexcept
+        -> double
+    {
+        const auto lookups = hits() + misses();
+        if(lookups == 0) {
+            return 0.0;
+        }
+
+        return static_cast<double>(hits()) / static_cast<double>(lookups);
+    }
+
+private:
+    constexpr static inline std::size_t MISS_COUNTS_PER_ENTRY = 8;
+
+    using LRUList = std::list<std::pair<std::size_t, std::shared_ptr<const SearchSpace>>>;
+
+    struct Shard
+    {
+        mutable std::mutex mutex_;
+        LRUList lru_;
+        std::unordered_map<std::size_t, LRUList::iterator> entries_;
+        std::unordered_map<std::size_t, std::size_t> misses_;
+    };
+
+    [[nodiscard]] auto shardOf(common::NodeID node) noexcept
+        -> Shard&
+    {
+        return shards_[node.get() % shards_.size()];
+    }
+
+private:
+    std::vector<Shard> shards_;
+    std::size_t capacity_per_shard_;
+    std::size_t admission_threshold_;
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+    std::atomic<std::size_t> insertions_ = 0;
+    std::atomic<std::size_t> evictions_ = 0;
+};
+
+} // namespace algorithms::distoracle
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/UpwardArcs.hpp>
+#include <graphs/offsetarray/CHSearchGraph.hpp>
+#include <ranges>
+
+namespace algorithms::distoracle {
+
+/**
+ * @returns the arcs to higher nodes of a ch search graph or of a graph prepared for a ch query,
+ * the edges of a prepared graph are read through their ids and converted to arcs
+ */
+template<class Graph>
+[[nodiscard]] constexpr auto forwardArcsOf(const Graph& graph, common::NodeID node) noexcept
+{
+    if constexpr(concepts::HasUpwardArcs<Graph>) {
+        return graph.getForwardArcsOf(node);
+    } else {
+        return graph.getForwardEdgeIDsOf(node)
+            | std::views::transform([&graph](const auto id) {
+                   const auto* edge = graph.getEdge(id);
+
+                   // use the edge weight if available otherwise every edge has a weight 1
+                   if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+                       return graphs::CHArc{edge->getTrg(), edge->getWeight()};
+                   } else {
+                       return graphs::CHArc{edge->getTrg(), common::Weight{1}};
+                   }
+               });
+    }
+}
+
+/**
+ * @returns the arcs from higher nodes of a ch search graph or of a graph prepared for a ch query,
+ * the target of such an arc is the higher node
+ */
+template<class Graph>
+[[nodiscard]] constexpr auto backwardArcsOf(const Graph& graph, common::NodeID node) noexcept
+{
+    if constexpr(concepts::HasUpwardArcs<Graph>) {
+        return graph.getBackwardArcsOf(node);
+    } else {
+        return graph.getBackwardEdgeIDsOf(node)
+            | std::views::transform([&graph](const auto id) {
+                   const auto edge = graph.getBackwardEdge(id);
+
+                   if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+                       return graphs::CHArc{edge->getTrg(), edge->getWeight()};
+                   } else {
+                       return graphs::CHArc{edge->getTrg(), common::Weight{1}};
+                   }
+               });
+    }
+}
+
+} // namespace algorithms::distoracle
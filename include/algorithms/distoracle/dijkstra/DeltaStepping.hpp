@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/distoracle/DistanceTable.hpp>
+#include <atomic>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <execution>
+#include <optional>
+#include <span>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * parallel one to all queries with delta stepping. the tentative distances are kept in buckets
+ * of width delta, the nodes of the lowest bucket are expanded in parallel and the distance
+ * array is updated with an atomic min. edges of at most delta are light and are relaxed
+ * until the bucket stays empty, because they can refill it, the heavy edges of all nodes
+ * removed from a bucket are relaxed once afterwards.
+ * a single query uses all threads, the engine can still be queried by many threads at once
+ */
+template<class Graph, class Statistics = util::NoStatistics>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasTarget<typename Graph::EdgeType>
+// clang-format on
+class DeltaStepping
+{
+    struct Arc
+    {
+        common::NodeID trg_;
+        common::Weight weight_;
+    };
+
+    /**
+     * the nodes whose distance was lowered by a thread during one relaxation phase
+     */
+    struct Relaxations
+    {
+        std::vector<common::NodeID> improved_;
+        std::size_t relaxed_edges_ = 0;
+    };
+
+    // smaller frontiers are relaxed by the calling thread, the parallel
+    // algorithms cost more than they gain for only a few nodes
+    constexpr static inline std::size_t PARALLEL_FRONTIER_SIZE = 256;
+
+public:
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the distance array and the buckets of a single query, a context can be reused
+     * for many queries but must only be used by one query at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : distances_(number_of_nodes, common::INFINITY_WEIGHT),
+              rounds_(number_of_nodes, 0) {}
+
+    private:
+        friend DeltaStepping;
+        std::vector<common::Weight> distances_;
+        // the round in which a node was last taken from a bucket, such that
+        // nodes which were inserted multiple times are expanded only once per round
+        std::vector<std::size_t> rounds_;
+        std::size_t round_ = 0;
+        std::vector<std::vector<common::NodeID>> buckets_;
+        std::vector<common::NodeID> candidates_;
+        std::vector<common::NodeID> frontier_;
+        std::vector<common::NodeID> removed_;
+        tbb::enumerable_thread_specific<Relaxations> relaxations_;
+        std::optional<common::NodeID> last_source_;
+    };
+
+    /**
+     * uses the average edge weight as bucket width
+     */
+    DeltaStepping(const Graph& graph) noexcept
+        : DeltaStepping(graph, averageEdgeWeight(graph)) {}
+
+    DeltaStepping(const Graph& graph, common::Weight delta) noexcept
+        : graph_(graph),
+          delta_(std::max(delta, common::Weight{1})),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
+    {
+        static_assert(concepts::OneToManyDistanceOracle<DeltaStepping>,
+                      "DeltaStepping should fullfill the OneToManyDistanceOracle concept");
+
+        static_assert(concepts::ManyToManyDistanceOracle<DeltaStepping>,
+                      "DeltaStepping should fullfill the ManyToManyDistanceOracle concept");
+
+        splitEdges();
+    }
+
+    DeltaStepping(DeltaStepping&&) noexcept = default;
+    DeltaStepping(const DeltaStepping&) noexcept = delete;
+    auto operator=(const DeltaStepping&) -> DeltaStepping& = delete;
+    auto operator=(DeltaStepping&&) noexcept -> DeltaStepping& = delete;
+
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    [[nodiscard]] auto getDelta() const noexcept
+        -> common::Weight
+    {
+        return delta_;
+    }
+
+    /**
+     * uses the context of the calling thread, the returned distances stay valid
+     * until the calling thread issues its next query
+     */
+    [[nodiscard]] auto distancesFrom(common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        return distancesFrom(contexts_.local(), source);
+    }
+
+    [[nodiscard]] auto distancesFrom(SearchContext& context, common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        if(context.last_source_ == source) {
+            return context.distances_;
+        }
+
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        resetFor(context, source);
+
+        // the buckets grow while they are processed, therefore they are accessed by index
+        for(std::size_t i = 0; i < context.buckets_.size(); i++) {
+            context.removed_.clear();
+
+            while(!context.buckets_[i].empty()) {
+                takeFrontier(context, i);
+                statistics.count(util::QueryCounter::SETTLED_NODES, context.frontier_.size());
+
+                context.removed_.insert(std::end(context.removed_),
+                                        std::begin(context.frontier_),
+                                        std::end(context.frontier_));
+
+                relax(context, context.frontier_, light_offset_, light_arcs_, statistics);
+            }
+
+            std::sort(std::begin(context.removed_), std::end(context.removed_));
+            const auto last = std::unique(std::begin(context.removed_), std::end(context.removed_));
+            context.removed_.erase(last, std::end(context.removed_));
+
+            relax(context, context.removed_, heavy_offset_, heavy_arcs_, statistics);
+        }
+
+        return context.distances_;
+    }
+
+    /**
+     * the rows are computed one after another, every row uses all threads
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
+    {
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
+        }
+
+        auto& context = contexts_.local();
+        for(std::size_t i = 0; i < sources.size(); i++) {
+            const auto& distances = distancesFrom(context, sources[i]);
+            for(std::size_t j = 0; j < targets.size(); j++) {
+                out[i * targets.size() + j] = distances[targets[j].get()];
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
+private:
+    [[nodiscard]] static auto edgeWeight(const typename Graph::EdgeType& edge) noexcept
+        -> common::Weight
+    {
+        // use the edge weight if available otherwise every edge has a weight 1
+        if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+            return edge.getWeight();
+        } else {
+            return common::Weight{1};
+        }
+    }
+
+    [[nodiscard]] static auto averageEdgeWeight(const Graph& graph) noexcept
+        -> common::Weight
+    {
+        if(graph.numberOfEdges() == 0) {
+            return common::Weight{1};
+        }
+
+        common::Weight sum{0};
+        for(std::size_t i = 0; i < graph.numberOfEdges(); i++) {
+            sum += edgeWeight(*graph.getEdge(common::EdgeID{i}));
+        }
+
+        return common::Weight{sum.get() / static_cast<std::int_fast64_t>(graph.numberOfEdges())};
+    }
+
+    /**
+     * copies the targets and weights of the edges into a light and a heavy offsetarray,
+     * such that a relaxation phase only scans the edges it relaxes
+     */
+    auto splitEdges() noexcept
+        -> void
+    {
+        const auto number_of_nodes = graph_.numberOfNodes();
+        light_offset_.reserve(number_of_nodes + 1);
+        heavy_offset_.reserve(number_of_nodes + 1);
+        light_offset_.emplace_back(0);
+        heavy_offset_.emplace_back(0);
+
+        for(std::size_t n = 0; n < number_of_nodes; n++) {
+            for(const auto id : graph_.getForwardEdgeIDsOf(common::NodeID{n})) {
+                const auto* edge = graph_.getEdge(id);
+                const auto weight = edgeWeight(*edge);
+                auto& arcs = weight <= delta_ ? light_arcs_ : heavy_arcs_;
+                arcs.push_back(Arc{edge->getTrg(), weight});
+            }
+
+            light_offset_.emplace_back(light_arcs_.size());
+            heavy_offset_.emplace_back(heavy_arcs_.size());
+        }
+    }
+
+    auto resetFor(SearchContext& context, common::NodeID source) const noexcept
+        -> void
+    {
+        std::fill(std::execution::par_unseq,
+                  std::begin(context.distances_),
+                  std::end(context.distances_),
+                  common::INFINITY_WEIGHT);
+
+        for(auto& bucket : context.buckets_) {
+            bucket.clear();
+        }
+
+        context.last_source_ = source;
+        context.distances_[source.get()] = common::Weight{0};
+        insertIntoBucket(context, source);
+    }
+
+    [[nodiscard]] auto bucketOf(common::Weight distance) const noexcept
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(distance.get() / delta_.get());
+    }
+
+    auto insertIntoBucket(SearchContext& context, common::NodeID node) const noexcept
+        -> void
+    {
+        const auto bucket = bucketOf(context.distances_[node.get()]);
+        if(bucket >= context.buckets_.size()) {
+            context.buckets_.resize(bucket + 1);
+        }
+
+        context.buckets_[bucket].emplace_back(node);
+    }
+
+    /**
+     * moves the nodes of the bucket into the frontier, nodes whose distance moved them
+     * into a lower bucket and nodes which were inserted multiple times are skipped
+     */
+    auto takeFrontier(SearchContext& context, std::size_t bucket) const noexcept
+        -> void
+    {
+        std::swap(context.candidates_, context.buckets_[bucket]);
+        context.frontier_.clear();
+        context.round_++;
+
+        for(const auto node : context.candidates_) {
+            if(bucketOf(context.distances_[node.get()]) != bucket
+               or context.rounds_[node.get()] == context.round_) {
+                continue;
+            }
+
+            context.rounds_[node.get()] = context.round_;
+            context.frontier_.emplace_back(node);
+        }
+
+        context.candidates_.clear();
+    }
+
+    /**
+     * relaxes the given arcs of all nodes in parallel and inserts every
+     * improved node into the bucket of its final distance of this phase
+     */
+    auto relax(SearchContext& context,
+               std::span<const common::NodeID> nodes,
+               const std::vector<std::size_t>& offset,
+               const std::vector<Arc>& arcs,
+               Statistics& statistics) const noexcept
+        -> void
+    {
+        auto& distances = context.distances_;
+
+        const auto relax_node = [&](const auto node) {
+            auto& relaxations = context.relaxations_.local();
+            const auto distance = std::atomic_ref{distances[node.get()]}.load(std::memory_order_relaxed);
+
+            const auto first = offset[node.get()];
+            const auto last = offset[node.get() + 1];
+            relaxations.relaxed_edges_ += last - first;
+
+            for(auto i = first; i < last; i++) {
+                const auto [trg, weight] = arcs[i];
+                if(atomicMin(distances[trg.get()], distance + weight)) {
+                    relaxations.improved_.emplace_back(trg);
+                }
+            }
+        };
+
+        if(nodes.size() < PARALLEL_FRONTIER_SIZE) {
+            std::for_each(std::begin(nodes), std::end(nodes), relax_node);
+        } else {
+            std::for_each(std::execution::par, std::begin(nodes), std::end(nodes), relax_node);
+        }
+
+        for(auto& relaxations : context.relaxations_) {
+            statistics.count(util::QueryCounter::RELAXED_EDGES, relaxations.relaxed_edges_);
+            statistics.count(util::QueryCounter::QUEUE_PUSHES, relaxations.improved_.size());
+
+            for(const auto node : relaxations.improved_) {
+                insertIntoBucket(context, node);
+            }
+
+            relaxations.improved_.clear();
+            relaxations.relaxed_edges_ = 0;
+        }
+    }
+
+    /**
+     * @returns true if the value was lower than the target and was written
+     */
+    static auto atomicMin(common::Weight& target, common::Weight value) noexcept
+        -> bool
+    {
+        std::atomic_ref ref{target};
+        auto current = ref.load(std::memory_order_relaxed);
+
+        while(value < current) {
+            if(ref.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    const Graph& graph_;
+    common::Weight delta_;
+    std::vector<std::size_t> light_offset_;
+    std::vector<Arc> light_arcs_;
+    std::vector<std::size_t> heavy_offset_;
+    std::vector<Arc> heavy_arcs_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
+};
+
+} // namespace algorithms::distoracle
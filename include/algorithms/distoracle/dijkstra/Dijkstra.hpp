@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithms/distoracle/DistanceTable.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
@@ -8,12 +9,22 @@
 #include <concepts/ForwardConnections.hpp>
 #include <fmt/core.h>
 #include <queue>
+#include <tbb/enumerable_thread_specific.h>
 #include <type_traits>
 #include <utility>
+#include <utils/EdgeFilter.hpp>
+#include <utils/QueryStatistics.hpp>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::distoracle {
 
-template<class Graph>
+/**
+ * the filter is checked for every relaxed edge, blocked edges are skipped as if they
+ * were not part of the graph
+ */
+template<class Graph,
+         class Statistics = util::NoStatistics,
+         class Filter = util::NoEdgeFilter>
 // clang-format off
 requires concepts::ForwardConnections<Graph>
       && concepts::HasEdges<Graph>
@@ -22,52 +33,123 @@ requires concepts::ForwardConnections<Graph>
 // clang-format on
 class Dijkstra
 {
+    // the generation of the filter is only tracked if the filter can block edges
+    using FilterGeneration = std::conditional_t<Filter::is_enabled,
+                                                std::size_t,
+                                                common::EmptyBase1>;
+
 public:
-    constexpr static inline bool is_threadsafe = false;
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the scratch arrays of a single query, a context can be reused for many queries
+     * but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : distances_(number_of_nodes, common::INFINITY_WEIGHT),
+              pq_(pathfinding::DijkstraQueueComparer{}),
+              last_source_(std::nullopt) {}
+
+    private:
+        friend Dijkstra;
+        util::VersionedArray<common::Weight> distances_;
+        // plain copy of distances_ returned by one to all queries
+        std::vector<common::Weight> all_distances_;
+        pathfinding::DijkstraQueue pq_;
+        std::optional<common::NodeID> last_source_;
+        [[no_unique_address]] FilterGeneration filter_generation_{};
+    };
 
-    Dijkstra(const Graph& graph) noexcept
+    Dijkstra(const Graph& graph, Filter filter = Filter{}) noexcept
         : graph_(graph),
-          distances_(graph.numberOfNodes(), common::INFINITY_WEIGHT),
-          settled_(graph.numberOfNodes(), false),
-          pq_(pathfinding::DijkstraQueueComparer{}),
-          last_source_(std::nullopt)
+          filter_(std::move(filter)),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
     {
-        static_assert(concepts::DistanceOracle<Dijkstra<Graph>>,
+        static_assert(concepts::DistanceOracle<Dijkstra>,
                       "Dijkstra should fullfill the DistanceOracle concept");
+
+        static_assert(concepts::ManyToManyDistanceOracle<Dijkstra>,
+                      "Dijkstra should fullfill the ManyToManyDistanceOracle concept");
     }
 
     Dijkstra() = delete;
     Dijkstra(Dijkstra&&) noexcept = default;
-    Dijkstra(const Dijkstra&) noexcept = default;
+    Dijkstra(const Dijkstra&) noexcept = delete;
     auto operator=(const Dijkstra&) -> Dijkstra& = delete;
     auto operator=(Dijkstra&&) noexcept -> Dijkstra& = default;
 
-    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) noexcept
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    /**
+     * replaces the filter, the searches started with the old filter are not resumed.
+     * must not be called while other threads query the engine
+     */
+    auto setEdgeFilter(Filter filter) noexcept
+        -> void
+    {
+        filter_ = std::move(filter);
+        if constexpr(Filter::is_enabled) {
+            filter_generation_++;
+        }
+    }
+
+    [[nodiscard]] auto getEdgeFilter() const noexcept
+        -> const Filter&
+    {
+        return filter_;
+    }
+
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        return distanceBetween(contexts_.local(), source, target);
+    }
+
+    [[nodiscard]] auto distanceBetween(SearchContext& context,
+                                       common::NodeID source,
+                                       common::NodeID target) const noexcept
         -> common::Weight
     {
-        if(last_source_ == source
-           and settled_[target.get()]) {
-            return distances_[target.get()];
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+        syncWithFilter(context);
+
+        if(context.last_source_ == source
+           and context.distances_.isSettled(target.get())) {
+            return context.distances_[target.get()];
         }
 
-        if(source != last_source_) {
-            resetFor(source);
+        if(source != context.last_source_) {
+            resetFor(context, source);
         }
 
-        while(!pq_.empty()) {
-            const auto [current_node, current_dist] = pq_.top();
+        while(!context.pq_.empty()) {
+            const auto [current_node, current_dist] = context.pq_.top();
             if(current_node == target) {
                 return current_dist;
             }
 
             // pop after the return, otherwise we loose a value
             // when reusing the pq
-            pq_.pop();
+            context.pq_.pop();
 
             const auto edge_ids = graph_.getForwardEdgeIDsOf(current_node);
 
             for(const auto id : edge_ids) {
                 const auto* edge = graph_.getEdge(id);
+                if(filter_.isBlocked(id, *edge)) {
+                    continue;
+                }
+
                 const auto neig = edge->getTrg();
 
                 // use the edge weight if available otherwise every edge has a weight 1
@@ -81,38 +163,54 @@ public:
                 }
                 ();
 
-                const auto neig_dist = distances_[neig.get()];
+                const auto neig_dist = context.distances_[neig.get()];
                 const auto new_dist = current_dist + distance;
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
 
                 if(common::INFINITY_WEIGHT != current_dist and neig_dist > new_dist) {
-                    touched_.emplace_back(neig);
-                    distances_[neig.get()] = new_dist;
-                    pq_.emplace(neig, new_dist);
+                    context.distances_.set(neig.get(), new_dist);
+                    context.pq_.emplace(neig, new_dist);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
                 }
             }
 
-            settled_[current_node.get()] = true;
+            context.distances_.settle(current_node.get());
+            statistics.count(util::QueryCounter::SETTLED_NODES);
         }
 
         return common::INFINITY_WEIGHT;
     }
 
-    [[nodiscard]] auto distancesFrom(common::NodeID source) noexcept
+    [[nodiscard]] auto distancesFrom(common::NodeID source) const noexcept
+        -> const std::vector<common::Weight>&
+    {
+        return distancesFrom(contexts_.local(), source);
+    }
+
+    [[nodiscard]] auto distancesFrom(SearchContext& context,
+                                     common::NodeID source) const noexcept
         -> const std::vector<common::Weight>&
     {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+        syncWithFilter(context);
 
-        if(source != last_source_) {
-            resetFor(source);
+        if(source != context.last_source_) {
+            resetFor(context, source);
         }
 
-        while(!pq_.empty()) {
-            const auto [current_node, current_dist] = pq_.top();
-            pq_.pop();
+        while(!context.pq_.empty()) {
+            const auto [current_node, current_dist] = context.pq_.top();
+            context.pq_.pop();
 
             const auto edge_ids = graph_.getForwardEdgeIDsOf(current_node);
 
             for(const auto id : edge_ids) {
                 const auto* edge = graph_.getEdge(id);
+                if(filter_.isBlocked(id, *edge)) {
+                    continue;
+                }
+
                 const auto neig = edge->getTrg();
 
                 // use the edge weight if available otherwise every edge has a weight 1
@@ -126,48 +224,102 @@ public:
                 }
                 ();
 
-                const auto neig_dist = distances_[neig.get()];
+                const auto neig_dist = context.distances_[neig.get()];
                 const auto new_dist = current_dist + distance;
+                statistics.count(util::QueryCounter::RELAXED_EDGES);
 
                 if(common::INFINITY_WEIGHT != current_dist and neig_dist > new_dist) {
-                    touched_.emplace_back(neig);
-                    distances_[neig.get()] = new_dist;
-                    pq_.emplace(neig, new_dist);
+                    context.distances_.set(neig.get(), new_dist);
+                    context.pq_.emplace(neig, new_dist);
+                    statistics.count(util::QueryCounter::QUEUE_PUSHES);
                 }
             }
 
-            settled_[current_node.get()] = true;
+            context.distances_.settle(current_node.get());
+            statistics.count(util::QueryCounter::SETTLED_NODES);
         }
 
-        return distances_;
+        context.distances_.exportTo(context.all_distances_);
+        return context.all_distances_;
+    }
+
+    /**
+     * runs one search per source in parallel, the targets are queried one after another
+     * on the same search, which therefore stops as soon as all targets are settled
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
+    {
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
+        }
+
+        forEachDistanceTableRow(sources, targets, out, [&](const auto source, auto row) {
+            auto& context = contexts_.local();
+            for(std::size_t j = 0; j < targets.size(); j++) {
+                row[j] = distanceBetween(context, source, targets[j]);
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
     }
 
 private:
-    constexpr auto resetFor(common::NodeID new_source) noexcept
+    // a search started with another filter can not be resumed
+    constexpr auto syncWithFilter(SearchContext& context) const noexcept
         -> void
     {
-        for(const auto id : touched_) {
-            const auto n = id.get();
-            settled_[n] = false;
-            distances_[n] = common::INFINITY_WEIGHT;
+        if constexpr(Filter::is_enabled) {
+            if(context.filter_generation_ != filter_generation_) {
+                context.last_source_ = std::nullopt;
+                context.filter_generation_ = filter_generation_;
+            }
         }
+    }
 
-        touched_.clear();
-        pq_ = pathfinding::DijkstraQueue{pathfinding::DijkstraQueueComparer{}};
+    constexpr static auto resetFor(SearchContext& context, common::NodeID new_source) noexcept
+        -> void
+    {
+        context.distances_.clear();
+        context.pq_ = pathfinding::DijkstraQueue{pathfinding::DijkstraQueueComparer{}};
 
-        last_source_ = new_source;
-        pq_.emplace(new_source, 0l);
-        distances_[new_source.get()] = common::Weight{0};
-        touched_.emplace_back(new_source);
+        context.last_source_ = new_source;
+        context.pq_.emplace(new_source, 0l);
+        context.distances_.set(new_source.get(), common::Weight{0});
     }
 
 private:
     const Graph& graph_;
-    std::vector<common::Weight> distances_;
-    std::vector<bool> settled_;
-    std::vector<common::NodeID> touched_;
-    pathfinding::DijkstraQueue pq_;
-    std::optional<common::NodeID> last_source_;
+    [[no_unique_address]] Filter filter_;
+    [[no_unique_address]] FilterGeneration filter_generation_{};
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
 };
 
 } // namespace algorithms::distoracle
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithms/distoracle/ch/UpwardArcs.hpp>
 #include <algorithms/distoracle/hublabels/HubLabelLookup.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
@@ -13,19 +14,25 @@
 #include <concepts/NodeLevels.hpp>
 #include <concepts/Nodes.hpp>
 #include <concepts/Sortable.hpp>
+#include <concepts/UpwardArcs.hpp>
 #include <execution>
 
 namespace algorithms::distoracle {
 
+/**
+ * the graph is either prepared by prepareGraphForHubLabelCalculator or a CHSearchGraph,
+ * both number the nodes by level descending
+ */
 template<class Graph>
 // clang-format off
-  requires concepts::ForwardConnections<Graph>
-  && concepts::BackwardConnections<Graph>
-  && concepts::ReadableNodeLevels<Graph>
-  && concepts::HasEdges<Graph>
-  && concepts::HasBackwardEdges<Graph>
-  && concepts::HasNodes<Graph>
-  && concepts::HasTarget<typename Graph::EdgeType>
+  requires (concepts::ForwardConnections<Graph>
+            && concepts::BackwardConnections<Graph>
+            && concepts::ReadableNodeLevels<Graph>
+            && concepts::HasEdges<Graph>
+            && concepts::HasBackwardEdges<Graph>
+            && concepts::HasNodes<Graph>
+            && concepts::HasTarget<typename Graph::EdgeType>)
+        || concepts::HasUpwardArcs<Graph>
 // clang-format on
 class HubLabelCalculator
 {
@@ -41,18 +48,9 @@ private:
     {
         std::vector<HubLabelLookup::HubType> hubs;
         hubs.emplace_back(node, common::Weight{0});
-        for(const auto edge_id : graph_.getForwardEdgeIDsOf(node)) {
-            const auto *edge = graph_.getEdge(edge_id);
-            const auto trg = edge->getTrg();
-            const auto weight = [&]() constexpr
-            {
-                if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
-                    return edge->getWeight();
-                } else {
-                    return common::Weight{1};
-                }
-            }
-            ();
+        for(const auto arc : forwardArcsOf(graph_, node)) {
+            const auto trg = arc.getTrg();
+            const auto weight = arc.getWeight();
 
             hubs.emplace_back(trg, weight);
 
@@ -98,18 +96,9 @@ private:
     {
         std::vector<HubLabelLookup::HubType> hubs;
         hubs.emplace_back(node, common::Weight{0});
-        for(const auto edge_id : graph_.getBackwardEdgeIDsOf(node)) {
-            const auto edge = graph_.getBackwardEdge(edge_id);
-            const auto trg = edge->getTrg();
-            const auto weight = [&]() constexpr
-            {
-                if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
-                    return edge->getWeight();
-                } else {
-                    return common::Weight{1};
-                }
-            }
-            ();
+        for(const auto arc : backwardArcsOf(graph_, node)) {
+            const auto trg = arc.getTrg();
+            const auto weight = arc.getWeight();
 
             hubs.emplace_back(trg, weight);
 
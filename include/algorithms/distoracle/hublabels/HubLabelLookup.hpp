@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithms/distoracle/DistanceTable.hpp>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
@@ -18,10 +19,12 @@
 #include <type_traits>
 #include <utility>
 #include <utils/Permutation.hpp>
+#include <utils/QueryStatistics.hpp>
 
 namespace algorithms::distoracle {
 
-class HubLabelLookup
+template<class Statistics = util::NoStatistics>
+class BasicHubLabelLookup
 {
     template<class Graph>
     // clang-format off
@@ -35,25 +38,40 @@ class HubLabelLookup
     // clang-format on
     friend class HubLabelCalculator;
 
+    template<class OtherStatistics>
+    friend class BasicHubLabelLookup;
+
     using HubType = std::pair<common::NodeID, common::Weight>;
 
     // private ctor because a HubLabelLookup should only be consructed via a HubLabelCalculator
-    HubLabelLookup(std::vector<std::vector<HubType>> in_labels,
-                   std::vector<std::vector<HubType>> out_labels) noexcept
+    BasicHubLabelLookup(std::vector<std::vector<HubType>> in_labels,
+                        std::vector<std::vector<HubType>> out_labels) noexcept
         : in_labels_(std::move(in_labels)),
           out_labels_(std::move(out_labels))
     {
-        static_assert(concepts::DistanceOracle<HubLabelLookup>,
+        static_assert(concepts::DistanceOracle<BasicHubLabelLookup>,
                       "HubLabelLookup should fullfill the DistanceOracle concept");
 
-        static_assert(concepts::NodesPermutable<HubLabelLookup>,
+        static_assert(concepts::ManyToManyDistanceOracle<BasicHubLabelLookup>,
+                      "HubLabelLookup should fullfill the ManyToManyDistanceOracle concept");
+
+        static_assert(concepts::NodesPermutable<BasicHubLabelLookup>,
                       "HubLabelLookup should be able to permutate nodes");
     }
 
-
     [[nodiscard]] static auto distanceOracle(const std::vector<HubType>& out_l,
                                              const std::vector<HubType>& in_l) noexcept
         -> common::Weight
+    {
+        util::NoStatistics statistics;
+        return distanceOracle(out_l, in_l, statistics);
+    }
+
+    template<class QueryStatistics>
+    [[nodiscard]] static auto distanceOracle(const std::vector<HubType>& out_l,
+                                             const std::vector<HubType>& in_l,
+                                             QueryStatistics& statistics) noexcept
+        -> common::Weight
     {
         const auto max_s_size = out_l.size();
         const auto max_t_size = in_l.size();
@@ -83,11 +101,22 @@ class HubLabelLookup
             }
         }
 
+        statistics.count(util::QueryCounter::SCANNED_LABEL_ENTRIES, s_idx + t_idx);
         return best_dist;
     }
 
 public:
-    constexpr static inline bool is_threadsafe = false;
+    // queries only read the labels, no search state is needed
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * moves the labels of a lookup with a different statistics policy,
+     * e.g. to instrument the lookup returned by a HubLabelCalculator
+     */
+    template<class OtherStatistics>
+    explicit BasicHubLabelLookup(BasicHubLabelLookup<OtherStatistics>&& other) noexcept
+        : BasicHubLabelLookup(std::move(other.in_labels_),
+                              std::move(other.out_labels_)) {}
 
     [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
         -> common::Weight
@@ -95,7 +124,58 @@ public:
         const auto& in_l = in_labels_[target.get()];
         const auto& out_l = out_labels_[source.get()];
 
-        return HubLabelLookup::distanceOracle(out_l, in_l);
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+        return distanceOracle(out_l, in_l, statistics);
+    }
+
+    /**
+     * the rows are calculated in parallel, every row merges the out label
+     * of its source with the in labels of all targets and is recorded as one query
+     */
+    [[nodiscard]] auto distanceTable(std::span<const common::NodeID> sources,
+                                     std::span<const common::NodeID> targets,
+                                     std::span<common::Weight> out) const noexcept
+        -> bool
+    {
+        if(!isValidDistanceTable(sources, targets, out)) {
+            return false;
+        }
+
+        forEachDistanceTableRow(sources, targets, out, [&](const auto source, auto row) {
+            const auto& out_l = out_labels_[source.get()];
+            auto& statistics = statistics_.local();
+            const util::QueryScope scope{statistics};
+            for(std::size_t j = 0; j < targets.size(); j++) {
+                row[j] = distanceOracle(out_l, in_labels_[targets[j].get()], statistics);
+            }
+        });
+
+        return true;
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the lookup
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
     }
 
     [[nodiscard]] auto numberOfNodes() const noexcept
@@ -104,6 +184,30 @@ public:
         return in_labels_.size();
     }
 
+    /**
+     * @returns the number of hubs in the in and out labels of all nodes
+     */
+    [[nodiscard]] auto numberOfLabelEntries() const noexcept
+        -> std::size_t
+    {
+        const auto count_hubs = [](const auto sum, const auto& label) {
+            return sum + label.size();
+        };
+
+        return std::accumulate(std::begin(in_labels_), std::end(in_labels_), std::size_t{0}, count_hubs)
+            + std::accumulate(std::begin(out_labels_), std::end(out_labels_), std::size_t{0}, count_hubs);
+    }
+
+    /**
+     * @returns the bytes of the hubs and the label vectors of all nodes
+     */
+    [[nodiscard]] auto memoryUsage() const noexcept
+        -> std::size_t
+    {
+        return numberOfLabelEntries() * sizeof(HubType)
+            + (in_labels_.size() + out_labels_.size()) * sizeof(std::vector<HubType>);
+    }
+
     auto applyNodePermutation(std::vector<std::size_t> perm,
                               const std::vector<std::size_t>& inv_perm) noexcept
         -> bool
@@ -156,6 +260,9 @@ public:
 private:
     std::vector<std::vector<HubType>> in_labels_;
     std::vector<std::vector<HubType>> out_labels_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
 };
 
+using HubLabelLookup = BasicHubLabelLookup<>;
+
 } // namespace algorithms::distoracle
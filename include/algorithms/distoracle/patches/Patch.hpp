@@ -13,6 +13,9 @@
 
 namespace algorithms::distoracle {
 
+template<class Statistics>
+class BasicPatchLookup;
+
 class Patch
 {
 public:
@@ -70,7 +73,9 @@ public:
     }
 
 private:
-    friend class PatchLookup;
+    template<class Statistics>
+    friend class BasicPatchLookup;
+
     std::vector<std::pair<common::NodeID, common::Weight>> sources_;
     common::NodeID barrier_;
     std::vector<std::pair<common::NodeID, common::Weight>> targets_;
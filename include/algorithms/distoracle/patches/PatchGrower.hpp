@@ -15,11 +15,12 @@
 #include <set>
 #include <type_traits>
 #include <utility>
+#include <utils/QueryStatistics.hpp>
 
 namespace algorithms::distoracle {
 
 // clang-format off
-template<class Graph, class OneToOneDistanceOracle>
+template<class Graph, class OneToOneDistanceOracle, class Statistics = util::NoStatistics>
 requires concepts::HasNodes<Graph> &&
          concepts::HasEdges<Graph> &&
          concepts::HasSource<typename Graph::EdgeType> &&
@@ -52,6 +53,8 @@ public:
                             std::vector<common::NodeID> targets) noexcept
         -> Patch
     {
+        const util::QueryScope scope{statistics_};
+
         std::optional src_opt = sources[0];
         std::optional trg_opt = targets[0];
 
@@ -74,6 +77,21 @@ public:
         return createPatch();
     }
 
+    /**
+     * every grown patch is recorded as one query, the oracle queries count the distance
+     * queries issued to the oracle and the lookup while testing the candidates
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_;
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_ = Statistics{};
+    }
 
 private:
     auto growSource(common::NodeID node, std::size_t max_size) noexcept
@@ -151,12 +169,14 @@ private:
         while(stack.size() < max_size and !queue.empty()) {
             const auto [current_node, dist] = queue.top();
             queue.pop();
+            statistics_.count(util::QueryCounter::SETTLED_NODES);
 
             const auto incomming = graph_.getBackwardEdgeIDsOf(current_node);
             for(const auto& id : incomming) {
                 const auto edge = graph_.getBackwardEdge(id);
                 const auto trg = edge->getTrg();
                 const auto trg_idx = trg.get();
+                statistics_.count(util::QueryCounter::RELAXED_EDGES);
 
                 if(visited_[trg_idx]) {
                     continue;
@@ -165,6 +185,7 @@ private:
                 visited_[trg_idx] = true;
                 touched2_.emplace_back(trg_idx);
                 queue.emplace(trg, dist + common::Weight{1});
+                statistics_.count(util::QueryCounter::QUEUE_PUSHES);
 
                 if(as_source_tested_[trg_idx]) {
                     continue;
@@ -197,12 +218,14 @@ private:
         while(stack.size() < max_size and !queue.empty()) {
             const auto [current_node, dist] = queue.top();
             queue.pop();
+            statistics_.count(util::QueryCounter::SETTLED_NODES);
 
             const auto outgoing = graph_.getForwardEdgeIDsOf(current_node);
             for(const auto& id : outgoing) {
                 const auto* edge = graph_.getEdge(id);
                 const auto trg = edge->getTrg();
                 const auto trg_idx = trg.get();
+                statistics_.count(util::QueryCounter::RELAXED_EDGES);
 
                 if(visited_[trg_idx]) {
                     continue;
@@ -211,6 +234,7 @@ private:
                 visited_[trg_idx] = true;
                 touched2_.emplace_back(trg_idx);
                 queue.emplace(trg, dist + common::Weight{1});
+                statistics_.count(util::QueryCounter::QUEUE_PUSHES);
 
                 if(as_target_tested_[trg_idx]) {
                     continue;
@@ -255,6 +279,7 @@ private:
         return std::any_of(std::begin(sources_patch_),
                            std::end(sources_patch_),
                            [&](const auto src) {
+                               statistics_.count(util::QueryCounter::ORACLE_QUERIES);
                                return lookup_.distanceBetween(src, node) == common::INFINITY_WEIGHT;
                            });
     }
@@ -270,6 +295,7 @@ private:
         return std::any_of(std::begin(targets_patch_),
                            std::end(targets_patch_),
                            [&](const auto trg) {
+                               statistics_.count(util::QueryCounter::ORACLE_QUERIES);
                                return lookup_.distanceBetween(node, trg) == common::INFINITY_WEIGHT;
                            });
     }
@@ -322,6 +348,7 @@ private:
             std::begin(targets_fringe_),
             std::end(targets_fringe_),
             [&](const auto trg) {
+                statistics_.count(util::QueryCounter::ORACLE_QUERIES);
                 const auto real_dist = oracle_.distanceBetween(node, trg);
                 const auto over_barrier_dist = to_barrier + barrier_to_all_[trg.get()];
                 return real_dist == over_barrier_dist;
@@ -341,6 +368,7 @@ private:
             std::begin(sources_fringe_),
             std::end(sources_fringe_),
             [&](const auto src) {
+                statistics_.count(util::QueryCounter::ORACLE_QUERIES);
                 const auto real_dist = oracle_.distanceBetween(src, node);
                 const auto over_barrier_dist = all_to_barrier_[src.get()] + from_barrier;
                 return real_dist == over_barrier_dist;
@@ -461,6 +489,7 @@ private:
             touched_.emplace_back(node);
         }
 
+        statistics_.count(util::QueryCounter::ORACLE_QUERIES, 2 * graph_.numberOfNodes());
         for(std::size_t i = 0; i < graph_.numberOfNodes(); i++) {
             const auto node = common::NodeID{i};
             const auto to_b = oracle_.distanceBetween(node, barrier_);
@@ -523,6 +552,9 @@ private:
     std::vector<common::NodeID> touched_;
     std::vector<std::size_t> touched2_;
     std::vector<bool> visited_;
+
+    // the queries of the oracle are counted in const functions
+    [[no_unique_address]] mutable Statistics statistics_;
 };
 
 } // namespace algorithms::distoracle
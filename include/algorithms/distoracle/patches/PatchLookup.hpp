@@ -7,10 +7,12 @@
 #include <execution>
 #include <numeric>
 #include <utils/Permutation.hpp>
+#include <utils/QueryStatistics.hpp>
 
 namespace algorithms::distoracle {
 
-class PatchLookup
+template<class Statistics = util::NoStatistics>
+class BasicPatchLookup
 {
     using PatchType = std::pair<std::size_t, common::Weight>;
 
@@ -18,15 +20,15 @@ class PatchLookup
 public:
     constexpr static inline bool is_threadsafe = true;
 
-    PatchLookup(std::size_t number_of_nodes, std::vector<Patch> patches = {}) noexcept
+    BasicPatchLookup(std::size_t number_of_nodes, std::vector<Patch> patches = {}) noexcept
         : in_patches_(number_of_nodes),
           out_patches_(number_of_nodes),
           number_of_patches_(patches.size())
     {
-        static_assert(concepts::DistanceOracle<PatchLookup>,
+        static_assert(concepts::DistanceOracle<BasicPatchLookup>,
                       "PatchLookup should fullfill the DistanceOracle concept");
 
-        static_assert(concepts::NodesPermutable<PatchLookup>,
+        static_assert(concepts::NodesPermutable<BasicPatchLookup>,
                       "PatchLookup should be able to permutate nodes");
 
         for(std::size_t i = 0; i < patches.size(); i++) {
@@ -50,6 +52,9 @@ public:
         const auto& in_l = in_patches_[target.get()];
         const auto& out_l = out_patches_[source.get()];
 
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
         const auto max_s_size = out_l.size();
         const auto max_t_size = in_l.size();
 
@@ -61,6 +66,7 @@ public:
             const auto trg_hub = in_l[t_idx];
 
             if(src_hub.first == trg_hub.first) {
+                statistics.count(util::QueryCounter::SCANNED_LABEL_ENTRIES, s_idx + t_idx + 2);
                 return src_hub.second + trg_hub.second;
             }
 
@@ -71,9 +77,34 @@ public:
             }
         }
 
+        statistics.count(util::QueryCounter::SCANNED_LABEL_ENTRIES, s_idx + t_idx);
         return common::INFINITY_WEIGHT;
     }
 
+    /**
+     * @returns the merged statistics of all threads which queried the lookup
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
     [[nodiscard]] auto numberOfNodes() const noexcept
         -> std::size_t
     {
@@ -148,6 +179,9 @@ private:
     std::vector<std::vector<PatchType>> in_patches_;
     std::vector<std::vector<PatchType>> out_patches_;
     std::size_t number_of_patches_;
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
 };
 
+using PatchLookup = BasicPatchLookup<>;
+
 } // namespace algorithms::distoracle
@@ -1,83 +1,285 @@
 #pragma once
 
-#include <algorithms/distoracle/patches/Patch.hpp>
-#include <algorithms/distoracle/patches/PatchLookup.hpp>
+#include <algorithm>
 #include <algorithms/distoracle/patches/quadtree/QuadTree.hpp>
-#include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
+#include <algorithms/distoracle/patches/quadtree/QuadTreeNode.hpp>
 #include <common/BasicGraphTypes.hpp>
-#include <common/EmptyBase.hpp>
-#include <concepts/BackwardConnections.hpp>
-#include <concepts/DistanceOracle.hpp>
-#include <concepts/Edges.hpp>
-#include <concepts/ForwardConnections.hpp>
-#include <concepts/Nodes.hpp>
-#include <fmt/core.h>
-#include <queue>
-#include <set>
+#include <common/Range.hpp>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_group.h>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace algorithms {
 
+/**
+ * a well separated pair of two quadtree nodes,
+ * the nodes are referenced by their index inside of the quadtree
+ * to keep the decomposition small even for small epsilons
+ */
 struct WellSeparatedPair
 {
-    WellSeparatedPair(const impl::QuadTreeNode& first,
-                      const impl::QuadTreeNode& second) noexcept
-        : box1_(first.getBoundingBox()),
-          box2_(second.getBoundingBox()),
-          elements1_(first.getElements()),
-          elements2_(second.getElements()) {}
+    constexpr WellSeparatedPair() noexcept = default;
+    constexpr WellSeparatedPair(std::uint32_t first, std::uint32_t second) noexcept
+        : first_(first),
+          second_(second) {}
 
     [[nodiscard]] constexpr auto operator==(const WellSeparatedPair& rhs) const noexcept
-        -> bool
-    {
-        return box1_ == rhs.box1_ and box2_ == rhs.box2_;
-    }
+        -> bool = default;
+
+    std::uint32_t first_ = QuadTree::ROOT_INDEX;
+    std::uint32_t second_ = QuadTree::ROOT_INDEX;
+};
+
+namespace impl {
+
+// up to this depth of the recursion the calculation is forked into new tasks,
+// below it every task runs sequentially on its thread local buffer
+constexpr static inline std::size_t WSPD_FORK_DEPTH = 5;
 
-    impl::BoundingBox box1_;
-    impl::BoundingBox box2_;
-    std::span<const common::NodeID> elements1_;
-    std::span<const common::NodeID> elements2_;
+enum class WSPDStep {
+    SKIP,
+    EMIT,
+    SPLIT_FIRST,
+    SPLIT_SECOND
 };
 
-inline auto calulateWSPDRecHelper(const impl::QuadTreeNode& first,
-                                  const impl::QuadTreeNode& second,
-                                  double epsilon,
-                                  std::vector<WellSeparatedPair>& result) noexcept
+inline auto nextWSPDStep(const QuadTree& tree,
+                         std::uint32_t first,
+                         std::uint32_t second,
+                         double epsilon) noexcept
+    -> WSPDStep
+{
+    const auto& first_node = tree.getNode(first);
+    const auto& second_node = tree.getNode(second);
+
+    // pairs with an empty side do not cover any node pair
+    if(first_node.empty() or second_node.empty()) {
+        return WSPDStep::SKIP;
+    }
+
+    // well separation check
+    const auto diam = std::max(first_node.diam(), second_node.diam());
+    if(diam <= epsilon * first_node.distanceTo(second_node)) {
+        return WSPDStep::EMIT;
+    }
+
+    // leafs cannot be split any further
+    if(first_node.isLeaf() and second_node.isLeaf()) {
+        return WSPDStep::EMIT;
+    }
+
+    // split the node with the larger diameter
+    if(second_node.isLeaf()
+       or (!first_node.isLeaf() and first_node.diam() >= second_node.diam())) {
+        return WSPDStep::SPLIT_FIRST;
+    }
+
+    return WSPDStep::SPLIT_SECOND;
+}
+
+inline auto appendWSPDPair(std::vector<WellSeparatedPair>& sink,
+                           std::uint32_t first,
+                           std::uint32_t second) noexcept
     -> void
 {
-    if(first == second) {
+    sink.emplace_back(first, second);
+}
+
+inline auto appendWSPDPair(std::size_t& sink,
+                           [[maybe_unused]] std::uint32_t first,
+                           [[maybe_unused]] std::uint32_t second) noexcept
+    -> void
+{
+    sink++;
+}
+
+template<class Sink>
+auto findWSPDPairs(const QuadTree& tree,
+                   std::uint32_t first,
+                   std::uint32_t second,
+                   double epsilon,
+                   Sink& sink) noexcept
+    -> void
+{
+    switch(nextWSPDStep(tree, first, second, epsilon)) {
+    case WSPDStep::SKIP:
+        return;
+
+    case WSPDStep::EMIT:
+        appendWSPDPair(sink, first, second);
+        return;
+
+    case WSPDStep::SPLIT_FIRST:
+        for(const auto child : tree.getNode(first).getChildrenUnsafe()) {
+            findWSPDPairs(tree, child, second, epsilon, sink);
+        }
+        return;
+
+    case WSPDStep::SPLIT_SECOND:
+        for(const auto child : tree.getNode(second).getChildrenUnsafe()) {
+            findWSPDPairs(tree, first, child, epsilon, sink);
+        }
         return;
     }
+}
 
-	// well separation check
-    if(first.diam() <= epsilon * first.distanceTo(second)) {
-        result.emplace_back(first, second);
+template<class Sink>
+auto collectWSPDPairs(const QuadTree& tree,
+                      std::uint32_t node,
+                      double epsilon,
+                      Sink& sink) noexcept
+    -> void
+{
+    const auto children_opt = tree.getNode(node).getChildren();
+    if(!children_opt) {
         return;
     }
 
-    if(first.getBoundingBox() < second.getBoundingBox()) {
-        calulateWSPDRecHelper(first, *second.getTopLeftChild(), epsilon, result);
-        calulateWSPDRecHelper(first, *second.getTopRightChild(), epsilon, result);
-        calulateWSPDRecHelper(first, *second.getBottomLeftChild(), epsilon, result);
-        calulateWSPDRecHelper(first, *second.getBottomRightChild(), epsilon, result);
-    } else {
-        calulateWSPDRecHelper(second, *first.getTopLeftChild(), epsilon, result);
-        calulateWSPDRecHelper(second, *first.getTopRightChild(), epsilon, result);
-        calulateWSPDRecHelper(second, *first.getBottomLeftChild(), epsilon, result);
-        calulateWSPDRecHelper(second, *first.getBottomRightChild(), epsilon, result);
+    const auto& children = children_opt.value();
+    for(std::size_t i = 0; i < children.size(); i++) {
+        collectWSPDPairs(tree, children[i], epsilon, sink);
+
+        for(std::size_t j = i + 1; j < children.size(); j++) {
+            findWSPDPairs(tree, children[i], children[j], epsilon, sink);
+        }
     }
 }
 
-inline auto calculateWSPD(QuadTree& tree, double epsilon) noexcept
+template<class Sink>
+auto findWSPDPairsInParallel(const QuadTree& tree,
+                             std::uint32_t first,
+                             std::uint32_t second,
+                             double epsilon,
+                             std::size_t depth,
+                             tbb::enumerable_thread_specific<Sink>& sinks) noexcept
+    -> void
+{
+    if(depth >= WSPD_FORK_DEPTH) {
+        findWSPDPairs(tree, first, second, epsilon, sinks.local());
+        return;
+    }
+
+    const auto step = nextWSPDStep(tree, first, second, epsilon);
+    if(step == WSPDStep::SKIP) {
+        return;
+    }
+
+    if(step == WSPDStep::EMIT) {
+        appendWSPDPair(sinks.local(), first, second);
+        return;
+    }
+
+    const auto split_first = step == WSPDStep::SPLIT_FIRST;
+    const auto to_split = split_first ? first : second;
+
+    tbb::task_group group;
+    for(const auto child : tree.getNode(to_split).getChildrenUnsafe()) {
+        group.run([&, child] {
+            if(split_first) {
+                findWSPDPairsInParallel(tree, child, second, epsilon, depth + 1, sinks);
+            } else {
+                findWSPDPairsInParallel(tree, first, child, epsilon, depth + 1, sinks);
+            }
+        });
+    }
+    group.wait();
+}
+
+template<class Sink>
+auto collectWSPDPairsInParallel(const QuadTree& tree,
+                                std::uint32_t node,
+                                double epsilon,
+                                std::size_t depth,
+                                tbb::enumerable_thread_specific<Sink>& sinks) noexcept
+    -> void
+{
+    if(depth >= WSPD_FORK_DEPTH) {
+        collectWSPDPairs(tree, node, epsilon, sinks.local());
+        return;
+    }
+
+    const auto children_opt = tree.getNode(node).getChildren();
+    if(!children_opt) {
+        return;
+    }
+
+    const auto& children = children_opt.value();
+
+    tbb::task_group group;
+    for(std::size_t i = 0; i < children.size(); i++) {
+        group.run([&, i] {
+            collectWSPDPairsInParallel(tree, children[i], epsilon, depth + 1, sinks);
+        });
+
+        for(std::size_t j = i + 1; j < children.size(); j++) {
+            group.run([&, i, j] {
+                findWSPDPairsInParallel(tree, children[i], children[j], epsilon, depth + 1, sinks);
+            });
+        }
+    }
+    group.wait();
+}
+
+} // namespace impl
+
+inline auto calculateWSPD(const QuadTree& tree, double epsilon) noexcept
     -> std::vector<WellSeparatedPair>
 {
     std::vector<WellSeparatedPair> wspd;
-    calulateWSPDRecHelper(tree.getRoot(),
-                          tree.getRoot(),
-                          epsilon,
-                          wspd);
+    impl::collectWSPDPairs(tree, QuadTree::ROOT_INDEX, epsilon, wspd);
     return wspd;
 }
 
+/**
+ * calculates the same decomposition as calculateWSPD, but forks the recursion at
+ * the top levels of the quadtree. the pairs are collected in thread local buffers which
+ * are concatenated at the end, the order of the pairs is therefore not deterministic
+ */
+inline auto calculateWSPDInParallel(const QuadTree& tree, double epsilon) noexcept
+    -> std::vector<WellSeparatedPair>
+{
+    tbb::enumerable_thread_specific<std::vector<WellSeparatedPair>> buffers;
+    impl::collectWSPDPairsInParallel(tree, QuadTree::ROOT_INDEX, epsilon, 0, buffers);
+
+    std::vector<const std::vector<WellSeparatedPair>*> parts;
+    std::vector<std::size_t> offsets{0};
+    for(const auto& buffer : buffers) {
+        parts.emplace_back(&buffer);
+        offsets.emplace_back(offsets.back() + buffer.size());
+    }
+
+    std::vector<WellSeparatedPair> wspd(offsets.back());
+    const auto range = common::range(parts.size());
+    std::for_each(std::execution::par,
+                  std::begin(range),
+                  std::end(range),
+                  [&](const auto i) {
+                      std::copy(std::begin(*parts[i]),
+                                std::end(*parts[i]),
+                                std::begin(wspd) + offsets[i]);
+                  });
+
+    return wspd;
+}
+
+/**
+ * counts the pairs of the decomposition without materialising them,
+ * this can be used to check the size of the decomposition for a given epsilon
+ */
+inline auto countWSPDPairs(const QuadTree& tree, double epsilon) noexcept
+    -> std::size_t
+{
+    tbb::enumerable_thread_specific<std::size_t> counters{0};
+    impl::collectWSPDPairsInParallel(tree, QuadTree::ROOT_INDEX, epsilon, 0, counters);
+
+    return std::accumulate(std::begin(counters),
+                           std::end(counters),
+                           std::size_t{0});
+}
+
 } // namespace algorithms
@@ -4,6 +4,7 @@
 #include <concepts/Nodes.hpp>
 #include <optional>
 #include <cmath>
+#include <limits>
 
 namespace algorithms::impl {
 
@@ -17,7 +18,9 @@ public:
     [[nodiscard]] constexpr auto isInside(double x, double y) const noexcept
         -> bool
     {
-        return x > x_0_ and x < x_1_ and y > y_0_ and y < y_1_;
+        // the borders are inclusive, every point of the box has to be inside
+        // of at least one of its children
+        return x >= x_0_ and x <= x_1_ and y >= y_0_ and y <= y_1_;
     }
 
     [[nodiscard]] constexpr auto split() const noexcept
@@ -35,7 +38,9 @@ public:
     [[nodiscard]] constexpr auto diameter() const noexcept
         -> double
     {
-        return y_1_ - y_0_;
+        const auto width = x_1_ - x_0_;
+        const auto height = y_1_ - y_0_;
+        return std::sqrt(width * width + height * height);
     }
 
     [[nodiscard]] constexpr auto operator==(const BoundingBox& rhs) const noexcept
@@ -56,8 +61,8 @@ public:
     [[nodiscard]] constexpr auto center() const noexcept
         -> std::pair<double, double>
     {
-        return std::pair{x_1_ / 2 + x_0_,
-                         y_1_ / 2 + y_0_};
+        return std::pair{(x_0_ + x_1_) / 2,
+                         (y_0_ + y_1_) / 2};
     }
 
     [[nodiscard]] constexpr auto centerDistanceTo(const BoundingBox& other) const noexcept
@@ -90,14 +95,14 @@ constexpr auto createBoundBoxFor(const Graph& graph) noexcept
         return std::nullopt;
     }
 
-    double x_0 = 0;
-    double y_0 = 0;
-    double x_1 = std::numeric_limits<double>::max();
-    double y_1 = std::numeric_limits<double>::max();
+    double x_0 = std::numeric_limits<double>::max();
+    double y_0 = std::numeric_limits<double>::max();
+    double x_1 = std::numeric_limits<double>::lowest();
+    double y_1 = std::numeric_limits<double>::lowest();
 
     for(const auto& node : graph.getNodes()) {
-        const auto lat = node.getLat();
-        const auto lng = node.getLng();
+        const auto lat = static_cast<double>(node.getLat().get());
+        const auto lng = static_cast<double>(node.getLng().get());
 
         x_0 = std::min(x_0, lat);
         y_0 = std::min(y_0, lng);
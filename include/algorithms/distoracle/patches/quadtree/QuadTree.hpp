@@ -3,9 +3,11 @@
 #include <algorithms/distoracle/patches/quadtree/BoundingBox.hpp>
 #include <algorithms/distoracle/patches/quadtree/QuadTreeNode.hpp>
 #include <concepts/Nodes.hpp>
+#include <cstdint>
 #include <fmt/core.h>
 #include <numeric>
 #include <optional>
+#include <vector>
 
 namespace algorithms {
 
@@ -19,23 +21,45 @@ private:
 	         concepts::HasLatLng<typename Graph::NodeType>
     // clang-format on
     friend class QuadTreeConstructor;
-    friend class WSPD;
 
     // a quad tree should be created by a QuadTreeConstructor
-    QuadTree(impl::QuadTreeNode root,
-			 std::vector<common::NodeID> elements) noexcept
-        : root_(std::move(root)), elements_(std::move(elements))
+    QuadTree(std::vector<impl::QuadTreeNode> nodes,
+             std::vector<common::NodeID> elements) noexcept
+        : nodes_(std::move(nodes)), elements_(std::move(elements))
     {}
 
 public:
+    constexpr static inline std::uint32_t ROOT_INDEX = 0;
+
+    // copying would leave the element spans of the nodes dangling
+    QuadTree(const QuadTree&) = delete;
+    QuadTree(QuadTree&&) noexcept = default;
+
+    auto operator=(const QuadTree&) -> QuadTree& = delete;
+    auto operator=(QuadTree&&) noexcept -> QuadTree& = default;
+
     [[nodiscard]] auto getRoot() const noexcept
         -> const impl::QuadTreeNode&
     {
-        return root_;
+        return nodes_[ROOT_INDEX];
+    }
+
+    [[nodiscard]] auto getNode(std::uint32_t index) const noexcept
+        -> const impl::QuadTreeNode&
+    {
+        return nodes_[index];
+    }
+
+    [[nodiscard]] auto numberOfNodes() const noexcept
+        -> std::size_t
+    {
+        return nodes_.size();
     }
 
 private:
-    impl::QuadTreeNode root_;
+    // the nodes elements are spans into elements_, moving the vectors
+    // does not invalidate them
+    std::vector<impl::QuadTreeNode> nodes_;
     std::vector<common::NodeID> elements_;
 };
 
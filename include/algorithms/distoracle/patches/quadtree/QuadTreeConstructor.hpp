@@ -3,7 +3,10 @@
 #include <algorithms/distoracle/patches/quadtree/BoundingBox.hpp>
 #include <algorithms/distoracle/patches/quadtree/QuadTree.hpp>
 #include <algorithms/distoracle/patches/quadtree/QuadTreeNode.hpp>
+#include <algorithm>
 #include <concepts/Nodes.hpp>
+#include <cstdint>
+#include <numeric>
 #include <optional>
 #include <vector>
 
@@ -19,52 +22,62 @@ class QuadTreeConstructor
 {
 public:
     QuadTreeConstructor(const Graph& graph) noexcept
-        : graph_(graph)
+        : graph_(graph),
+          elements_(graph.numberOfNodes())
     {
-        nodes_.reserve(graph_.numberOfNodes());
-        std::iota(std::begin(nodes_), std::end(nodes_), common::NodeID{0});
+        std::iota(std::begin(elements_), std::end(elements_), common::NodeID{0});
     }
 
     [[nodiscard]] auto constuctQuadTree() && noexcept
         -> std::optional<QuadTree>
     {
-        if(graph_.numberOfNodes() == 0) {
+        auto root_box_opt = impl::createBoundBoxFor(graph_);
+        if(!root_box_opt) {
             return std::nullopt;
         }
 
-        auto root_box = impl::createBoundBoxFor(graph_);
-        auto root_node = *recursiveNodeConstrucion(root_box, nodes_);
+        nodes_.emplace_back(root_box_opt.value(), elements_);
+        recursiveNodeConstrucion(QuadTree::ROOT_INDEX);
 
-        return QuadTree{std::move(root_node), std::move(nodes_)};
+        return QuadTree{std::move(nodes_), std::move(elements_)};
     }
 
 private:
-    [[nodiscard]] auto recursiveNodeConstrucion(const impl::BoundingBox& box,
-                                                const std::span<common::NodeID>& span) noexcept
-        -> std::unique_ptr<impl::QuadTreeNode>
+    auto recursiveNodeConstrucion(std::uint32_t index) noexcept
+        -> void
     {
-        if(span.size() < 2) {
-            return std::make_unique<impl::QuadTreeNode>(box, span);
+        const auto box = nodes_[index].getBoundingBox();
+        const auto elements = nodes_[index].getElements();
+
+        if(elements.size() < 2 or allAtTheSamePosition(elements)) {
+            return;
         }
 
+        // the spans of the nodes are const, but they point into elements_
+        // which is owned by the constructor
+        const auto begin = std::begin(elements_) + (elements.data() - elements_.data());
+        const std::span<common::NodeID> span{begin, elements.size()};
+
         const auto [tl_box, tr_box, bl_box, br_box] = box.split();
         const auto [tl_end, tr_end, bl_end] = partition(box, span);
 
-        std::span tl_span{std::begin(span), tl_end};
-        std::span tr_span{tl_end, tr_end};
-        std::span bl_span{tr_end, bl_end};
-        std::span br_span{bl_end, std::end(span)};
-
-        auto top_left = recursiveNodeConstrucion(tl_box, tl_span);
-        auto top_right = recursiveNodeConstrucion(tr_box, tr_span);
-        auto bottom_left = recursiveNodeConstrucion(bl_box, bl_span);
-        auto bottom_right = recursiveNodeConstrucion(br_box, br_span);
-
-        return std::make_unique<impl::QuadTreeNode>(box, span,
-                                                    std::move(top_left),
-                                                    std::move(top_right),
-                                                    std::move(bottom_left),
-                                                    std::move(bottom_right));
+        const std::span<const common::NodeID> tl_span{std::begin(span), tl_end};
+        const std::span<const common::NodeID> tr_span{tl_end, tr_end};
+        const std::span<const common::NodeID> bl_span{tr_end, bl_end};
+        const std::span<const common::NodeID> br_span{bl_end, std::end(span)};
+
+        // the four children are stored consecutively
+        const auto first_child = static_cast<std::uint32_t>(nodes_.size());
+        nodes_[index].setFirstChild(first_child);
+
+        nodes_.emplace_back(tl_box, tl_span);
+        nodes_.emplace_back(tr_box, tr_span);
+        nodes_.emplace_back(bl_box, bl_span);
+        nodes_.emplace_back(br_box, br_span);
+
+        for(std::uint32_t i = 0; i < 4; i++) {
+            recursiveNodeConstrucion(first_child + i);
+        }
     }
 
     [[nodiscard]] auto partition(const impl::BoundingBox& box,
@@ -79,14 +92,14 @@ private:
             });
 
         const auto tl_end = std::partition(
-            std::begin(span), std::end(tr_end),
+            std::begin(span), tr_end,
             [tl_box = tl_box, this](const auto& n) {
 				const auto[lat, lng] = getLatLng(n);
                 return tl_box.isInside(lat, lng);
             });
 
         const auto bl_end = std::partition(
-            std::begin(tr_end), std::end(span),
+            tr_end, std::end(span),
             [bl_box = bl_box, this](const auto& n) {
 				const auto[lat, lng] = getLatLng(n);
                 return bl_box.isInside(lat, lng);
@@ -95,16 +108,29 @@ private:
         return std::tuple{tl_end, tr_end, bl_end};
     }
 
+    [[nodiscard]] auto allAtTheSamePosition(std::span<const common::NodeID> span) const noexcept
+        -> bool
+    {
+        const auto first = getLatLng(span.front());
+        return std::all_of(std::begin(span),
+                           std::end(span),
+                           [&](const auto n) {
+                               return getLatLng(n) == first;
+                           });
+    }
+
     [[nodiscard]] auto getLatLng(common::NodeID n) const noexcept
         -> std::pair<double, double>
     {
         const auto lat = graph_.getNode(n)->getLat();
         const auto lng = graph_.getNode(n)->getLng();
-        return std::pair{lat, lng};
+        return std::pair{static_cast<double>(lat.get()),
+                         static_cast<double>(lng.get())};
     }
 
 private:
     const Graph& graph_;
-    std::vector<common::NodeID> nodes_;
+    std::vector<common::NodeID> elements_;
+    std::vector<impl::QuadTreeNode> nodes_;
 };
 } // namespace algorithms
@@ -3,33 +3,25 @@
 #include <algorithms/distoracle/patches/quadtree/BoundingBox.hpp>
 #include <array>
 #include <concepts/Nodes.hpp>
+#include <cstdint>
 #include <optional>
+#include <span>
 
 namespace algorithms::impl {
 
+/**
+ * a node of a flat quadtree, children are not owned by the node
+ * but referenced by their index inside the node vector of the tree.
+ * the four children of an inner node are always stored consecutively
+ * in the order top left, top right, bottom left, bottom right
+ */
 class QuadTreeNode
 {
 public:
     constexpr QuadTreeNode(BoundingBox box, std::span<const common::NodeID> elems) noexcept
         : box_(box),
           elements_(elems),
-          top_left_child_(nullptr),
-          top_right_child_(nullptr),
-          bottom_left_child_(nullptr),
-          bottom_right_child_(nullptr) {}
-
-    QuadTreeNode(BoundingBox box,
-                 std::span<const common::NodeID> elems,
-                 std::unique_ptr<QuadTreeNode> top_left_child,
-                 std::unique_ptr<QuadTreeNode> top_right_child,
-                 std::unique_ptr<QuadTreeNode> bottom_left_child,
-                 std::unique_ptr<QuadTreeNode> bottom_right_child) noexcept
-        : box_(box),
-          elements_(elems),
-          top_left_child_(std::move(top_left_child)),
-          top_right_child_(std::move(top_right_child)),
-          bottom_left_child_(std::move(bottom_left_child)),
-          bottom_right_child_(std::move(bottom_right_child)) {}
+          first_child_(NO_CHILDREN) {}
 
     [[nodiscard]] constexpr auto operator==(const QuadTreeNode& rhs) const noexcept
         -> bool
@@ -62,9 +54,6 @@ public:
         return center_dist - radius1 - radius2;
     }
 
-
-
-
     [[nodiscard]] constexpr auto empty() const noexcept
         -> bool
     {
@@ -83,62 +72,49 @@ public:
         return box_;
     }
 
-    [[nodiscard]] constexpr auto getTopLeftChild() const noexcept
-        -> const QuadTreeNode*
-    {
-        return top_left_child_.get();
-    }
-
-    [[nodiscard]] constexpr auto getTopRightChild() const noexcept
-        -> const QuadTreeNode*
-    {
-        return top_right_child_.get();
-    }
-
-    [[nodiscard]] constexpr auto getBottomLeftChild() const noexcept
-        -> const QuadTreeNode*
-    {
-        return bottom_left_child_.get();
-    }
-
-    [[nodiscard]] constexpr auto getBottomRightChild() const noexcept
-        -> const QuadTreeNode*
+    [[nodiscard]] constexpr auto isLeaf() const noexcept
+        -> bool
     {
-        return bottom_right_child_.get();
+        return first_child_ == NO_CHILDREN;
     }
 
-    constexpr auto setTopLeftChild(std::unique_ptr<QuadTreeNode>&& child) noexcept
-        -> void
+    /**
+     * @return the indices of the four children inside the node vector of the tree
+     * in the order top left, top right, bottom left, bottom right.
+     * must not be called on leafs
+     */
+    [[nodiscard]] constexpr auto getChildrenUnsafe() const noexcept
+        -> std::array<std::uint32_t, 4>
     {
-        top_left_child_ = std::move(child);
+        return std::array{first_child_,
+                          first_child_ + 1,
+                          first_child_ + 2,
+                          first_child_ + 3};
     }
 
-    constexpr auto setTopRightChild(std::unique_ptr<QuadTreeNode>&& child) noexcept
-        -> void
+    [[nodiscard]] constexpr auto getChildren() const noexcept
+        -> std::optional<std::array<std::uint32_t, 4>>
     {
-        top_right_child_ = std::move(child);
-    }
+        if(isLeaf()) {
+            return std::nullopt;
+        }
 
-    constexpr auto setBottomLeftChild(std::unique_ptr<QuadTreeNode>&& child) noexcept
-        -> void
-    {
-        bottom_left_child_ = std::move(child);
+        return getChildrenUnsafe();
     }
 
-    constexpr auto setBottomRightChild(std::unique_ptr<QuadTreeNode>&& child) noexcept
+    constexpr auto setFirstChild(std::uint32_t first_child) noexcept
         -> void
     {
-        bottom_right_child_ = std::move(child);
+        first_child_ = first_child;
     }
 
 private:
+    // the root has index 0 and is never a child of another node
+    constexpr static inline std::uint32_t NO_CHILDREN = 0;
+
     BoundingBox box_;
     std::span<const common::NodeID> elements_;
-
-    std::unique_ptr<const QuadTreeNode> top_left_child_;
-    std::unique_ptr<const QuadTreeNode> top_right_child_;
-    std::unique_ptr<const QuadTreeNode> bottom_left_child_;
-    std::unique_ptr<const QuadTreeNode> bottom_right_child_;
+    std::uint32_t first_child_;
 };
 
 } // namespace algorithms::impl
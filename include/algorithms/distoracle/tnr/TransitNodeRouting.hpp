@@ -0,0 +1,494 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/ch/UpwardArcs.hpp>
+#include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <common/Range.hpp>
+#include <concepts/BackwardConnections.hpp>
+#include <concepts/BackwardEdges.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <concepts/NodeLevels.hpp>
+#include <concepts/UpwardArcs.hpp>
+#include <execution>
+#include <limits>
+#include <span>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <utils/QueryStatistics.hpp>
+#include <utils/VersionedArray.hpp>
+#include <vector>
+
+namespace algorithms::distoracle {
+
+/**
+ * transit node routing on top of a contraction hierarchy. the nodes of the highest levels are
+ * transit nodes and the distances between all of them are stored in a dense table. the access
+ * nodes of a node are the transit nodes its upward search reaches without passing another
+ * transit node, a query combines the access nodes of the source and the target over the table.
+ * this is only correct if the shortest up down path passes a transit node, which is guaranteed
+ * if the parts of both upward searches below the transit nodes do not share a node. all other
+ * queries are local and answered by a CHDijkstra on the same graph.
+ * the locality filter stores nothing, it runs both upward searches pruned at the transit nodes
+ * at query time. these searches only cover the levels below the transit nodes and settle far
+ * fewer nodes than a CH query, such that only the table and the access nodes are kept in memory.
+ * the graph is either prepared by prepareGraphForCHDijkstra or a CHSearchGraph
+ */
+template<class Graph, class Statistics = util::NoStatistics>
+// clang-format off
+  requires (concepts::ForwardConnections<Graph>
+            && concepts::BackwardConnections<Graph>
+            && concepts::ReadableNodeLevels<Graph>
+            && concepts::HasEdges<Graph>
+            && concepts::HasBackwardEdges<Graph>
+            && concepts::HasNodes<Graph>
+            && concepts::HasTarget<typename Graph::EdgeType>)
+        || concepts::HasUpwardArcs<Graph>
+// clang-format on
+class TransitNodeRouting
+{
+    /**
+     * an access node refers to its transit node by the index in the distance table
+     */
+    struct AccessNode
+    {
+        std::size_t transit_idx_;
+        common::Weight distance_;
+    };
+
+    constexpr static inline std::size_t NO_TRANSIT_NODE = std::numeric_limits<std::size_t>::max();
+
+public:
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * selects whole levels from the top of the hierarchy as transit nodes as long as there are
+     * at most number_of_transit_nodes of them, the highest level is always selected
+     */
+    TransitNodeRouting(const Graph& graph, std::size_t number_of_transit_nodes) noexcept
+        : graph_(graph),
+          local_engine_(graph),
+          scratches_([number_of_nodes = graph.numberOfNodes()] {
+              return LocalityScratch{number_of_nodes};
+          })
+    {
+        static_assert(concepts::DistanceOracle<TransitNodeRouting>,
+                      "TransitNodeRouting should fullfill the DistanceOracle concept");
+
+        selectTransitNodes(number_of_transit_nodes);
+        computeAccessNodes();
+        computeTransitTable();
+        pruneDominatedAccessNodes();
+    }
+
+    TransitNodeRouting(TransitNodeRouting&&) noexcept = default;
+    TransitNodeRouting(const TransitNodeRouting&) noexcept = delete;
+
+    auto operator=(TransitNodeRouting&&) noexcept
+        -> TransitNodeRouting& = delete;
+
+    auto operator=(const TransitNodeRouting&) noexcept
+        -> TransitNodeRouting& = delete;
+
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        auto& statistics = statistics_.local();
+        const util::QueryScope scope{statistics};
+
+        if(isLocal(source, target, statistics)) {
+            statistics.count(util::QueryCounter::ORACLE_QUERIES);
+            return local_engine_.distanceBetween(source, target);
+        }
+
+        const auto forward_access = forwardAccessNodesOf(source);
+        const auto backward_access = backwardAccessNodesOf(target);
+        statistics.count(util::QueryCounter::SCANNED_LABEL_ENTRIES,
+                         forward_access.size() * backward_access.size());
+
+        auto best_dist = common::INFINITY_WEIGHT;
+        for(const auto [forward_idx, forward_dist] : forward_access) {
+            const auto* row = &table_[forward_idx * transit_nodes_.size()];
+
+            for(const auto [backward_idx, backward_dist] : backward_access) {
+                const auto transit_dist = row[backward_idx];
+                if(transit_dist == common::INFINITY_WEIGHT) {
+                    continue;
+                }
+
+                best_dist = std::min(best_dist, forward_dist + transit_dist + backward_dist);
+            }
+        }
+
+        return best_dist;
+    }
+
+    /**
+     * @returns true if the query is answered by the ch fallback instead of the transit table
+     */
+    [[nodiscard]] auto isLocal(common::NodeID source, common::NodeID target) const noexcept
+        -> bool
+    {
+        util::NoStatistics statistics;
+        return isLocal(source, target, statistics);
+    }
+
+    [[nodiscard]] auto getTransitNodes() const noexcept
+        -> std::span<const common::NodeID>
+    {
+        return transit_nodes_;
+    }
+
+    [[nodiscard]] auto numberOfTransitNodes() const noexcept
+        -> std::size_t
+    {
+        return transit_nodes_.size();
+    }
+
+    /**
+     * @returns the number of access nodes of all nodes in both directions
+     */
+    [[nodiscard]] auto numberOfAccessNodes() const noexcept
+        -> std::size_t
+    {
+        return forward_access_.size() + backward_access_.size();
+    }
+
+    /**
+     * @returns the bytes of the transit table and the access nodes
+     */
+    [[nodiscard]] auto memoryUsage() const noexcept
+        -> std::size_t
+    {
+        const auto number_of_offsets = forward_access_offset_.size()
+            + backward_access_offset_.size();
+
+        return table_.size() * sizeof(common::Weight)
+            + transit_nodes_.size() * sizeof(common::NodeID)
+            + transit_idx_of_.size() * sizeof(std::size_t)
+            + numberOfAccessNodes() * sizeof(AccessNode)
+            + number_of_offsets * sizeof(std::size_t);
+    }
+
+    /**
+     * @returns the merged statistics of all threads which queried the engine
+     */
+    [[nodiscard]] auto statistics() const noexcept
+        -> Statistics
+    {
+        return statistics_.combine();
+    }
+
+    /**
+     * @returns the statistics of the calling thread, including the counters of its last query
+     */
+    [[nodiscard]] auto localStatistics() const noexcept
+        -> const Statistics&
+    {
+        return statistics_.local();
+    }
+
+    auto clearStatistics() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
+private:
+    /**
+     * scratch arrays of a pruned upward search
+     */
+    struct SearchScratch
+    {
+        explicit SearchScratch(std::size_t number_of_nodes) noexcept
+            : distances_(number_of_nodes, common::INFINITY_WEIGHT) {}
+
+        util::VersionedArray<common::Weight> distances_;
+        std::vector<AccessNode> access_;
+        std::vector<common::NodeID> local_;
+    };
+
+    /**
+     * the scratch arrays of both searches of the locality filter of one thread
+     */
+    struct LocalityScratch
+    {
+        explicit LocalityScratch(std::size_t number_of_nodes) noexcept
+            : forward_(number_of_nodes),
+              backward_(number_of_nodes) {}
+
+        SearchScratch forward_;
+        SearchScratch backward_;
+    };
+
+    [[nodiscard]] auto forwardAccessNodesOf(common::NodeID node) const noexcept
+        -> std::span<const AccessNode>
+    {
+        const auto first = forward_access_offset_[node.get()];
+        const auto last = forward_access_offset_[node.get() + 1];
+        return std::span{forward_access_}.subspan(first, last - first);
+    }
+
+    [[nodiscard]] auto backwardAccessNodesOf(common::NodeID node) const noexcept
+        -> std::span<const AccessNode>
+    {
+        const auto first = backward_access_offset_[node.get()];
+        const auto last = backward_access_offset_[node.get() + 1];
+        return std::span{backward_access_}.subspan(first, last - first);
+    }
+
+    /**
+     * a query is local if the parts of the upward searches below the transit nodes share a node.
+     * every node of the backward search below the transit nodes is checked against the settled
+     * nodes of the forward search
+     */
+    template<class QueryStatistics>
+    [[nodiscard]] auto isLocal(common::NodeID source,
+                               common::NodeID target,
+                               QueryStatistics& statistics) const noexcept
+        -> bool
+    {
+        auto& [forward, backward] = scratches_.local();
+
+        prunedUpwardSearch(forward, source, statistics, [&](const auto current) {
+            return forwardArcsOf(graph_, current);
+        });
+        prunedUpwardSearch(backward, target, statistics, [&](const auto current) {
+            return backwardArcsOf(graph_, current);
+        });
+
+        return std::any_of(std::begin(backward.local_),
+                           std::end(backward.local_),
+                           [&](const auto node) {
+                               return forward.distances_.isSettled(node.get());
+                           });
+    }
+
+    auto selectTransitNodes(std::size_t number_of_transit_nodes) noexcept
+        -> void
+    {
+        const auto number_of_nodes = graph_.numberOfNodes();
+        if(number_of_nodes == 0) {
+            return;
+        }
+
+        std::vector<common::NodeLevel> levels;
+        levels.reserve(number_of_nodes);
+        for(std::size_t n = 0; n < number_of_nodes; n++) {
+            levels.emplace_back(graph_.getNodeLevelUnsafe(common::NodeID{n}));
+        }
+        std::sort(std::begin(levels), std::end(levels), std::greater<>{});
+
+        // whole levels are selected, such that every node above a transit node is a transit node
+        const auto kth = std::clamp(number_of_transit_nodes, std::size_t{1}, number_of_nodes) - 1;
+        const auto kth_level = levels[kth];
+        const auto higher = std::lower_bound(std::begin(levels), std::end(levels), kth_level, std::greater<>{});
+        const auto same_or_higher = std::upper_bound(std::begin(levels), std::end(levels), kth_level, std::greater<>{});
+        const auto fits = static_cast<std::size_t>(std::distance(std::begin(levels), same_or_higher)) <= number_of_transit_nodes;
+
+        // the level of the kth node is only taken completely if it fits or if it is the highest level
+        const auto min_level = fits or higher == std::begin(levels)
+            ? kth_level
+            : *std::prev(higher);
+
+        transit_idx_of_.resize(number_of_nodes, NO_TRANSIT_NODE);
+        for(std::size_t n = 0; n < number_of_nodes; n++) {
+            if(graph_.getNodeLevelUnsafe(common::NodeID{n}) >= min_level) {
+                transit_idx_of_[n] = transit_nodes_.size();
+                transit_nodes_.emplace_back(n);
+            }
+        }
+    }
+
+    /**
+     * runs the upward searches of all nodes in parallel, transit nodes are recorded as access
+     * nodes but not expanded. the stalling of the queries is not used, because the locality
+     * filter runs the same searches and needs every node which is reachable below the transit nodes
+     */
+    auto computeAccessNodes() noexcept
+        -> void
+    {
+        const auto number_of_nodes = graph_.numberOfNodes();
+
+        std::vector<std::vector<AccessNode>> forward_access(number_of_nodes);
+        std::vector<std::vector<AccessNode>> backward_access(number_of_nodes);
+
+        tbb::enumerable_thread_specific<SearchScratch> scratches{number_of_nodes};
+
+        const auto range = common::range(number_of_nodes);
+        std::for_each(std::execution::par,
+                      std::begin(range),
+                      std::end(range),
+                      [&](const auto n) {
+                          auto& scratch = scratches.local();
+                          const common::NodeID node{n};
+                          util::NoStatistics statistics;
+
+                          prunedUpwardSearch(scratch, node, statistics, [&](const auto current) {
+                              return forwardArcsOf(graph_, current);
+                          });
+                          forward_access[n] = scratch.access_;
+
+                          prunedUpwardSearch(scratch, node, statistics, [&](const auto current) {
+                              return backwardArcsOf(graph_, current);
+                          });
+                          backward_access[n] = scratch.access_;
+                      });
+
+        flatten(std::move(forward_access), forward_access_offset_, forward_access_);
+        flatten(std::move(backward_access), backward_access_offset_, backward_access_);
+    }
+
+    template<class QueryStatistics, class ArcsOf>
+    auto prunedUpwardSearch(SearchScratch& scratch,
+                            common::NodeID source,
+                            QueryStatistics& statistics,
+                            ArcsOf&& arcs_of) const noexcept
+        -> void
+    {
+        auto& distances = scratch.distances_;
+        distances.clear();
+        scratch.access_.clear();
+        scratch.local_.clear();
+
+        pathfinding::DijkstraQueue heap;
+        heap.emplace(source, 0);
+        distances.set(source.get(), common::Weight{0});
+
+        while(!heap.empty()) {
+            const auto [current_node, cost_to_current] = heap.top();
+            heap.pop();
+
+            if(distances.isSettled(current_node.get())) {
+                continue;
+            }
+
+            distances.settle(current_node.get());
+            statistics.count(util::QueryCounter::SETTLED_NODES);
+
+            const auto transit_idx = transit_idx_of_[current_node.get()];
+            if(transit_idx != NO_TRANSIT_NODE) {
+                scratch.access_.push_back(AccessNode{transit_idx, cost_to_current});
+                continue;
+            }
+
+            scratch.local_.emplace_back(current_node);
+
+            for(const auto arc : arcs_of(current_node)) {
+                const auto neig = arc.getTrg();
+                const auto new_dist = arc.getWeight() + cost_to_current;
+
+                if(new_dist < distances[neig.get()]) {
+                    heap.emplace(neig, new_dist);
+                    distances.set(neig.get(), new_dist);
+                }
+            }
+        }
+    }
+
+    auto computeTransitTable() noexcept
+        -> void
+    {
+        table_.resize(transit_nodes_.size() * transit_nodes_.size(), common::INFINITY_WEIGHT);
+        [[maybe_unused]] const auto valid = local_engine_.distanceTable(transit_nodes_, transit_nodes_, table_);
+    }
+
+    /**
+     * an access node is dropped if another access node of the same node
+     * reaches it cheaper over the transit table
+     */
+    auto pruneDominatedAccessNodes() noexcept
+        -> void
+    {
+        const auto transit_dist = [&](const auto from, const auto to) {
+            return table_[from * transit_nodes_.size() + to];
+        };
+
+        pruneDominated(forward_access_offset_, forward_access_, [&](const auto& other, const auto& access) {
+            const auto dist = transit_dist(other.transit_idx_, access.transit_idx_);
+            return dist != common::INFINITY_WEIGHT
+                and other.distance_ + dist < access.distance_;
+        });
+
+        pruneDominated(backward_access_offset_, backward_access_, [&](const auto& other, const auto& access) {
+            const auto dist = transit_dist(access.transit_idx_, other.transit_idx_);
+            return dist != common::INFINITY_WEIGHT
+                and other.distance_ + dist < access.distance_;
+        });
+    }
+
+    template<class Dominates>
+    static auto pruneDominated(std::vector<std::size_t>& offset,
+                               std::vector<AccessNode>& access_nodes,
+                               Dominates&& dominates) noexcept
+        -> void
+    {
+        std::vector<AccessNode> kept;
+        kept.reserve(access_nodes.size());
+
+        auto first = offset[0];
+        for(std::size_t n = 0; n + 1 < offset.size(); n++) {
+            const auto last = offset[n + 1];
+            const auto nodes = std::span{access_nodes}.subspan(first, last - first);
+
+            for(const auto& access : nodes) {
+                const auto is_dominated = std::any_of(std::begin(nodes),
+                                                      std::end(nodes),
+                                                      [&](const auto& other) {
+                                                          return dominates(other, access);
+                                                      });
+                if(!is_dominated) {
+                    kept.push_back(access);
+                }
+            }
+
+            first = last;
+            offset[n + 1] = kept.size();
+        }
+
+        kept.shrink_to_fit();
+        access_nodes = std::move(kept);
+    }
+
+    template<class T>
+    static auto flatten(std::vector<std::vector<T>> lists,
+                        std::vector<std::size_t>& offset,
+                        std::vector<T>& flat) noexcept
+        -> void
+    {
+        offset.resize(lists.size() + 1, 0);
+        for(std::size_t n = 0; n < lists.size(); n++) {
+            offset[n + 1] = offset[n] + lists[n].size();
+        }
+
+        flat.reserve(offset.back());
+        for(auto& list : lists) {
+            flat.insert(std::end(flat), std::begin(list), std::end(list));
+            list = {};
+        }
+    }
+
+private:
+    const Graph& graph_;
+    CHDijkstra<Graph> local_engine_;
+
+    std::vector<common::NodeID> transit_nodes_;
+    std::vector<std::size_t> transit_idx_of_;
+
+    // row major distances between all transit nodes
+    std::vector<common::Weight> table_;
+
+    std::vector<std::size_t> forward_access_offset_;
+    std::vector<AccessNode> forward_access_;
+    std::vector<std::size_t> backward_access_offset_;
+    std::vector<AccessNode> backward_access_;
+
+    mutable tbb::enumerable_thread_specific<LocalityScratch> scratches_;
+
+    [[no_unique_address]] util::ThreadLocalStatistics<Statistics> statistics_;
+};
+
+} // namespace algorithms::distoracle
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <concepts/PathOracle.hpp>
+#include <concepts/Potential.hpp>
+#include <graphs/Path.hpp>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <utils/VersionedArray.hpp>
+
+namespace algorithms::pathfinding {
+
+/**
+ * goal directed dijkstra, the queue is ordered by the distance from the source plus
+ * the potential of the node which has to be a lower bound of the distance to the target.
+ * nodes are reopened if a shorter distance is found later on, therefore the search stays
+ * exact for potentials which are only admissible but not consistent
+ */
+template<class Graph, class Potential>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasTarget<typename Graph::EdgeType>
+      && concepts::Potential<Potential>
+// clang-format on
+class AStar
+{
+public:
+    constexpr static inline bool is_threadsafe = false;
+
+    AStar(const Graph& graph, const Potential& potential) noexcept
+        : graph_(graph),
+          potential_(potential),
+          distances_(graph.numberOfNodes(), common::INFINITY_WEIGHT),
+          potentials_(graph.numberOfNodes(), common::INFINITY_WEIGHT),
+          pq_(DijkstraQueueComparer{}),
+          before_(graph.numberOfNodes(), common::UNKNOWN_NODE_ID)
+    {
+        static_assert(concepts::PathOracle<AStar>,
+                      "AStar should fullfill the PathOracle concept");
+
+        static_assert(concepts::DistanceOracle<AStar>,
+                      "AStar should fullfill the DistanceOracle concept");
+    }
+
+    // the potential is only referenced, landmark potentials are too large to be copied
+    // into every engine, therefore it must outlive the engine and can not be a temporary
+    AStar(const Graph& graph, Potential&& potential) = delete;
+
+    AStar() = delete;
+    AStar(AStar&&) noexcept = default;
+    AStar(const AStar&) noexcept = default;
+    auto operator=(const AStar&) -> AStar& = delete;
+    auto operator=(AStar&&) noexcept -> AStar& = delete;
+
+    auto pathBetween(common::NodeID source, common::NodeID target) noexcept
+        -> std::optional<graphs::Path>
+    {
+        const auto cost = distanceBetween(source, target);
+        if(cost == common::INFINITY_WEIGHT) {
+            return std::nullopt;
+        }
+
+        std::vector nodes{target};
+        while(nodes.back() != source) {
+            nodes.emplace_back(before_[nodes.back().get()]);
+        }
+        std::reverse(std::begin(nodes), std::end(nodes));
+
+        return graphs::Path(std::move(nodes),
+                            cost);
+    }
+
+    auto distanceBetween(common::NodeID source, common::NodeID target) noexcept
+        -> common::Weight
+    {
+        const auto potential = potential_.forTarget(target);
+        resetFor(source, potential);
+
+        while(!pq_.empty()) {
+            const auto [current_node, current_key] = pq_.top();
+            pq_.pop();
+
+            const auto current_dist = distances_[current_node.get()];
+
+            // skip outdated queue entries
+            if(current_key != current_dist + potentials_[current_node.get()]) {
+                continue;
+            }
+
+            if(current_node == target) {
+                return current_dist;
+            }
+
+            const auto edge_ids = graph_.getForwardEdgeIDsOf(current_node);
+            for(const auto id : edge_ids) {
+                const auto* edge = graph_.getEdge(id);
+                const auto neig = edge->getTrg();
+
+                //use the edge weight if available otherwise every edge has a weight 1
+                const auto distance = [&]() constexpr
+                {
+                    if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+                        return edge->getWeight();
+                    } else {
+                        return common::Weight{1};
+                    }
+                }
+                ();
+
+                const auto new_dist = current_dist + distance;
+                if(distances_[neig.get()] > new_dist) {
+                    if(!distances_.isSet(neig.get())) {
+                        potentials_[neig.get()] = potential(neig);
+                    }
+
+                    distances_.set(neig.get(), new_dist);
+                    before_[neig.get()] = current_node;
+                    pq_.emplace(neig, new_dist + potentials_[neig.get()]);
+                }
+            }
+        }
+
+        return common::INFINITY_WEIGHT;
+    }
+
+private:
+    template<class TargetPotential>
+    constexpr auto resetFor(common::NodeID source,
+                            const TargetPotential& potential) noexcept
+        -> void
+    {
+        distances_.clear();
+        pq_ = DijkstraQueue{DijkstraQueueComparer{}};
+
+        const auto source_potential = potential(source);
+        distances_.set(source.get(), common::Weight{0});
+        potentials_[source.get()] = source_potential;
+        pq_.emplace(source, source_potential);
+    }
+
+private:
+    const Graph& graph_;
+    const Potential& potential_;
+    util::VersionedArray<common::Weight> distances_;
+    // potentials_ and before_ are only read for nodes reached in the current query,
+    // so they are never reset
+    std::vector<common::Weight> potentials_;
+    DijkstraQueue pq_;
+    std::vector<common::NodeID> before_;
+};
+
+} // namespace algorithms::pathfinding
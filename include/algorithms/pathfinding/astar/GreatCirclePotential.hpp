@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/Nodes.hpp>
+#include <concepts/Potential.hpp>
+#include <cstdint>
+#include <numbers>
+
+namespace algorithms::pathfinding {
+
+/**
+ * geographic lower bound for A*, the great circle distance to the target
+ * multiplied by the smallest weight a single meter can have in the graph
+ */
+template<class Graph>
+// clang-format off
+requires concepts::HasNontrivialNodes<Graph>
+      && concepts::HasLatLng<typename Graph::NodeType>
+// clang-format on
+class GreatCirclePotential
+{
+public:
+    constexpr static inline double EARTH_RADIUS_IN_METERS = 6371000.0;
+
+    /**
+     * for distance weighted graphs weight_per_meter is the weight of one meter,
+     * for travel time weighted graphs use travelTimeWeightPerMeter to derive it
+     * from the maximal speed
+     */
+    GreatCirclePotential(const Graph& graph, double weight_per_meter) noexcept
+        : graph_(graph),
+          weight_per_meter_(weight_per_meter)
+    {
+        static_assert(concepts::Potential<GreatCirclePotential>,
+                      "GreatCirclePotential should fullfill the Potential concept");
+    }
+
+    /**
+     * @returns the weight a single meter has at the given max speed in km/h,
+     * if one unit of time in the graph is 1/weight_per_second of a second
+     */
+    [[nodiscard]] constexpr static auto travelTimeWeightPerMeter(common::Speed max_speed,
+                                                                 double weight_per_second) noexcept
+        -> double
+    {
+        const auto meters_per_second = static_cast<double>(max_speed.get()) / 3.6;
+        return weight_per_second / meters_per_second;
+    }
+
+    [[nodiscard]] auto forTarget(common::NodeID target) const noexcept
+    {
+        const auto target_node = graph_.getNode(target);
+        const auto target_lat = toRadians(target_node->getLat().get());
+        const auto target_lng = toRadians(target_node->getLng().get());
+        const auto factor = EARTH_RADIUS_IN_METERS * weight_per_meter_;
+
+        return [this, target_lat, target_lng, factor](common::NodeID node) noexcept {
+            const auto n = graph_.getNode(node);
+            const auto lat = toRadians(n->getLat().get());
+            const auto lng = toRadians(n->getLng().get());
+
+            // haversine formula
+            const auto sin_lat = std::sin((target_lat - lat) / 2);
+            const auto sin_lng = std::sin((target_lng - lng) / 2);
+            const auto a = sin_lat * sin_lat
+                + std::cos(lat) * std::cos(target_lat) * sin_lng * sin_lng;
+            const auto angle = 2 * std::asin(std::sqrt(std::min(a, 1.0)));
+
+            // round down to stay a lower bound
+            return common::Weight{static_cast<std::int_fast64_t>(angle * factor)};
+        };
+    }
+
+private:
+    [[nodiscard]] constexpr static auto toRadians(double degree) noexcept
+        -> double
+    {
+        return degree * std::numbers::pi / 180.0;
+    }
+
+private:
+    const Graph& graph_;
+    double weight_per_meter_;
+};
+
+} // namespace algorithms::pathfinding
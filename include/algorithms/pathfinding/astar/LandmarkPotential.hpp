@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <common/Range.hpp>
+#include <concepts/BackwardConnections.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <concepts/Potential.hpp>
+#include <execution>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace algorithms::pathfinding {
+
+enum class LandmarkSelection {
+    // every landmark is the node farthest away from all landmarks chosen before
+    FARTHEST,
+    // every landmark is a leaf of the part of a shortest path tree
+    // which is covered worst by the landmarks chosen before
+    AVOID
+};
+
+/**
+ * ALT lower bound for A*, uses the triangle inequality with precomputed distances
+ * from and to a small set of landmarks. the distances are stored node major,
+ * such that all landmark distances of one node share a cache line
+ */
+template<class Graph>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::BackwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasSource<typename Graph::EdgeType>
+      && concepts::HasTarget<typename Graph::EdgeType>
+// clang-format on
+class LandmarkPotential
+{
+public:
+    LandmarkPotential(const Graph& graph,
+                      std::size_t number_of_landmarks,
+                      LandmarkSelection selection = LandmarkSelection::AVOID,
+                      std::uint_fast64_t seed = 0) noexcept
+        : graph_(graph),
+          random_engine_(seed)
+    {
+        static_assert(concepts::Potential<LandmarkPotential>,
+                      "LandmarkPotential should fullfill the Potential concept");
+
+        number_of_landmarks = std::min(number_of_landmarks, graph.numberOfNodes());
+
+        for(std::size_t i = 0; i < number_of_landmarks; i++) {
+            const auto landmark = [&] {
+                if(selection == LandmarkSelection::AVOID and !landmarks_.empty()) {
+                    return selectAvoidLandmark();
+                }
+                return selectFarthestLandmark();
+            }();
+
+            if(!landmark) {
+                break;
+            }
+
+            addLandmark(landmark.value());
+        }
+
+        storeNodeMajor();
+    }
+
+    [[nodiscard]] auto getLandmarks() const noexcept
+        -> std::span<const common::NodeID>
+    {
+        return landmarks_;
+    }
+
+    [[nodiscard]] auto forTarget(common::NodeID target) const noexcept
+    {
+        const auto k = landmarks_.size();
+        const auto* from_target_row = &from_landmarks_[target.get() * k];
+        const auto* to_target_row = &to_landmarks_[target.get() * k];
+
+        return [this, k, from_target_row, to_target_row](common::NodeID node) noexcept {
+            const auto* from_node_row = &from_landmarks_[node.get() * k];
+            const auto* to_node_row = &to_landmarks_[node.get() * k];
+
+            common::Weight bound{0};
+            for(std::size_t i = 0; i < k; i++) {
+                bound = std::max(bound, lowerBound(from_node_row[i], from_target_row[i],
+                                                   to_node_row[i], to_target_row[i]));
+            }
+            return bound;
+        };
+    }
+
+private:
+    struct ShortestPathTree
+    {
+        std::vector<common::Weight> distances;
+        std::vector<common::NodeID> parents;
+        std::vector<common::NodeID> settle_order;
+    };
+
+    // lower bound of d(v, t) given d(L, v), d(L, t), d(v, L) and d(t, L)
+    [[nodiscard]] constexpr static auto lowerBound(common::Weight from_landmark_to_node,
+                                                   common::Weight from_landmark_to_target,
+                                                   common::Weight from_node_to_landmark,
+                                                   common::Weight from_target_to_landmark) noexcept
+        -> common::Weight
+    {
+        common::Weight bound{0};
+
+        // d(L, t) <= d(L, v) + d(v, t)
+        if(from_landmark_to_node != common::INFINITY_WEIGHT
+           and from_landmark_to_target != common::INFINITY_WEIGHT) {
+            bound = std::max(bound, from_landmark_to_target - from_landmark_to_node);
+        }
+
+        // d(v, L) <= d(v, t) + d(t, L)
+        if(from_node_to_landmark != common::INFINITY_WEIGHT
+           and from_target_to_landmark != common::INFINITY_WEIGHT) {
+            bound = std::max(bound, from_node_to_landmark - from_target_to_landmark);
+        }
+
+        return bound;
+    }
+
+    // lower bound of d(source, node) using all landmarks selected so far
+    [[nodiscard]] auto lowerBoundDuringSelection(common::NodeID source,
+                                                 common::NodeID node) const noexcept
+        -> common::Weight
+    {
+        common::Weight bound{0};
+        for(std::size_t i = 0; i < landmarks_.size(); i++) {
+            const auto& from = from_landmark_trees_[i];
+            const auto& to = to_landmark_trees_[i];
+            bound = std::max(bound, lowerBound(from[source.get()], from[node.get()],
+                                               to[source.get()], to[node.get()]));
+        }
+        return bound;
+    }
+
+    auto addLandmark(common::NodeID landmark) noexcept
+        -> void
+    {
+        landmarks_.emplace_back(landmark);
+
+        std::vector<common::Weight> from_landmark;
+        std::vector<common::Weight> to_landmark;
+
+        const std::array directions{true, false};
+        std::for_each(std::execution::par,
+                      std::begin(directions),
+                      std::end(directions),
+                      [&](const auto forward) {
+                          if(forward) {
+                              from_landmark = shortestPathTreeOf<true>(landmark).distances;
+                          } else {
+                              to_landmark = shortestPathTreeOf<false>(landmark).distances;
+                          }
+                      });
+
+        from_landmark_trees_.emplace_back(std::move(from_landmark));
+        to_landmark_trees_.emplace_back(std::move(to_landmark));
+    }
+
+    [[nodiscard]] auto selectFarthestLandmark() noexcept
+        -> std::optional<common::NodeID>
+    {
+        // the first landmark is the node farthest away from a random node
+        if(landmarks_.empty()) {
+            const auto tree = shortestPathTreeOf<true>(randomNode());
+            return tree.settle_order.back();
+        }
+
+        // otherwise maximize the minimal distance to all landmarks,
+        // nodes unreachable from every landmark are taken first
+        // if all nodes are landmarks already nullopt is returned
+        std::optional<common::NodeID> best;
+        auto best_dist = common::Weight{-1};
+        for(std::size_t n = 0; n < graph_.numberOfNodes(); n++) {
+            const auto node = common::NodeID{n};
+            if(std::find(std::begin(landmarks_), std::end(landmarks_), node) != std::end(landmarks_)) {
+                continue;
+            }
+
+            auto min_dist = common::INFINITY_WEIGHT;
+            for(std::size_t i = 0; i < landmarks_.size(); i++) {
+                min_dist = std::min(min_dist, from_landmark_trees_[i][n]);
+            }
+
+            if(min_dist > best_dist) {
+                best_dist = min_dist;
+                best = node;
+            }
+        }
+
+        return best;
+    }
+
+    [[nodiscard]] auto selectAvoidLandmark() noexcept
+        -> std::optional<common::NodeID>
+    {
+        const auto root = randomNode();
+        const auto tree = shortestPathTreeOf<true>(root);
+        const auto number_of_nodes = graph_.numberOfNodes();
+
+        std::vector<bool> is_landmark(number_of_nodes, false);
+        for(const auto landmark : landmarks_) {
+            is_landmark[landmark.get()] = true;
+        }
+
+        // the weight of a node is the gap between its distance and its lower bound,
+        // the size of a node is the weight of its subtree or zero if the subtree
+        // already contains a landmark
+        std::vector<common::Weight> sizes(number_of_nodes, common::Weight{0});
+        std::vector<bool> contains_landmark = std::move(is_landmark);
+
+        for(const auto node : tree.settle_order) {
+            sizes[node.get()] = tree.distances[node.get()] - lowerBoundDuringSelection(root, node);
+        }
+
+        for(auto iter = std::rbegin(tree.settle_order); iter != std::rend(tree.settle_order); ++iter) {
+            const auto node = *iter;
+            const auto parent = tree.parents[node.get()];
+
+            if(contains_landmark[node.get()]) {
+                sizes[node.get()] = common::Weight{0};
+            }
+
+            if(parent == common::UNKNOWN_NODE_ID) {
+                continue;
+            }
+
+            if(contains_landmark[node.get()]) {
+                contains_landmark[parent.get()] = true;
+            } else {
+                sizes[parent.get()] += sizes[node.get()];
+            }
+        }
+
+        const auto max_iter = std::max_element(std::begin(tree.settle_order),
+                                               std::end(tree.settle_order),
+                                               [&](const auto lhs, const auto rhs) {
+                                                   return sizes[lhs.get()] < sizes[rhs.get()];
+                                               });
+
+        if(sizes[max_iter->get()] <= common::Weight{0}) {
+            return selectFarthestLandmark();
+        }
+
+        // build the children lists of the tree to walk down to a leaf
+        std::vector<std::size_t> offsets(number_of_nodes + 1, 0);
+        for(const auto node : tree.settle_order) {
+            const auto parent = tree.parents[node.get()];
+            if(parent != common::UNKNOWN_NODE_ID) {
+                offsets[parent.get() + 1]++;
+            }
+        }
+        std::inclusive_scan(std::begin(offsets), std::end(offsets), std::begin(offsets));
+
+        std::vector<common::NodeID> children(offsets.back());
+        auto positions = offsets;
+        for(const auto node : tree.settle_order) {
+            const auto parent = tree.parents[node.get()];
+            if(parent != common::UNKNOWN_NODE_ID) {
+                children[positions[parent.get()]++] = node;
+            }
+        }
+
+        // follow the child with the largest size until a leaf is reached
+        auto current = *max_iter;
+        while(true) {
+            const auto begin = std::begin(children) + offsets[current.get()];
+            const auto end = std::begin(children) + offsets[current.get() + 1];
+            const auto next = std::max_element(begin, end,
+                                               [&](const auto lhs, const auto rhs) {
+                                                   return sizes[lhs.get()] < sizes[rhs.get()];
+                                               });
+
+            if(next == end or sizes[next->get()] <= common::Weight{0}) {
+                return current;
+            }
+
+            current = *next;
+        }
+    }
+
+    template<bool Forward>
+    [[nodiscard]] auto shortestPathTreeOf(common::NodeID source) const noexcept
+        -> ShortestPathTree
+    {
+        const auto number_of_nodes = graph_.numberOfNodes();
+        ShortestPathTree tree{
+            std::vector(number_of_nodes, common::INFINITY_WEIGHT),
+            std::vector(number_of_nodes, common::UNKNOWN_NODE_ID),
+            {}};
+
+        DijkstraQueue pq{DijkstraQueueComparer{}};
+        tree.distances[source.get()] = common::Weight{0};
+        pq.emplace(source, common::Weight{0});
+
+        while(!pq.empty()) {
+            const auto [current_node, current_dist] = pq.top();
+            pq.pop();
+
+            if(current_dist > tree.distances[current_node.get()]) {
+                continue;
+            }
+
+            tree.settle_order.emplace_back(current_node);
+
+            const auto edge_ids = [&] {
+                if constexpr(Forward) {
+                    return graph_.getForwardEdgeIDsOf(current_node);
+                } else {
+                    return graph_.getBackwardEdgeIDsOf(current_node);
+                }
+            }();
+
+            for(const auto id : edge_ids) {
+                const auto edge = [&] {
+                    if constexpr(Forward) {
+                        return graph_.getEdge(id);
+                    } else {
+                        return graph_.getBackwardEdge(id);
+                    }
+                }();
+
+                const auto neig = edge->getTrg();
+                const auto distance = [&]() constexpr
+                {
+                    if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+                        return edge->getWeight();
+                    } else {
+                        return common::Weight{1};
+                    }
+                }
+                ();
+
+                const auto new_dist = current_dist + distance;
+                if(tree.distances[neig.get()] > new_dist) {
+                    tree.distances[neig.get()] = new_dist;
+                    tree.parents[neig.get()] = current_node;
+                    pq.emplace(neig, new_dist);
+                }
+            }
+        }
+
+        return tree;
+    }
+
+    auto storeNodeMajor() noexcept
+        -> void
+    {
+        const auto k = landmarks_.size();
+        const auto number_of_nodes = graph_.numberOfNodes();
+
+        from_landmarks_.resize(number_of_nodes * k);
+        to_landmarks_.resize(number_of_nodes * k);
+
+        const auto range = common::range(number_of_nodes);
+        std::for_each(std::execution::par,
+                      std::begin(range),
+                      std::end(range),
+                      [&](const auto n) {
+                          for(std::size_t i = 0; i < k; i++) {
+                              from_landmarks_[n * k + i] = from_landmark_trees_[i][n];
+                              to_landmarks_[n * k + i] = to_landmark_trees_[i][n];
+                          }
+                      });
+
+        // the landmark major vectors are only needed during the selection
+        from_landmark_trees_.clear();
+        from_landmark_trees_.shrink_to_fit();
+        to_landmark_trees_.clear();
+        to_landmark_trees_.shrink_to_fit();
+    }
+
+    [[nodiscard]] auto randomNode() noexcept
+        -> common::NodeID
+    {
+        std::uniform_int_distribution<std::size_t> distribution{0, graph_.numberOfNodes() - 1};
+        return common::NodeID{distribution(random_engine_)};
+    }
+
+private:
+    const Graph& graph_;
+    std::mt19937_64 random_engine_;
+    std::vector<common::NodeID> landmarks_;
+
+    // d(L, v) and d(v, L) stored as [v * k + i] for the i-th landmark
+    std::vector<common::Weight> from_landmarks_;
+    std::vector<common::Weight> to_landmarks_;
+
+    // landmark major distances, only used during the selection
+    std::vector<std::vector<common::Weight>> from_landmark_trees_;
+    std::vector<std::vector<common::Weight>> to_landmark_trees_;
+};
+
+} // namespace algorithms::pathfinding
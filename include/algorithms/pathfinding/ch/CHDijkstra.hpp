@@ -13,7 +13,11 @@
 #include <concepts/NodeLevels.hpp>
 #include <concepts/PathOracle.hpp>
 #include <fmt/core.h>
+#include <graphs/EdgePath.hpp>
+#include <graphs/offsetarray/ShortcutUnpacking.hpp>
 #include <queue>
+#include <span>
+#include <tbb/enumerable_thread_specific.h>
 #include <type_traits>
 #include <utility>
 
@@ -30,27 +34,42 @@ template<class Graph, bool UseStallOnDemand = true>
   && concepts::HasTarget<typename Graph::EdgeType>
   && concepts::CanUnwrapShortcuts<Graph>
 // clang-format on
-class CHDijkstra : public CHDijkstraForwardHelper<
-                       CHDijkstra<Graph, UseStallOnDemand>,
-                       UseStallOnDemand>,
-                   public CHDijkstraBackwardHelper<
-                       CHDijkstra<Graph, UseStallOnDemand>,
-                       UseStallOnDemand>
+class CHDijkstra
 {
     using ForwardHelper = CHDijkstraForwardHelper<CHDijkstra, UseStallOnDemand>;
     using BackwardHelper = CHDijkstraBackwardHelper<CHDijkstra, UseStallOnDemand>;
-    friend ForwardHelper;
-    friend BackwardHelper;
 
 public:
-    constexpr static inline bool is_threadsafe = false;
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the scratch arrays of a single query, a context can be reused for many queries
+     * but must only be used by one thread at a time
+     */
+    class SearchContext : public ForwardHelper,
+                          public BackwardHelper
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : ForwardHelper(number_of_nodes),
+              BackwardHelper(number_of_nodes) {}
+
+    private:
+        friend CHDijkstra;
+        // the packed path of the last query and the stack used to unpack it
+        std::vector<common::EdgeID> edge_path_;
+        std::vector<common::EdgeID> unpack_stack_;
+    };
 
+    using ShortcutCache = graphs::ShortcutCache<Graph>;
+    using UnpackedEdgeRange = graphs::UnpackedEdgeRange<Graph>;
 
     template<bool SortGraphEdges = true>
-    constexpr CHDijkstra(const Graph& graph) noexcept
-        : ForwardHelper(graph.numberOfNodes()),
-          BackwardHelper(graph.numberOfNodes()),
-          graph_(graph)
+    CHDijkstra(const Graph& graph) noexcept
+        : graph_(graph),
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
     {
         static_assert(concepts::DistanceOracle<CHDijkstra>,
                       "CHDijkstra should fullfill the DistanceOracle concept");
@@ -59,22 +78,50 @@ public:
                       "Dijkstra should fullfill the PathOracle concept");
     }
 
-    constexpr CHDijkstra(CHDijkstra&&) noexcept = default;
-    constexpr CHDijkstra(const CHDijkstra&) noexcept = delete;
+    /**
+     * the nodes of shortcuts stored in the cache are copied instead of unpacked,
+     * the cache has to be built for the same graph and has to outlive the engine
+     */
+    CHDijkstra(const Graph& graph, const ShortcutCache& cache) noexcept
+        : CHDijkstra(graph)
+    {
+        cache_ = &cache;
+    }
 
-    constexpr auto operator=(CHDijkstra&&) noexcept
+    CHDijkstra(CHDijkstra&&) noexcept = default;
+    CHDijkstra(const CHDijkstra&) noexcept = delete;
+
+    auto operator=(CHDijkstra&&) noexcept
         -> CHDijkstra& = default;
 
-    constexpr auto operator=(const CHDijkstra&) noexcept
+    auto operator=(const CHDijkstra&) noexcept
         -> CHDijkstra& = delete;
 
-    [[nodiscard]] constexpr auto distanceBetween(common::NodeID source, common::NodeID target) noexcept
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    /**
+     * uses the context of the calling thread, contexts are created lazily
+     * the first time a thread queries the engine
+     */
+    [[nodiscard]] auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
         -> common::Weight
     {
-        this->fillForwardInfo(source);
-        this->fillBackwardInfo(target);
+        return distanceBetween(contexts_.local(), source, target);
+    }
 
-        const auto top_node_opt = findShortestPathCommonNode();
+    [[nodiscard]] auto distanceBetween(SearchContext& context,
+                                       common::NodeID source,
+                                       common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        context.fillForwardInfo(graph_, source);
+        context.fillBackwardInfo(graph_, target);
+
+        const auto top_node_opt = findShortestPathCommonNode(context);
 
         if(!top_node_opt) {
             return common::INFINITY_WEIGHT;
@@ -82,39 +129,125 @@ public:
 
         const auto top_node = top_node_opt.value();
 
-        return this->forward_distances_[top_node.get()]
-            + this->backward_distances_[top_node.get()];
+        return context.forward_distances_[top_node.get()]
+            + context.backward_distances_[top_node.get()];
+    }
+
+    auto pathBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> std::optional<graphs::Path>
+    {
+        return pathBetween(contexts_.local(), source, target);
     }
 
-    auto pathBetween(common::NodeID source, common::NodeID target) noexcept
+    auto pathBetween(SearchContext& context,
+                     common::NodeID source,
+                     common::NodeID target) const noexcept
         -> std::optional<graphs::Path>
     {
-        this->fillForwardInfo(source);
-        this->fillBackwardInfo(target);
+        context.fillForwardInfo(graph_, source);
+        context.fillBackwardInfo(graph_, target);
 
-        const auto top_node_opt = findShortestPathCommonNode();
+        const auto top_node_opt = findShortestPathCommonNode(context);
 
         if(!top_node_opt) {
             return std::nullopt;
         }
 
         const auto top_node = top_node_opt.value();
-        const auto edge_path = calculateEdgePath(top_node, source, target);
-        return graph_.buildPathFromEdges(edge_path);
+        calculateEdgePath(context, top_node, source, target);
+
+        if(cache_ == nullptr) {
+            return graph_.buildPathFromEdges(context.edge_path_);
+        }
+
+        return buildPathWithCache(context);
+    }
+
+    [[nodiscard]] auto edgePathBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> std::optional<graphs::EdgePath<Graph>>
+    {
+        return edgePathBetween(contexts_.local(), source, target);
+    }
+
+    /**
+     * @returns the shortest path as sequence of original edge ids, node ids and coordinates
+     * are looked up in the graph only when the path is iterated or encoded
+     */
+    [[nodiscard]] auto edgePathBetween(SearchContext& context,
+                                       common::NodeID source,
+                                       common::NodeID target) const noexcept
+        -> std::optional<graphs::EdgePath<Graph>>
+    {
+        const auto range_opt = unpackedEdgesBetween(context, source, target);
+        if(!range_opt) {
+            return std::nullopt;
+        }
+
+        std::vector<common::EdgeID> edges;
+        common::Weight cost{0};
+        for(const auto id : range_opt.value()) {
+            edges.emplace_back(id);
+
+            if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+                cost += graph_.getEdge(id)->getWeight();
+            } else {
+                cost += common::Weight{1};
+            }
+        }
+
+        return graphs::EdgePath<Graph>{graph_, source, std::move(edges), cost};
+    }
+
+    /**
+     * uses the context of the calling thread, the returned range stays valid
+     * until the calling thread issues its next query
+     */
+    [[nodiscard]] auto unpackedEdgesBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> std::optional<UnpackedEdgeRange>
+    {
+        return unpackedEdgesBetween(contexts_.local(), source, target);
+    }
+
+    /**
+     * @returns a range yielding the original edges of the shortest path one after another,
+     * shortcuts are only unpacked while iterating and no path vector is materialized.
+     * the range refers to the context and stays valid until its next query
+     */
+    [[nodiscard]] auto unpackedEdgesBetween(SearchContext& context,
+                                            common::NodeID source,
+                                            common::NodeID target) const noexcept
+        -> std::optional<UnpackedEdgeRange>
+    {
+        context.fillForwardInfo(graph_, source);
+        context.fillBackwardInfo(graph_, target);
+
+        const auto top_node_opt = findShortestPathCommonNode(context);
+
+        if(!top_node_opt) {
+            return std::nullopt;
+        }
+
+        calculateEdgePath(context, top_node_opt.value(), source, target);
+
+        return UnpackedEdgeRange{graph_,
+                                 std::span<const common::EdgeID>{context.edge_path_},
+                                 context.unpack_stack_};
     }
 
 
 private:
-    [[nodiscard]] auto calculateEdgePath(common::NodeID top_node,
-                                         common::NodeID src,
-                                         common::NodeID trg) const noexcept
-        -> std::vector<common::EdgeID>
+    auto calculateEdgePath(SearchContext& context,
+                           common::NodeID top_node,
+                           common::NodeID src,
+                           common::NodeID trg) const noexcept
+        -> void
     {
-        std::vector<common::EdgeID> edge_path;
+        auto& edge_path = context.edge_path_;
+        edge_path.clear();
 
         common::NodeID current = top_node;
         while(current != src) {
-            const auto curr_best_ingoing = this->forward_best_ingoing_[current.get()];
+            const auto curr_best_ingoing = context.forward_best_ingoing_[current.get()];
             edge_path.emplace_back(curr_best_ingoing);
             current = graph_.getEdge(curr_best_ingoing)->getSrc();
         }
@@ -123,43 +256,75 @@ private:
 
         current = top_node;
         while(current != trg) {
-            const auto curr_best_ingoing = this->backward_best_ingoing_[current.get()];
+            const auto curr_best_ingoing = context.backward_best_ingoing_[current.get()];
             edge_path.emplace_back(curr_best_ingoing);
             current = graph_.getBackwardEdge(curr_best_ingoing)->getSrc();
         }
+    }
+
+    [[nodiscard]] auto buildPathWithCache(SearchContext& context) const noexcept
+        -> graphs::Path
+    {
+        const auto& edge_path = context.edge_path_;
+        if(edge_path.empty()) {
+            return graphs::Path::empty();
+        }
+
+        std::vector nodes{graph_.getEdge(edge_path.front())->getSrc()};
+        common::Weight weight{0};
+
+        for(const auto& id : edge_path) {
+            if(const auto cached = cache_->getUnpackedNodes(id)) {
+                nodes.insert(std::end(nodes), std::begin(*cached), std::end(*cached));
+            } else {
+                const auto range = UnpackedEdgeRange{graph_, std::span{&id, 1}, context.unpack_stack_};
+                for(const auto original : range) {
+                    nodes.emplace_back(graph_.getEdge(original)->getTrg());
+                }
+            }
+
+            // the weight of a shortcut is the weight of the path it represents
+            if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+                weight += graph_.getEdge(id)->getWeight();
+            }
+        }
+
+        if constexpr(!concepts::HasWeight<typename Graph::EdgeType>) {
+            weight = common::Weight{static_cast<std::int_fast64_t>(nodes.size() - 1)};
+        }
 
-        return edge_path;
+        return graphs::Path{std::move(nodes), weight};
     }
 
-    [[nodiscard]] constexpr auto findShortestPathCommonNode() const noexcept
+    [[nodiscard]] static constexpr auto findShortestPathCommonNode(const SearchContext& context) noexcept
         -> std::optional<common::NodeID>
     {
-        if(this->forward_settled_.empty() or this->backward_settled_.empty()) {
+        if(context.forward_settled_.empty() or context.backward_settled_.empty()) {
             return std::nullopt;
         }
 
-        auto best_node = this->forward_settled_[0];
+        auto best_node = context.forward_settled_[0];
         auto best_dist = common::INFINITY_WEIGHT;
 
         auto forward_idx = 0ul;
         auto backward_idx = 0ul;
 
-        while(forward_idx < this->forward_settled_.size()
-              and backward_idx < this->backward_settled_.size()) {
+        while(forward_idx < context.forward_settled_.size()
+              and backward_idx < context.backward_settled_.size()) {
 
-            if(this->forward_settled_[forward_idx] < this->backward_settled_[backward_idx]) {
+            if(context.forward_settled_[forward_idx] < context.backward_settled_[backward_idx]) {
                 forward_idx++;
                 continue;
             }
 
-            if(this->forward_settled_[forward_idx] > this->backward_settled_[backward_idx]) {
+            if(context.forward_settled_[forward_idx] > context.backward_settled_[backward_idx]) {
                 backward_idx++;
                 continue;
             }
 
-            const auto common = this->forward_settled_[forward_idx];
-            const auto new_dist = this->forward_distances_[common.get()]
-                + this->backward_distances_[common.get()];
+            const auto common = context.forward_settled_[forward_idx];
+            const auto new_dist = context.forward_distances_[common.get()]
+                + context.backward_distances_[common.get()];
 
             if(new_dist < best_dist) {
                 best_dist = new_dist;
@@ -179,6 +344,8 @@ private:
 
 private:
     const Graph& graph_;
+    const ShortcutCache* cache_ = nullptr;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
 };
 
 
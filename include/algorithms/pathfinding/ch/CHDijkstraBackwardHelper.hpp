@@ -8,10 +8,15 @@
 #include <span>
 #include <type_traits>
 #include <utility>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::pathfinding {
 
-template<class CRTP, bool UseStallOnDemand>
+/**
+ * scratch arrays of the backward search of a ch query, the helper is part of
+ * a search context and the graph is passed in by the engine which owns the context
+ */
+template<class Engine, bool UseStallOnDemand>
 class CHDijkstraBackwardHelper
 {
 public:
@@ -20,17 +25,18 @@ public:
     constexpr auto operator=(const CHDijkstraBackwardHelper&) noexcept
         -> CHDijkstraBackwardHelper& = delete;
 
-private:
+protected:
     constexpr CHDijkstraBackwardHelper(std::size_t number_of_nodes)
         : backward_distances_(number_of_nodes, common::INFINITY_WEIGHT),
-          backward_best_ingoing_(number_of_nodes, common::UNKNOWN_EDGE_ID),
-          backward_already_settled_(number_of_nodes, false) {}
+          backward_best_ingoing_(number_of_nodes, common::UNKNOWN_EDGE_ID) {}
     constexpr CHDijkstraBackwardHelper(CHDijkstraBackwardHelper&&) noexcept = default;
 
     constexpr auto operator=(CHDijkstraBackwardHelper&&) noexcept
         -> CHDijkstraBackwardHelper& = default;
 
-    auto fillBackwardInfo(common::NodeID source) noexcept
+private:
+    template<class Graph>
+    auto fillBackwardInfo(const Graph& graph, common::NodeID source) noexcept
         -> void
     {
         if(back_last_source_ == source) {
@@ -46,16 +52,16 @@ private:
             const auto [current_node, cost_to_current] = heap.top();
             heap.pop();
 
-            if(backward_already_settled_[current_node.get()]) {
+            if(backward_distances_.isSettled(current_node.get())) {
                 continue;
             }
 
-            backward_already_settled_[current_node.get()] = true;
+            backward_distances_.settle(current_node.get());
 
-            const auto edge_ids = getGraph().getBackwardEdgeIDsOf(current_node);
+            const auto edge_ids = graph.getBackwardEdgeIDsOf(current_node);
 
             if constexpr(UseStallOnDemand) {
-                if(shouldStall(cost_to_current, edge_ids)) {
+                if(shouldStall(graph, cost_to_current, graph.getForwardEdgeIDsOf(current_node))) {
                     continue;
                 }
             }
@@ -63,15 +69,14 @@ private:
             backward_settled_.emplace_back(current_node);
 
             for(const auto& id : edge_ids) {
-                const auto edge = getGraph().getBackwardEdge(id);
+                const auto edge = graph.getBackwardEdge(id);
                 const auto neig = edge->getTrg();
                 const auto cost = edge->getWeight();
                 const auto new_dist = cost + cost_to_current;
 
                 if(new_dist < backward_distances_[neig.get()]) {
                     heap.emplace(neig, new_dist);
-                    backward_distances_[neig.get()] = new_dist;
-                    backward_touched_.emplace_back(neig);
+                    backward_distances_.set(neig.get(), new_dist);
                     backward_best_ingoing_[neig.get()] = id;
                 }
             }
@@ -81,12 +86,16 @@ private:
                   std::end(backward_settled_));
     }
 
-    [[nodiscard]] constexpr auto shouldStall(common::Weight cost_to_current,
-                                             const std::span<const common::EdgeID>& edge_ids) const noexcept
+    // a node is stalled if it can be reached cheaper over an edge from a higher node,
+    // in the backward search these are the forward edges of the node
+    template<class Graph>
+    [[nodiscard]] constexpr auto shouldStall(const Graph& graph,
+                                             common::Weight cost_to_current,
+                                             const std::span<const common::EdgeID>& ingoing_ids) const noexcept
         -> bool
     {
-        for(const auto& id : edge_ids) {
-            const auto& edge = getGraph().getBackwardEdge(id);
+        for(const auto& id : ingoing_ids) {
+            const auto* edge = graph.getEdge(id);
             const auto neig = edge->getTrg();
             const auto cost = edge->getWeight();
             const auto current_dist_to_neig = backward_distances_[neig.get()];
@@ -106,34 +115,20 @@ private:
     constexpr auto resetBackwardFor(common::NodeID node) noexcept
         -> void
     {
-        for(const auto& node : backward_touched_) {
-            const auto n = node.get();
-            backward_distances_[n] = common::INFINITY_WEIGHT;
-            backward_best_ingoing_[n] = common::UNKNOWN_EDGE_ID;
-            backward_already_settled_[n] = false;
-        }
+        backward_distances_.clear();
         backward_settled_.clear();
-        backward_touched_.clear();
 
         back_last_source_ = node;
-        backward_touched_.emplace_back(node);
-        backward_distances_[node.get()] = common::Weight{0};
-    }
-
-    [[nodiscard]] constexpr auto getGraph() const noexcept
-        -> decltype(auto)
-    {
-        return static_cast<const CRTP*>(this)->graph_;
+        backward_distances_.set(node.get(), common::Weight{0});
     }
 
 private:
-    friend CRTP;
+    friend Engine;
     std::vector<common::NodeID> backward_settled_;
-    std::vector<common::Weight> backward_distances_;
-    std::vector<common::NodeID> backward_touched_;
+    util::VersionedArray<common::Weight> backward_distances_;
     std::optional<common::NodeID> back_last_source_;
+    // only read for nodes reached in the current search, so it is never reset
     std::vector<common::EdgeID> backward_best_ingoing_;
-    std::vector<bool> backward_already_settled_;
 };
 
 } // namespace algorithms::distoracle
@@ -8,10 +8,15 @@
 #include <span>
 #include <type_traits>
 #include <utility>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::pathfinding {
 
-template<class CRTP, bool UseStallOnDemand>
+/**
+ * scratch arrays of the forward search of a ch query, the helper is part of
+ * a search context and the graph is passed in by the engine which owns the context
+ */
+template<class Engine, bool UseStallOnDemand>
 class CHDijkstraForwardHelper
 {
 public:
@@ -20,18 +25,19 @@ public:
 
     constexpr CHDijkstraForwardHelper(const CHDijkstraForwardHelper&) noexcept = delete;
 
-private:
+protected:
     constexpr CHDijkstraForwardHelper(std::size_t number_of_nodes)
         : forward_distances_(number_of_nodes, common::INFINITY_WEIGHT),
-          forward_best_ingoing_(number_of_nodes, common::UNKNOWN_EDGE_ID),
-          forward_already_settled_(number_of_nodes, false) {}
+          forward_best_ingoing_(number_of_nodes, common::UNKNOWN_EDGE_ID) {}
 
     constexpr CHDijkstraForwardHelper(CHDijkstraForwardHelper&&) noexcept = default;
 
     constexpr auto operator=(CHDijkstraForwardHelper&&) noexcept
         -> CHDijkstraForwardHelper& = default;
 
-    auto fillForwardInfo(common::NodeID source) noexcept
+private:
+    template<class Graph>
+    auto fillForwardInfo(const Graph& graph, common::NodeID source) noexcept
         -> void
     {
         if(forward_last_source_ == source) {
@@ -43,22 +49,20 @@ private:
         pathfinding::DijkstraQueue heap;
         heap.emplace(source, 0);
 
-        const auto& graph = getGraph();
-
         while(!heap.empty()) {
             const auto [current_node, cost_to_current] = heap.top();
             heap.pop();
 
-            if(forward_already_settled_[current_node.get()]) {
+            if(forward_distances_.isSettled(current_node.get())) {
                 continue;
             }
 
-            forward_already_settled_[current_node.get()] = true;
+            forward_distances_.settle(current_node.get());
 
             const auto edge_ids = graph.getForwardEdgeIDsOf(current_node);
 
             if constexpr(UseStallOnDemand) {
-                if(shouldStall(cost_to_current, edge_ids)) {
+                if(shouldStall(graph, cost_to_current, graph.getBackwardEdgeIDsOf(current_node))) {
                     continue;
                 }
             }
@@ -73,8 +77,7 @@ private:
 
                 if(new_dist < forward_distances_[neig.get()]) {
                     heap.emplace(neig, new_dist);
-                    forward_distances_[neig.get()] = new_dist;
-                    forward_touched_.emplace_back(neig);
+                    forward_distances_.set(neig.get(), new_dist);
                     forward_best_ingoing_[neig.get()] = id;
                 }
             }
@@ -84,12 +87,16 @@ private:
                   std::end(forward_settled_));
     }
 
-    constexpr auto shouldStall(common::Weight cost_to_current,
-                               const std::span<const common::EdgeID>& edge_ids) const noexcept
+    // a node is stalled if it can be reached cheaper over an edge from a higher node,
+    // in the forward search these are the backward edges of the node
+    template<class Graph>
+    constexpr auto shouldStall(const Graph& graph,
+                               common::Weight cost_to_current,
+                               const std::span<const common::EdgeID>& ingoing_ids) const noexcept
         -> bool
     {
-        for(const auto& id : edge_ids) {
-            const auto* edge = getGraph().getEdge(id);
+        for(const auto& id : ingoing_ids) {
+            const auto edge = graph.getBackwardEdge(id);
             const auto neig = edge->getTrg();
             const auto cost = edge->getWeight();
             const auto current_dist_to_neig = forward_distances_[neig.get()];
@@ -109,33 +116,19 @@ private:
     constexpr auto resetForwardFor(common::NodeID node) noexcept
         -> void
     {
-        for(const auto& node : forward_touched_) {
-            const auto n = node.get();
-            forward_distances_[n] = common::INFINITY_WEIGHT;
-            forward_best_ingoing_[n] = common::UNKNOWN_EDGE_ID;
-            forward_already_settled_[n] = false;
-        }
+        forward_distances_.clear();
         forward_settled_.clear();
-        forward_touched_.clear();
 
         forward_last_source_ = node;
-        forward_touched_.emplace_back(node);
-        forward_distances_[node.get()] = common::Weight{0};
-    }
-
-    [[nodiscard]] constexpr auto getGraph() const noexcept
-        -> decltype(auto)
-    {
-        return static_cast<const CRTP*>(this)->graph_;
+        forward_distances_.set(node.get(), common::Weight{0});
     }
 
 private:
-    friend CRTP;
-    std::vector<common::Weight> forward_distances_;
-    std::vector<common::NodeID> forward_touched_;
+    friend Engine;
+    util::VersionedArray<common::Weight> forward_distances_;
     std::optional<common::NodeID> forward_last_source_;
+    // only read for nodes reached in the current search, so it is never reset
     std::vector<common::EdgeID> forward_best_ingoing_;
-    std::vector<bool> forward_already_settled_;
     std::vector<common::NodeID> forward_settled_;
 };
 
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/BackwardConnections.hpp>
+#include <concepts/DistanceOracle.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <concepts/PathOracle.hpp>
+#include <graphs/Path.hpp>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <utils/EdgeFilter.hpp>
+#include <utils/VersionedArray.hpp>
+
+namespace algorithms::pathfinding {
+
+/**
+ * bidirectional dijkstra, alternates a forward search from the source
+ * and a backward search from the target until the sum of both queue minima
+ * is not smaller than the best path found so far. both searches skip the edges
+ * blocked by the filter
+ */
+template<class Graph, class Filter = util::NoEdgeFilter>
+// clang-format off
+requires concepts::ForwardConnections<Graph>
+      && concepts::BackwardConnections<Graph>
+      && concepts::HasEdges<Graph>
+      && concepts::HasNodes<Graph>
+      && concepts::HasSource<typename Graph::EdgeType>
+      && concepts::HasTarget<typename Graph::EdgeType>
+// clang-format on
+class BidirectionalDijkstra
+{
+public:
+    constexpr static inline bool is_threadsafe = false;
+
+    BidirectionalDijkstra(const Graph& graph, Filter filter = Filter{}) noexcept
+        : graph_(graph),
+          filter_(std::move(filter)),
+          forward_distances_(graph.numberOfNodes(), common::INFINITY_WEIGHT),
+          forward_pq_(DijkstraQueueComparer{}),
+          forward_before_(graph.numberOfNodes(), common::UNKNOWN_NODE_ID),
+          backward_distances_(graph.numberOfNodes(), common::INFINITY_WEIGHT),
+          backward_pq_(DijkstraQueueComparer{}),
+          backward_after_(graph.numberOfNodes(), common::UNKNOWN_NODE_ID)
+    {
+        static_assert(concepts::PathOracle<BidirectionalDijkstra>,
+                      "BidirectionalDijkstra should fullfill the PathOracle concept");
+
+        static_assert(concepts::DistanceOracle<BidirectionalDijkstra>,
+                      "BidirectionalDijkstra should fullfill the DistanceOracle concept");
+    }
+
+    BidirectionalDijkstra() = delete;
+    BidirectionalDijkstra(BidirectionalDijkstra&&) noexcept = default;
+    BidirectionalDijkstra(const BidirectionalDijkstra&) noexcept = default;
+    auto operator=(const BidirectionalDijkstra&) -> BidirectionalDijkstra& = delete;
+    auto operator=(BidirectionalDijkstra&&) noexcept -> BidirectionalDijkstra& = default;
+
+    /**
+     * replaces the filter which is used by all following queries
+     */
+    auto setEdgeFilter(Filter filter) noexcept
+        -> void
+    {
+        filter_ = std::move(filter);
+    }
+
+    [[nodiscard]] auto getEdgeFilter() const noexcept
+        -> const Filter&
+    {
+        return filter_;
+    }
+
+    auto pathBetween(common::NodeID source, common::NodeID target) noexcept
+        -> std::optional<graphs::Path>
+    {
+        const auto cost = distanceBetween(source, target);
+        if(cost == common::INFINITY_WEIGHT) {
+            return std::nullopt;
+        }
+
+        //extract the first half of the path starting at the meeting node
+        std::vector nodes{meeting_node_};
+        while(nodes.back() != source) {
+            nodes.emplace_back(forward_before_[nodes.back().get()]);
+        }
+        std::reverse(std::begin(nodes), std::end(nodes));
+
+        //append the second half which is stored by the backward search
+        while(nodes.back() != target) {
+            nodes.emplace_back(backward_after_[nodes.back().get()]);
+        }
+
+        return graphs::Path(std::move(nodes),
+                            cost);
+    }
+
+    auto distanceBetween(common::NodeID source, common::NodeID target) noexcept
+        -> common::Weight
+    {
+        resetFor(source, target);
+
+        if(source == target) {
+            return common::Weight{0};
+        }
+
+        auto forward_turn = true;
+        while(!forward_pq_.empty() and !backward_pq_.empty()) {
+            const auto forward_min = forward_pq_.top().second;
+            const auto backward_min = backward_pq_.top().second;
+
+            // no path shorter than the best one found so far can be found
+            if(best_distance_ != common::INFINITY_WEIGHT
+               and forward_min + backward_min >= best_distance_) {
+                break;
+            }
+
+            if(forward_turn) {
+                forwardStep();
+            } else {
+                backwardStep();
+            }
+
+            forward_turn = !forward_turn;
+        }
+
+        return best_distance_;
+    }
+
+private:
+    auto forwardStep() noexcept
+        -> void
+    {
+        const auto [current_node, current_dist] = forward_pq_.top();
+        forward_pq_.pop();
+
+        if(forward_distances_.isSettled(current_node.get())) {
+            return;
+        }
+        forward_distances_.settle(current_node.get());
+
+        const auto edge_ids = graph_.getForwardEdgeIDsOf(current_node);
+        for(const auto id : edge_ids) {
+            const auto* edge = graph_.getEdge(id);
+            if(filter_.isBlocked(id, *edge)) {
+                continue;
+            }
+
+            const auto neig = edge->getTrg();
+            const auto new_dist = current_dist + getWeight(edge);
+
+            if(forward_distances_[neig.get()] > new_dist) {
+                forward_distances_.set(neig.get(), new_dist);
+                forward_before_[neig.get()] = current_node;
+                forward_pq_.emplace(neig, new_dist);
+
+                updateBestDistance(neig);
+            }
+        }
+    }
+
+    auto backwardStep() noexcept
+        -> void
+    {
+        const auto [current_node, current_dist] = backward_pq_.top();
+        backward_pq_.pop();
+
+        if(backward_distances_.isSettled(current_node.get())) {
+            return;
+        }
+        backward_distances_.settle(current_node.get());
+
+        const auto edge_ids = graph_.getBackwardEdgeIDsOf(current_node);
+        for(const auto id : edge_ids) {
+            if(filter_.isBlocked(id, *graph_.getEdge(id))) {
+                continue;
+            }
+
+            const auto edge = graph_.getBackwardEdge(id);
+            const auto neig = edge->getTrg();
+            const auto new_dist = current_dist + getWeight(edge);
+
+            if(backward_distances_[neig.get()] > new_dist) {
+                backward_distances_.set(neig.get(), new_dist);
+                backward_after_[neig.get()] = current_node;
+                backward_pq_.emplace(neig, new_dist);
+
+                updateBestDistance(neig);
+            }
+        }
+    }
+
+    constexpr auto updateBestDistance(common::NodeID node) noexcept
+        -> void
+    {
+        const auto forward_dist = forward_distances_[node.get()];
+        const auto backward_dist = backward_distances_[node.get()];
+
+        if(forward_dist == common::INFINITY_WEIGHT
+           or backward_dist == common::INFINITY_WEIGHT) {
+            return;
+        }
+
+        if(forward_dist + backward_dist < best_distance_) {
+            best_distance_ = forward_dist + backward_dist;
+            meeting_node_ = node;
+        }
+    }
+
+    template<class EdgePtr>
+    constexpr auto getWeight([[maybe_unused]] const EdgePtr& edge) const noexcept
+        -> common::Weight
+    {
+        //use the edge weight if available otherwise every edge has a weight 1
+        if constexpr(concepts::HasWeight<typename Graph::EdgeType>) {
+            return edge->getWeight();
+        } else {
+            return common::Weight{1};
+        }
+    }
+
+    constexpr auto resetFor(common::NodeID source, common::NodeID target) noexcept
+        -> void
+    {
+        // forward_before_ and backward_after_ are only read for reached nodes
+        // and do not need to be reset
+        forward_distances_.clear();
+        backward_distances_.clear();
+        forward_pq_ = DijkstraQueue{DijkstraQueueComparer{}};
+        backward_pq_ = DijkstraQueue{DijkstraQueueComparer{}};
+
+        best_distance_ = common::INFINITY_WEIGHT;
+        meeting_node_ = source;
+
+        forward_pq_.emplace(source, 0l);
+        forward_distances_.set(source.get(), common::Weight{0});
+
+        backward_pq_.emplace(target, 0l);
+        backward_distances_.set(target.get(), common::Weight{0});
+    }
+
+private:
+    const Graph& graph_;
+    [[no_unique_address]] Filter filter_;
+
+    util::VersionedArray<common::Weight> forward_distances_;
+    DijkstraQueue forward_pq_;
+    std::vector<common::NodeID> forward_before_;
+
+    util::VersionedArray<common::Weight> backward_distances_;
+    DijkstraQueue backward_pq_;
+    std::vector<common::NodeID> backward_after_;
+
+    common::Weight best_distance_ = common::INFINITY_WEIGHT;
+    common::NodeID meeting_node_ = common::UNKNOWN_NODE_ID;
+};
+
+} // namespace algorithms::pathfinding
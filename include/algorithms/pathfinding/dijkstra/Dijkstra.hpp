@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <algorithms/pathfinding/dijkstra/DijkstraQueue.hpp>
 #include <common/BasicGraphTypes.hpp>
 #include <common/EmptyBase.hpp>
@@ -9,9 +10,13 @@
 #include <concepts/PathOracle.hpp>
 #include <fmt/core.h>
 #include <graphs/Path.hpp>
+#include <optional>
 #include <queue>
+#include <span>
+#include <tbb/enumerable_thread_specific.h>
 #include <type_traits>
 #include <utility>
+#include <utils/VersionedArray.hpp>
 
 namespace algorithms::pathfinding {
 
@@ -25,15 +30,35 @@ requires concepts::ForwardConnections<Graph>
 class Dijkstra
 {
 public:
-    constexpr static inline bool is_threadsafe = false;
+    constexpr static inline bool is_threadsafe = true;
+
+    /**
+     * the scratch arrays of a single query, a context can be reused for many queries
+     * but must only be used by one thread at a time
+     */
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t number_of_nodes) noexcept
+            : distances_(number_of_nodes, common::INFINITY_WEIGHT),
+              pq_(DijkstraQueueComparer{}),
+              last_source_(std::nullopt),
+              before_(number_of_nodes, common::UNKNOWN_NODE_ID) {}
+
+    private:
+        friend Dijkstra;
+        util::VersionedArray<common::Weight> distances_;
+        DijkstraQueue pq_;
+        std::optional<common::NodeID> last_source_;
+        // only read for nodes reached in the current query, so it is never reset
+        std::vector<common::NodeID> before_;
+    };
 
     Dijkstra(const Graph& graph) noexcept
         : graph_(graph),
-          distances_(graph.numberOfNodes(), common::INFINITY_WEIGHT),
-          settled_(graph.numberOfNodes(), false),
-          pq_(DijkstraQueueComparer{}),
-          last_source_(std::nullopt),
-          before_(graph.numberOfNodes(), common::UNKNOWN_NODE_ID)
+          contexts_([number_of_nodes = graph.numberOfNodes()] {
+              return SearchContext{number_of_nodes};
+          })
     {
         static_assert(concepts::PathOracle<Dijkstra>,
                       "Dijkstra should fullfill the PathOracle concept");
@@ -44,15 +69,29 @@ public:
 
     Dijkstra() = delete;
     Dijkstra(Dijkstra&&) noexcept = default;
-    Dijkstra(const Dijkstra&) noexcept = default;
+    Dijkstra(const Dijkstra&) noexcept = delete;
     auto operator=(const Dijkstra&) -> Dijkstra& = delete;
     auto operator=(Dijkstra&&) noexcept -> Dijkstra& = default;
 
-    auto pathBetween(common::NodeID source, common::NodeID target) noexcept
+    [[nodiscard]] auto createSearchContext() const noexcept
+        -> SearchContext
+    {
+        return SearchContext{graph_.numberOfNodes()};
+    }
+
+    auto pathBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> std::optional<graphs::Path>
+    {
+        return pathBetween(contexts_.local(), source, target);
+    }
+
+    auto pathBetween(SearchContext& context,
+                     common::NodeID source,
+                     common::NodeID target) const noexcept
         -> std::optional<graphs::Path>
     {
         //fill the distance array and calculate the cost
-        const auto cost = distanceBetween(source, target);
+        const auto cost = distanceBetween(context, source, target);
         if(cost == common::INFINITY_WEIGHT) {
             return std::nullopt;
         }
@@ -60,7 +99,7 @@ public:
         //extract path starting from the target
         std::vector nodes{target};
         while(nodes.back() != source) {
-            nodes.emplace_back(before_[nodes.back().get()]);
+            nodes.emplace_back(context.before_[nodes.back().get()]);
         }
         //reverse the vector to get the actual path
         std::reverse(std::begin(nodes), std::end(nodes));
@@ -69,30 +108,141 @@ public:
                             cost);
     }
 
-    auto distanceBetween(common::NodeID source, common::NodeID target) noexcept
+    auto distanceBetween(common::NodeID source, common::NodeID target) const noexcept
+        -> common::Weight
+    {
+        return distanceBetween(contexts_.local(), source, target);
+    }
+
+    auto distanceBetween(SearchContext& context,
+                         common::NodeID source,
+                         common::NodeID target) const noexcept
         -> common::Weight
     {
-        if(last_source_ == source
-           and settled_[target.get()]) {
-            return distances_[target.get()];
+        if(context.last_source_ == source
+           and context.distances_.isSettled(target.get())) {
+            return context.distances_[target.get()];
+        }
+
+        if(source != context.last_source_) {
+            resetFor(context, source);
+        }
+
+        while(const auto settled = settleNextNode(context)) {
+            if(settled->first == target) {
+                return settled->second;
+            }
+        }
+
+        return common::INFINITY_WEIGHT;
+    }
+
+    /**
+     * @returns the distances from the source to the targets in the order of the targets,
+     * the search stops as soon as all targets are settled
+     */
+    [[nodiscard]] auto distancesTo(common::NodeID source,
+                                   std::span<const common::NodeID> targets) const noexcept
+        -> std::vector<common::Weight>
+    {
+        return distancesTo(contexts_.local(), source, targets);
+    }
+
+    [[nodiscard]] auto distancesTo(SearchContext& context,
+                                   common::NodeID source,
+                                   std::span<const common::NodeID> targets) const noexcept
+        -> std::vector<common::Weight>
+    {
+        if(source != context.last_source_) {
+            resetFor(context, source);
+        }
+
+        // targets settled by an earlier query from the same source do not need to be searched
+        std::vector<common::NodeID> open_targets;
+        std::copy_if(std::begin(targets),
+                     std::end(targets),
+                     std::back_inserter(open_targets),
+                     [&](const auto target) {
+                         return !context.distances_.isSettled(target.get());
+                     });
+        std::sort(std::begin(open_targets), std::end(open_targets));
+        open_targets.erase(std::unique(std::begin(open_targets), std::end(open_targets)),
+                           std::end(open_targets));
+
+        auto remaining = open_targets.size();
+        while(remaining > 0) {
+            const auto settled = settleNextNode(context);
+            if(!settled) {
+                break;
+            }
+
+            if(std::binary_search(std::begin(open_targets),
+                                  std::end(open_targets),
+                                  settled->first)) {
+                remaining--;
+            }
         }
 
-        if(source != last_source_) {
-            resetFor(source);
+        std::vector<common::Weight> distances(targets.size(), common::INFINITY_WEIGHT);
+        for(std::size_t i = 0; i < targets.size(); i++) {
+            if(context.distances_.isSettled(targets[i].get())) {
+                distances[i] = context.distances_[targets[i].get()];
+            }
         }
 
-        while(!pq_.empty()) {
-            const auto [current_node, current_dist] = pq_.top();
+        return distances;
+    }
 
-            settled_[current_node.get()] = true;
+    /**
+     * @returns all nodes with a distance of at most limit from the source together with their
+     * distance, ordered by distance. the search is kept alive and can be continued by
+     * the other queries from the same source
+     */
+    [[nodiscard]] auto distancesWithin(common::NodeID source, common::Weight limit) const noexcept
+        -> std::vector<std::pair<common::NodeID, common::Weight>>
+    {
+        return distancesWithin(contexts_.local(), source, limit);
+    }
 
-            if(current_node == target) {
-                return current_dist;
+    [[nodiscard]] auto distancesWithin(SearchContext& context,
+                                       common::NodeID source,
+                                       common::Weight limit) const noexcept
+        -> std::vector<std::pair<common::NodeID, common::Weight>>
+    {
+        // nodes settled by an earlier query cannot be enumerated, so the search starts over
+        resetFor(context, source);
+
+        std::vector<std::pair<common::NodeID, common::Weight>> reached;
+        while(const auto settled = settleNextNode(context, limit)) {
+            reached.emplace_back(settled.value());
+        }
+
+        return reached;
+    }
+
+private:
+    /**
+     * settles the next node of the search, nodes further away than limit are not settled
+     * @returns the settled node and its distance, nullopt if no node is left
+     */
+    auto settleNextNode(SearchContext& context,
+                        common::Weight limit = common::INFINITY_WEIGHT) const noexcept
+        -> std::optional<std::pair<common::NodeID, common::Weight>>
+    {
+        while(!context.pq_.empty()) {
+            const auto [current_node, current_dist] = context.pq_.top();
+
+            // keep the node in the queue, such that the search can be continued later
+            if(current_dist > limit) {
+                return std::nullopt;
             }
 
-            //pop after the return, otherwise we loose a value
-            //when reusing the pq
-            pq_.pop();
+            context.pq_.pop();
+
+            if(context.distances_.isSettled(current_node.get())) {
+                continue;
+            }
+            context.distances_.settle(current_node.get());
 
             const auto edge_ids = graph_.getForwardEdgeIDsOf(current_node);
 
@@ -111,49 +261,36 @@ public:
                 }
                 ();
 
-                const auto neig_dist = distances_[neig.get()];
+                const auto neig_dist = context.distances_[neig.get()];
                 const auto new_dist = current_dist + distance;
 
                 if(common::INFINITY_WEIGHT != current_dist and neig_dist > new_dist) {
-                    touched_.emplace_back(neig);
-                    distances_[neig.get()] = new_dist;
-                    pq_.emplace(neig, new_dist);
-                    before_[neig.get()] = current_node;
+                    context.distances_.set(neig.get(), new_dist);
+                    context.pq_.emplace(neig, new_dist);
+                    context.before_[neig.get()] = current_node;
                 }
             }
+
+            return std::pair{current_node, current_dist};
         }
 
-        return common::INFINITY_WEIGHT;
+        return std::nullopt;
     }
 
-private:
-    constexpr auto resetFor(common::NodeID new_source) noexcept
+    constexpr static auto resetFor(SearchContext& context, common::NodeID new_source) noexcept
         -> void
     {
-        for(const auto id : touched_) {
-            const auto n = id.get();
-            settled_[n] = false;
-            distances_[n] = common::INFINITY_WEIGHT;
-            before_[n] = common::UNKNOWN_NODE_ID;
-        }
-
-        touched_.clear();
-        pq_ = DijkstraQueue{DijkstraQueueComparer{}};
+        context.distances_.clear();
+        context.pq_ = DijkstraQueue{DijkstraQueueComparer{}};
 
-        last_source_ = new_source;
-        pq_.emplace(new_source, 0l);
-        distances_[new_source.get()] = common::Weight{0};
-        touched_.emplace_back(new_source);
+        context.last_source_ = new_source;
+        context.pq_.emplace(new_source, 0l);
+        context.distances_.set(new_source.get(), common::Weight{0});
     }
 
 private:
     const Graph& graph_;
-    std::vector<common::Weight> distances_;
-    std::vector<bool> settled_;
-    std::vector<common::NodeID> touched_;
-    DijkstraQueue pq_;
-    std::optional<common::NodeID> last_source_;
-    std::vector<common::NodeID> before_;
+    mutable tbb::enumerable_thread_specific<SearchContext> contexts_;
 };
 
 } // namespace algorithms::pathfinding
@@ -3,6 +3,7 @@
 #include <concepts/Edges.hpp>
 #include <concepts/Nodes.hpp>
 #include <optional>
+#include <span>
 
 namespace concepts {
 
@@ -41,6 +42,25 @@ concept OneToManyDistanceOracle = requires(O& oracle, common::NodeID src)
 	 */
 	{O::is_threadsafe} noexcept -> std::common_with<const bool>;
 };
+
+template<typename O>
+concept ManyToManyDistanceOracle = requires(O& oracle,
+                                            std::span<const common::NodeID> sources,
+                                            std::span<const common::NodeID> targets,
+                                            std::span<common::Weight> out)
+{
+	/**
+	 * writes the distance from sources[i] to targets[j] to out[i * targets.size() + j]
+	 * @returns false if out does not have exactly sources.size() * targets.size() entries
+	 */
+    {oracle.distanceTable(sources, targets, out)} noexcept -> std::same_as<bool>;
+
+	/**
+	 * @returns true if the distance oracle can be used in a multithreaded environment,
+	 * false otherwise
+	 */
+	{O::is_threadsafe} noexcept -> std::common_with<const bool>;
+};
 // clang-format on
 
 } // namespace concepts
@@ -2,6 +2,7 @@
 
 #include <common/BasicGraphTypes.hpp>
 #include <concepts>
+#include <ranges>
 #include <span>
 
 namespace concepts {
@@ -16,8 +17,8 @@ concept HasLevel = requires(const Node& node, common::NodeLevel level)
 template<typename Node>
 concept HasLatLng = requires(const Node& node)
 {
-    {node.getLat()} -> std::convertible_to<double>;
-    {node.getLng()} -> std::convertible_to<double>;
+    {node.getLat()} -> std::convertible_to<common::Latitude>;
+    {node.getLng()} -> std::convertible_to<common::Longitude>;
 };
 
 template<typename Node>
@@ -45,15 +46,29 @@ concept HasNodes = requires(const T& graph, common::NodeID id)
 	{graph.numberOfNodes()} noexcept -> std::same_as<std::size_t>;
 };
 
+/*
+ * a pointer to a node or a proxy which behaves like one, i.e. it is
+ * convertible to bool and dereferences to something convertible to the node
+ */
+template<typename Pointer, typename Node>
+concept NodePointer = requires(const Pointer& pointer)
+{
+    {static_cast<bool>(pointer)};
+    {*pointer} -> std::convertible_to<Node>;
+};
+
 template<typename T>
 concept HasAccessableNodes = requires(const T& graph)
 {
     requires HasNodes<T>;
 
 	/*
-	 * @return all nodes as span
+	 * @return all nodes as random access range of the nodes or of proxies of the nodes
 	 */
-	{graph.getNodes()} noexcept -> std::same_as<std::span<const typename T::NodeType>>;
+	{graph.getNodes()} noexcept -> std::ranges::random_access_range;
+
+    requires std::convertible_to<std::ranges::range_reference_t<decltype(graph.getNodes())>,
+                                 typename T::NodeType>;
 };
 
 
@@ -65,10 +80,10 @@ concept HasNontrivialNodes = requires(const T& graph, common::NodeID id)
 	/*
 	 * returns a pointer to the node class associated with the
 	 * given ID
-	 * @return a non owning pointer to the node object associated with the given id,
+	 * @return a non owning pointer or a proxy of the node object associated with the given id,
 	 * null if no such object exists
 	 */
-	{graph.getNode(id)} noexcept -> std::same_as<const typename T::NodeType*>;
+	{graph.getNode(id)} noexcept -> NodePointer<typename T::NodeType>;
 };
 
 
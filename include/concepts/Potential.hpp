@@ -0,0 +1,23 @@
+#pragma once
+
+#include <common/BasicGraphTypes.hpp>
+#include <concepts>
+
+namespace concepts {
+
+// clang-format off
+template<typename P>
+concept Potential = requires(const P& potential, common::NodeID node)
+{
+	/**
+	 * @returns a function object which, when called with a node id, returns a lower bound
+	 * of the shortest path distance between that node and the given target node.
+	 * everything depending on the target is computed once here, the returned object is
+	 * then evaluated for every node the search touches
+	 */
+    {potential.forTarget(node)} noexcept;
+    {potential.forTarget(node)(node)} noexcept -> std::same_as<common::Weight>;
+};
+// clang-format on
+
+} // namespace concepts
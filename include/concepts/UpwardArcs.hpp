@@ -0,0 +1,34 @@
+#pragma once
+
+#include <common/BasicGraphTypes.hpp>
+#include <concepts>
+#include <graphs/offsetarray/CHSearchGraph.hpp>
+#include <span>
+
+namespace concepts {
+
+// clang-format off
+template<typename T>
+concept HasUpwardArcs = requires(const T& graph, common::NodeID id)
+{
+	/*
+	 * @return the number of nodes
+	 */
+	{graph.numberOfNodes()} noexcept -> std::same_as<std::size_t>;
+
+	/**
+	 * @return the arcs from the node associated with the given id to higher nodes
+	 */
+	{graph.getForwardArcsOf(id)} noexcept -> std::same_as<std::span<const graphs::CHArc>>;
+
+	/**
+	 * @return the arcs from higher nodes to the node associated with the given id,
+	 * the target of such an arc is the higher node
+	 */
+	{graph.getBackwardArcsOf(id)} noexcept -> std::same_as<std::span<const graphs::CHArc>>;
+
+	{graph.getNodeLevelUnsafe(id)} noexcept -> std::convertible_to<common::NodeLevel>;
+};
+// clang-format on
+
+} // namespace concepts
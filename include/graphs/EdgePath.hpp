@@ -0,0 +1,273 @@
+#pragma once
+
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/Nodes.hpp>
+#include <concepts/Path.hpp>
+#include <graphs/Path.hpp>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <utils/Polyline.hpp>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * a path stored as the sequence of the ids of its original edges, node ids and
+ * coordinates are not stored but looked up in the graph while iterating over the path.
+ * the path refers to the graph it was calculated on, which has to outlive it
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasEdges<Graph>
+      && concepts::HasSource<typename Graph::EdgeType>
+      && concepts::HasTarget<typename Graph::EdgeType>
+// clang-format on
+class EdgePath
+{
+    struct NodeIDProjection
+    {
+        constexpr auto operator()(common::NodeID id) const noexcept
+            -> common::NodeID
+        {
+            return id;
+        }
+    };
+
+    struct CoordinateProjection
+    {
+        auto operator()(common::NodeID id) const noexcept
+            -> std::pair<common::Latitude, common::Longitude>
+        {
+            const auto node = graph_->getNode(id);
+            return std::pair{node->getLat(), node->getLng()};
+        }
+
+        const Graph* graph_;
+    };
+
+public:
+    /**
+     * single pass range over the nodes of the path, every node is projected when it is read
+     */
+    template<class Projection>
+    class NodeRange
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::invoke_result_t<Projection, common::NodeID>;
+
+            Iterator() noexcept = default;
+
+            Iterator(const EdgePath* path, Projection projection) noexcept
+                : path_(path),
+                  projection_(projection) {}
+
+            [[nodiscard]] auto operator*() const noexcept
+                -> value_type
+            {
+                return projection_(path_->nodeAt(idx_));
+            }
+
+            auto operator++() noexcept
+                -> Iterator&
+            {
+                idx_++;
+                return *this;
+            }
+
+            auto operator++(int) noexcept
+                -> void
+            {
+                idx_++;
+            }
+
+            [[nodiscard]] auto operator==(std::default_sentinel_t) const noexcept
+                -> bool
+            {
+                return idx_ == path_->numberOfNodes();
+            }
+
+        private:
+            const EdgePath* path_ = nullptr;
+            Projection projection_;
+            std::size_t idx_ = 0;
+        };
+
+        NodeRange(const EdgePath* path, Projection projection) noexcept
+            : path_(path),
+              projection_(projection) {}
+
+        [[nodiscard]] auto begin() const noexcept
+            -> Iterator
+        {
+            return Iterator{path_, projection_};
+        }
+
+        [[nodiscard]] constexpr auto end() const noexcept
+            -> std::default_sentinel_t
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        const EdgePath* path_;
+        Projection projection_;
+    };
+
+    /**
+     * the edges have to be edges of the original graph, i.e. no shortcuts,
+     * and the target of every edge has to be the source of the next one
+     */
+    EdgePath(const Graph& graph,
+             common::NodeID source,
+             std::vector<common::EdgeID> edges,
+             common::Weight cost) noexcept
+        : graph_(&graph),
+          source_(source),
+          edges_(std::move(edges)),
+          cost_(cost)
+    {
+        static_assert(concepts::Path<EdgePath>,
+                      "EdgePath should fullfill the Path concept");
+    }
+
+    EdgePath(const EdgePath&) noexcept = default;
+    EdgePath(EdgePath&&) noexcept = default;
+    auto operator=(const EdgePath&) noexcept -> EdgePath& = default;
+    auto operator=(EdgePath&&) noexcept -> EdgePath& = default;
+
+    [[nodiscard]] auto operator==(const EdgePath& other) const noexcept
+        -> bool
+    {
+        return source_ == other.source_ and edges_ == other.edges_;
+    }
+
+    [[nodiscard]] auto operator!=(const EdgePath& other) const noexcept
+        -> bool
+    {
+        return !(*this == other);
+    }
+
+    [[nodiscard]] auto numberOfNodes() const noexcept
+        -> std::size_t
+    {
+        return edges_.size() + 1;
+    }
+
+    [[nodiscard]] auto numberOfEdges() const noexcept
+        -> std::size_t
+    {
+        return edges_.size();
+    }
+
+    [[nodiscard]] auto source() const noexcept
+        -> std::optional<common::NodeID>
+    {
+        return source_;
+    }
+
+    [[nodiscard]] auto target() const noexcept
+        -> std::optional<common::NodeID>
+    {
+        return nodeAt(edges_.size());
+    }
+
+    [[nodiscard]] auto cost() const noexcept
+        -> common::Weight
+    {
+        return cost_;
+    }
+
+    [[nodiscard]] auto edgeIDs() const noexcept
+        -> std::span<const common::EdgeID>
+    {
+        return edges_;
+    }
+
+    [[nodiscard]] auto nodeIDs() const noexcept
+        -> NodeRange<NodeIDProjection>
+    {
+        return NodeRange{this, NodeIDProjection{}};
+    }
+
+    // clang-format off
+    /**
+     * @returns a range of the lat/lng pairs of the nodes of the path
+     */
+    [[nodiscard]] auto coordinates() const noexcept
+        -> NodeRange<CoordinateProjection>
+    requires concepts::HasNontrivialNodes<Graph>
+          && concepts::HasLatLng<typename Graph::NodeType>
+    // clang-format on
+    {
+        return NodeRange{this, CoordinateProjection{graph_}};
+    }
+
+    // clang-format off
+    /**
+     * appends the encoded polyline of the path to out, such that a response buffer
+     * can be reused over many queries
+     */
+    auto appendPolylineTo(std::string& out, int precision = 5) const noexcept
+        -> void
+    requires concepts::HasNontrivialNodes<Graph>
+          && concepts::HasLatLng<typename Graph::NodeType>
+    // clang-format on
+    {
+        util::appendPolyline(out, coordinates(), precision);
+    }
+
+    // clang-format off
+    [[nodiscard]] auto toPolyline(int precision = 5) const noexcept
+        -> std::string
+    requires concepts::HasNontrivialNodes<Graph>
+          && concepts::HasLatLng<typename Graph::NodeType>
+    // clang-format on
+    {
+        std::string out;
+        appendPolylineTo(out, precision);
+        return out;
+    }
+
+    /**
+     * materializes the node ids for consumers of the node based path
+     */
+    [[nodiscard]] auto toPath() const noexcept
+        -> Path
+    {
+        std::vector<common::NodeID> nodes;
+        nodes.reserve(numberOfNodes());
+        for(const auto id : nodeIDs()) {
+            nodes.emplace_back(id);
+        }
+
+        return Path{std::move(nodes), cost_};
+    }
+
+private:
+    [[nodiscard]] auto nodeAt(std::size_t idx) const noexcept
+        -> common::NodeID
+    {
+        if(idx == 0) {
+            return source_;
+        }
+
+        return graph_->getEdge(edges_[idx - 1])->getTrg();
+    }
+
+private:
+    const Graph* graph_;
+    common::NodeID source_;
+    std::vector<common::EdgeID> edges_;
+    common::Weight cost_;
+};
+
+} // namespace graphs
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <common/BasicGraphTypes.hpp>
+#include <common/EmptyBase.hpp>
+#include <common/Parsing.hpp>
+#include <common/Tokenizer.hpp>
+#include <concepts/EdgeWeights.hpp>
+#include <concepts/Edges.hpp>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+namespace graphs {
+
+namespace impl {
+
+/**
+ * the children of a shortcut packed into two 32 bit edge ids,
+ * edges which are no shortcuts store NO_SHORTCUT in both fields
+ */
+class PackedShortcutBase
+{
+public:
+    constexpr PackedShortcutBase() noexcept = default;
+
+    constexpr PackedShortcutBase(common::EdgeID first,
+                                 common::EdgeID second) noexcept
+        : first_(static_cast<std::uint32_t>(first.get())),
+          second_(static_cast<std::uint32_t>(second.get())) {}
+
+    constexpr auto getShortcut() const noexcept
+        -> std::optional<std::pair<common::EdgeID, common::EdgeID>>
+    {
+        if(!isShortcut()) {
+            return std::nullopt;
+        }
+
+        return getShortcutUnsafe();
+    }
+
+    constexpr auto getShortcutUnsafe() const noexcept
+        -> std::pair<common::EdgeID, common::EdgeID>
+    {
+        return std::pair{common::EdgeID{first_},
+                         common::EdgeID{second_}};
+    }
+
+    constexpr auto setShortcut(common::EdgeID first, common::EdgeID second) noexcept
+        -> void
+    {
+        first_ = static_cast<std::uint32_t>(first.get());
+        second_ = static_cast<std::uint32_t>(second.get());
+    }
+
+    constexpr auto isShortcut() const noexcept
+        -> bool
+    {
+        return first_ != NO_SHORTCUT;
+    }
+
+private:
+    constexpr static inline std::uint32_t NO_SHORTCUT = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t first_ = NO_SHORTCUT;
+    std::uint32_t second_ = NO_SHORTCUT;
+};
+
+} // namespace impl
+
+/**
+ * the same edge as FMIEdge but with 32 bit node ids and weights and 16 bit speed and type.
+ * a query only touches the first 12 bytes, the edge is 16 bytes without and 24 bytes
+ * with shortcuts instead of 48 and 72 bytes of the FMIEdge.
+ * parsing fails for values which do not fit into the packed fields
+ */
+template<bool HasShortcuts>
+class PackedFMIEdge : public std::conditional_t<HasShortcuts,
+                                                impl::PackedShortcutBase,
+                                                common::EmptyBase1>
+{
+    constexpr auto checkConcepts()
+    {
+        static_assert(concepts::HasSource<PackedFMIEdge>, "PackedFMIEdge should fullfill the HasSource concept");
+        static_assert(concepts::HasTarget<PackedFMIEdge>, "PackedFMIEdge should fullfill the HasTarget concept");
+        static_assert(concepts::HasWeight<PackedFMIEdge>, "PackedFMIEdge should fullfill the HasWeight concept");
+        static_assert(!HasShortcuts || concepts::CanHaveShortcuts<PackedFMIEdge>,
+                      "PackedFMIEdge should fullfill the CanHaveShortcuts concept if it has shortcuts");
+    }
+
+public:
+    constexpr PackedFMIEdge(common::NodeID src,
+                            common::NodeID trg,
+                            common::Weight cost,
+                            common::Speed speed,
+                            common::Type type) noexcept
+        : src_(static_cast<std::uint32_t>(src.get())),
+          trg_(static_cast<std::uint32_t>(trg.get())),
+          weight_(static_cast<std::uint32_t>(cost.get())),
+          speed_(static_cast<std::int16_t>(speed.get())),
+          type_(static_cast<std::int16_t>(type.get()))
+    {
+        checkConcepts();
+    }
+
+    constexpr PackedFMIEdge(common::NodeID src,
+                            common::NodeID trg,
+                            common::Weight cost,
+                            common::Speed speed,
+                            common::Type type,
+                            common::EdgeID first_shortcut,
+                            common::EdgeID second_shortcut) noexcept requires HasShortcuts
+        : impl::PackedShortcutBase(first_shortcut, second_shortcut),
+          src_(static_cast<std::uint32_t>(src.get())),
+          trg_(static_cast<std::uint32_t>(trg.get())),
+          weight_(static_cast<std::uint32_t>(cost.get())),
+          speed_(static_cast<std::int16_t>(speed.get())),
+          type_(static_cast<std::int16_t>(type.get()))
+    {
+        checkConcepts();
+    }
+
+    constexpr auto getSrc() const noexcept
+        -> common::NodeID
+    {
+        return common::NodeID{src_};
+    }
+
+    constexpr auto setSrc(common::NodeID src) noexcept
+        -> void
+    {
+        src_ = static_cast<std::uint32_t>(src.get());
+    }
+
+    constexpr auto getTrg() const noexcept
+        -> common::NodeID
+    {
+        return common::NodeID{trg_};
+    }
+
+    constexpr auto setTrg(common::NodeID trg) noexcept
+        -> void
+    {
+        trg_ = static_cast<std::uint32_t>(trg.get());
+    }
+
+    constexpr auto getWeight() const noexcept
+        -> common::Weight
+    {
+        return common::Weight{weight_};
+    }
+
+    constexpr auto getSpeed() const noexcept
+        -> common::Speed
+    {
+        return common::Speed{speed_};
+    }
+
+    constexpr auto getEdgeType() const noexcept
+        -> common::Type
+    {
+        return common::Type{type_};
+    }
+
+    static auto parse(std::string_view str) noexcept
+        -> std::optional<PackedFMIEdge>
+    requires(!HasShortcuts)
+    // clang-format on
+    {
+        const auto [src, trg, cost, type, speed] = common::extractFirstN<5>(str, " ");
+
+        const auto src_opt = common::to<common::NodeID>(src);
+        const auto trg_opt = common::to<common::NodeID>(trg);
+        const auto cost_opt = common::to<common::Weight>(cost);
+        const auto speed_opt = common::to<common::Speed>(speed);
+        const auto type_opt = common::to<common::Type>(type);
+
+        if(!src_opt or !trg_opt or !cost_opt or !speed_opt or !type_opt) {
+            return std::nullopt;
+        }
+
+        if(!fits(src_opt.value(), trg_opt.value(), cost_opt.value(), speed_opt.value(), type_opt.value())) {
+            return std::nullopt;
+        }
+
+        return PackedFMIEdge<HasShortcuts>{src_opt.value(),
+                                           trg_opt.value(),
+                                           cost_opt.value(),
+                                           speed_opt.value(),
+                                           type_opt.value()};
+    }
+
+    static auto parse(std::string_view str) noexcept
+        -> std::optional<PackedFMIEdge>
+    requires HasShortcuts
+    // clang-format on
+    {
+        const auto [src, trg, cost, type, speed, first_sc, second_sc] = common::extractFirstN<7>(str, " ");
+
+        // clang-format off
+        const auto src_opt       = common::to<common::NodeID>(src);
+        const auto trg_opt       = common::to<common::NodeID>(trg);
+        const auto cost_opt      = common::to<common::Weight>(cost);
+        const auto speed_opt     = common::to<common::Speed>(speed);
+        const auto type_opt      = common::to<common::Type>(type);
+        const auto first_sc_opt  = common::to<common::EdgeID>(first_sc);
+        const auto second_sc_opt = common::to<common::EdgeID>(second_sc);
+        // clang-format on
+
+        if(!src_opt or !trg_opt or !cost_opt or !speed_opt or !type_opt) {
+            return std::nullopt;
+        }
+
+        if(!first_sc_opt xor !second_sc_opt) {
+            return std::nullopt;
+        }
+
+        if(!fits(src_opt.value(), trg_opt.value(), cost_opt.value(), speed_opt.value(), type_opt.value())) {
+            return std::nullopt;
+        }
+
+        if(!first_sc_opt and !second_sc_opt) {
+            return PackedFMIEdge<HasShortcuts>{src_opt.value(),
+                                               trg_opt.value(),
+                                               cost_opt.value(),
+                                               speed_opt.value(),
+                                               type_opt.value()};
+        }
+
+        // the largest 32 bit value marks edges without shortcut
+        if(first_sc_opt.value().get() >= std::numeric_limits<std::uint32_t>::max()
+           or second_sc_opt.value().get() >= std::numeric_limits<std::uint32_t>::max()) {
+            return std::nullopt;
+        }
+
+        return PackedFMIEdge<HasShortcuts>{src_opt.value(),
+                                           trg_opt.value(),
+                                           cost_opt.value(),
+                                           speed_opt.value(),
+                                           type_opt.value(),
+                                           first_sc_opt.value(),
+                                           second_sc_opt.value()};
+    }
+
+private:
+    [[nodiscard]] static constexpr auto fits(common::NodeID src,
+                                             common::NodeID trg,
+                                             common::Weight cost,
+                                             common::Speed speed,
+                                             common::Type type) noexcept
+        -> bool
+    {
+        constexpr auto max_u32 = std::numeric_limits<std::uint32_t>::max();
+        constexpr auto min_i16 = std::numeric_limits<std::int16_t>::min();
+        constexpr auto max_i16 = std::numeric_limits<std::int16_t>::max();
+
+        // clang-format off
+        return src.get() <= max_u32
+            and trg.get() <= max_u32
+            and cost.get() >= 0 and cost.get() <= max_u32
+            and speed.get() >= min_i16 and speed.get() <= max_i16
+            and type.get() >= min_i16 and type.get() <= max_i16;
+        // clang-format on
+    }
+
+    // clang-format off
+private:
+    std::uint32_t src_;
+    std::uint32_t trg_;
+    std::uint32_t weight_;
+    std::int16_t speed_;
+    std::int16_t type_;
+    // clang-format on
+};
+
+static_assert(sizeof(PackedFMIEdge<false>) == 16,
+              "PackedFMIEdge<false> should be 16 bytes");
+
+static_assert(sizeof(PackedFMIEdge<true>) == 24,
+              "PackedFMIEdge<true> should be 24 bytes");
+
+} // namespace graphs
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <concepts/Parseable.hpp>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace graphs {
+
+/**
+ * marks a node type to be stored column wise by an offsetarray, i.e. every attribute of the
+ * nodes lives in its own array. a columnar node is the wrapped node itself and is parsed like it.
+ * if FixedPointCoordinates is set the coordinates are stored as int32 with 7 decimal places
+ */
+template<class Node, bool FixedPointCoordinates = false>
+class ColumnarNode : public Node
+{
+public:
+    using RowType = Node;
+    constexpr static inline bool has_fixed_point_coordinates = FixedPointCoordinates;
+
+    using Node::Node;
+
+    constexpr ColumnarNode(Node node) noexcept
+        : Node(std::move(node)) {}
+
+    // clang-format off
+    static auto parse(std::string_view str) noexcept
+        -> std::optional<ColumnarNode>
+        requires concepts::Parseable<Node>
+    // clang-format on
+    {
+        if(auto node_opt = Node::parse(str)) {
+            return ColumnarNode{std::move(node_opt.value())};
+        }
+
+        return std::nullopt;
+    }
+};
+
+template<class T>
+constexpr inline bool is_columnar_node = false;
+
+template<class Node, bool FixedPointCoordinates>
+constexpr inline bool is_columnar_node<ColumnarNode<Node, FixedPointCoordinates>> = true;
+
+} // namespace graphs
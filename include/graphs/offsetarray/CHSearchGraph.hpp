@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/NodeLevels.hpp>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * an arc of a ch search graph, the target and the weight are stored inline
+ * such that relaxing an arc does not touch any other array
+ */
+class CHArc
+{
+public:
+    constexpr CHArc() noexcept = default;
+
+    constexpr CHArc(common::NodeID trg, common::Weight weight) noexcept
+        : trg_(trg),
+          weight_(weight) {}
+
+    [[nodiscard]] constexpr auto getTrg() const noexcept
+        -> common::NodeID
+    {
+        return trg_;
+    }
+
+    [[nodiscard]] constexpr auto getWeight() const noexcept
+        -> common::Weight
+    {
+        return weight_;
+    }
+
+private:
+    common::NodeID trg_ = common::UNKNOWN_NODE_ID;
+    common::Weight weight_ = common::INFINITY_WEIGHT;
+};
+
+/**
+ * the search graph of a contraction hierarchy. it only holds the arcs a ch query relaxes,
+ * the forward arcs of a node lead to higher nodes and the backward arcs of a node come from
+ * higher nodes. the nodes are numbered by rank, i.e. sorted by level descending, such that
+ * the graph can directly be used by PHAST and the HubLabelCalculator. queries use the ranks
+ * as node ids, getRankOf and getOriginalNodeOf translate between the ranks and the node ids
+ * of the graph the search graph was built from.
+ * everything needed to unpack the shortcuts is kept in side arrays which are never
+ * touched by the queries
+ */
+class CHSearchGraph
+{
+public:
+    constexpr static inline std::size_t NO_ARC = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * the unpacking info of an arc, the original edge id refers to the graph the search graph
+     * was built from. a shortcut u->w over v consists of the edge u->v, which comes from the
+     * higher node u and therefore is a backward arc of v, and of the edge v->w, which leads to
+     * the higher node w and therefore is a forward arc of v
+     */
+    struct ArcInfo
+    {
+        common::EdgeID original_edge_ = common::UNKNOWN_EDGE_ID;
+        std::size_t backward_child_ = NO_ARC;
+        std::size_t forward_child_ = NO_ARC;
+    };
+
+    // clang-format off
+    template<class Graph>
+    requires concepts::HasEdges<Graph>
+          && concepts::ReadableNodeLevels<Graph>
+          && concepts::HasSource<typename Graph::EdgeType>
+          && concepts::HasTarget<typename Graph::EdgeType>
+          && concepts::HasWeight<typename Graph::EdgeType>
+    // clang-format on
+    explicit CHSearchGraph(const Graph& graph) noexcept
+    {
+        const auto number_of_nodes = graph.numberOfNodes();
+        const auto number_of_edges = graph.numberOfEdges();
+
+        // sort by level descending and keep the current order inside of a level,
+        // which is the same order prepareGraphForPHAST produces
+        original_of_.reserve(number_of_nodes);
+        for(std::size_t n = 0; n < number_of_nodes; n++) {
+            original_of_.emplace_back(n);
+        }
+
+        std::stable_sort(std::begin(original_of_),
+                         std::end(original_of_),
+                         [&](const auto lhs, const auto rhs) {
+                             return graph.getNodeLevelUnsafe(lhs) > graph.getNodeLevelUnsafe(rhs);
+                         });
+
+        rank_of_.resize(number_of_nodes);
+        levels_.reserve(number_of_nodes);
+        for(std::size_t rank = 0; rank < number_of_nodes; rank++) {
+            rank_of_[original_of_[rank].get()] = common::NodeID{rank};
+            levels_.emplace_back(graph.getNodeLevelUnsafe(original_of_[rank]));
+        }
+
+        // edges between nodes of the same level are arcs in both directions,
+        // as it is done by prepareGraphForCHDijkstra
+        std::vector<std::vector<std::pair<CHArc, common::EdgeID>>> forward_lists(number_of_nodes);
+        std::vector<std::vector<std::pair<CHArc, common::EdgeID>>> backward_lists(number_of_nodes);
+
+        for(std::size_t i = 0; i < number_of_edges; i++) {
+            const auto* edge = graph.getEdge(common::EdgeID{i});
+            const auto src = edge->getSrc();
+            const auto trg = edge->getTrg();
+            const auto src_lvl = graph.getNodeLevelUnsafe(src);
+            const auto trg_lvl = graph.getNodeLevelUnsafe(trg);
+            const auto src_rank = rank_of_[src.get()];
+            const auto trg_rank = rank_of_[trg.get()];
+
+            if(src_lvl <= trg_lvl) {
+                forward_lists[src_rank.get()].emplace_back(CHArc{trg_rank, edge->getWeight()},
+                                                           common::EdgeID{i});
+            }
+
+            if(src_lvl >= trg_lvl) {
+                backward_lists[trg_rank.get()].emplace_back(CHArc{src_rank, edge->getWeight()},
+                                                            common::EdgeID{i});
+            }
+        }
+
+        std::vector<std::size_t> forward_arc_of(number_of_edges, NO_ARC);
+        std::vector<std::size_t> backward_arc_of(number_of_edges, NO_ARC);
+
+        flatten(std::move(forward_lists), forward_offset_, forward_arcs_, forward_info_, forward_arc_of);
+        flatten(std::move(backward_lists), backward_offset_, backward_arcs_, backward_info_, backward_arc_of);
+
+        if constexpr(concepts::CanHaveShortcuts<typename Graph::EdgeType>) {
+            const auto link_children = [&](auto& infos) {
+                for(auto& info : infos) {
+                    const auto shortcut = graph.getEdge(info.original_edge_)->getShortcut();
+                    if(!shortcut) {
+                        continue;
+                    }
+
+                    const auto [first, second] = shortcut.value();
+                    info.backward_child_ = backward_arc_of[first.get()];
+                    info.forward_child_ = forward_arc_of[second.get()];
+                }
+            };
+
+            link_children(forward_info_);
+            link_children(backward_info_);
+        }
+    }
+
+    CHSearchGraph(CHSearchGraph&&) noexcept = default;
+    CHSearchGraph(const CHSearchGraph&) noexcept = default;
+
+    auto operator=(CHSearchGraph&&) noexcept
+        -> CHSearchGraph& = default;
+
+    auto operator=(const CHSearchGraph&) noexcept
+        -> CHSearchGraph& = default;
+
+    [[nodiscard]] constexpr auto nodeExists(common::NodeID id) const noexcept
+        -> bool
+    {
+        return id.get() < numberOfNodes();
+    }
+
+    [[nodiscard]] constexpr auto numberOfNodes() const noexcept
+        -> std::size_t
+    {
+        return levels_.size();
+    }
+
+    [[nodiscard]] constexpr auto numberOfForwardArcs() const noexcept
+        -> std::size_t
+    {
+        return forward_arcs_.size();
+    }
+
+    [[nodiscard]] constexpr auto numberOfBackwardArcs() const noexcept
+        -> std::size_t
+    {
+        return backward_arcs_.size();
+    }
+
+    /**
+     * @returns the arcs from the given node to higher nodes, sorted by their target
+     */
+    [[nodiscard]] constexpr auto getForwardArcsOf(common::NodeID node) const noexcept
+        -> std::span<const CHArc>
+    {
+        if(!nodeExists(node)) {
+            return {};
+        }
+
+        const auto first = forward_offset_[node.get()];
+        const auto last = forward_offset_[node.get() + 1];
+        return std::span{forward_arcs_}.subspan(first, last - first);
+    }
+
+    /**
+     * @returns the arcs from higher nodes to the given node, the target of such an arc is the
+     * higher node. they are sorted by their target, i.e. the highest node comes first
+     */
+    [[nodiscard]] constexpr auto getBackwardArcsOf(common::NodeID node) const noexcept
+        -> std::span<const CHArc>
+    {
+        if(!nodeExists(node)) {
+            return {};
+        }
+
+        const auto first = backward_offset_[node.get()];
+        const auto last = backward_offset_[node.get() + 1];
+        return std::span{backward_arcs_}.subspan(first, last - first);
+    }
+
+    [[nodiscard]] constexpr auto getNodeLevel(common::NodeID node) const noexcept
+        -> std::optional<common::NodeLevel>
+    {
+        if(nodeExists(node)) {
+            return levels_[node.get()];
+        }
+
+        return std::nullopt;
+    }
+
+    [[nodiscard]] constexpr auto getNodeLevelUnsafe(common::NodeID node) const noexcept
+        -> common::NodeLevel
+    {
+        return levels_[node.get()];
+    }
+
+    /**
+     * @returns the rank of a node of the graph the search graph was built from
+     */
+    [[nodiscard]] constexpr auto getRankOf(common::NodeID original) const noexcept
+        -> common::NodeID
+    {
+        return rank_of_[original.get()];
+    }
+
+    [[nodiscard]] constexpr auto getOriginalNodeOf(common::NodeID rank) const noexcept
+        -> common::NodeID
+    {
+        return original_of_[rank.get()];
+    }
+
+    /**
+     * the arc has to be an element of a span returned by getForwardArcsOf
+     * @returns the ids of the non shortcut edges of the original graph the arc consists of
+     */
+    [[nodiscard]] auto unpackForwardArc(const CHArc& arc) const noexcept
+        -> std::vector<common::EdgeID>
+    {
+        const auto idx = static_cast<std::size_t>(&arc - forward_arcs_.data());
+        return unpack(false, idx);
+    }
+
+    /**
+     * the arc has to be an element of a span returned by getBackwardArcsOf
+     * @returns the ids of the non shortcut edges of the original graph the arc consists of
+     */
+    [[nodiscard]] auto unpackBackwardArc(const CHArc& arc) const noexcept
+        -> std::vector<common::EdgeID>
+    {
+        const auto idx = static_cast<std::size_t>(&arc - backward_arcs_.data());
+        return unpack(true, idx);
+    }
+
+private:
+    static auto flatten(std::vector<std::vector<std::pair<CHArc, common::EdgeID>>> lists,
+                        std::vector<std::size_t>& offset,
+                        std::vector<CHArc>& arcs,
+                        std::vector<ArcInfo>& infos,
+                        std::vector<std::size_t>& arc_of) noexcept
+        -> void
+    {
+        offset.resize(lists.size() + 1, 0);
+
+        for(std::size_t n = 0; n < lists.size(); n++) {
+            auto& list = lists[n];
+            std::sort(std::begin(list),
+                      std::end(list),
+                      [](const auto& lhs, const auto& rhs) {
+                          return lhs.first.getTrg() < rhs.first.getTrg();
+                      });
+
+            for(const auto& [arc, edge_id] : list) {
+                arc_of[edge_id.get()] = arcs.size();
+                arcs.emplace_back(arc);
+                infos.push_back(ArcInfo{edge_id, NO_ARC, NO_ARC});
+            }
+
+            offset[n + 1] = arcs.size();
+            list = {};
+        }
+    }
+
+    [[nodiscard]] auto unpack(bool backward, std::size_t idx) const noexcept
+        -> std::vector<common::EdgeID>
+    {
+        std::vector<common::EdgeID> edges;
+        std::vector<std::pair<bool, std::size_t>> stack{{backward, idx}};
+
+        while(!stack.empty()) {
+            const auto [is_backward, arc] = stack.back();
+            stack.pop_back();
+
+            const auto& info = is_backward ? backward_info_[arc] : forward_info_[arc];
+
+            if(info.backward_child_ == NO_ARC or info.forward_child_ == NO_ARC) {
+                edges.emplace_back(info.original_edge_);
+                continue;
+            }
+
+            // the second child is pushed first such that the first child is unpacked first
+            stack.emplace_back(false, info.forward_child_);
+            stack.emplace_back(true, info.backward_child_);
+        }
+
+        return edges;
+    }
+
+private:
+    // hot arrays used by the queries
+    std::vector<std::size_t> forward_offset_;
+    std::vector<CHArc> forward_arcs_;
+    std::vector<std::size_t> backward_offset_;
+    std::vector<CHArc> backward_arcs_;
+    std::vector<common::NodeLevel> levels_;
+
+    // side arrays for unpacking and translating the results
+    std::vector<ArcInfo> forward_info_;
+    std::vector<ArcInfo> backward_info_;
+    std::vector<common::NodeID> rank_of_;
+    std::vector<common::NodeID> original_of_;
+};
+
+} // namespace graphs
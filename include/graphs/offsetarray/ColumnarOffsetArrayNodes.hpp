@@ -0,0 +1,393 @@
+#pragma once
+
+#include <cmath>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/NodeLevels.hpp>
+#include <concepts/Nodes.hpp>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utils/Permutation.hpp>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * node storage of an offsetarray over ColumnarNodes, every attribute lives in a column of its own.
+ * the attributes which are scanned by the algorithms, i.e. the coordinates and the level, are the
+ * hot columns, the second id and the elevation are cold columns which are only read on request.
+ * the nodes are accessed via proxies which read the attributes from the columns, complete nodes
+ * are only rebuilt when a proxy is converted to a node
+ */
+template<class Graph, class Node>
+class ColumnarOffsetArrayNodes
+{
+    constexpr static inline bool has_lat_lng = concepts::HasLatLng<Node>;
+    constexpr static inline bool has_level = concepts::HasLevel<Node>;
+    constexpr static inline bool has_fixed_point_coordinates = Node::has_fixed_point_coordinates;
+
+    constexpr static inline bool has_id2 = requires(const Node& node) {
+        { node.getID2() } -> std::convertible_to<common::NodeID>;
+    };
+
+    constexpr static inline bool has_elevation = requires(const Node& node) {
+        { node.getElevation() } -> std::convertible_to<common::Elevation>;
+    };
+
+    // coordinates are stored with 7 decimal places, which is a precision of about 1cm
+    // and keeps longitudes of up to 180 degrees in the range of an int32
+    constexpr static inline double FIXED_POINT_FACTOR = 1e7;
+
+public:
+    using NodeType = Node;
+    using Coordinate = std::conditional_t<has_fixed_point_coordinates, std::int32_t, double>;
+
+    /**
+     * proxy of a single node, the attributes are read from the columns
+     * and the node converts to a rebuilt complete node
+     */
+    class NodeRef
+    {
+    public:
+        constexpr NodeRef(const ColumnarOffsetArrayNodes* nodes, std::size_t idx) noexcept
+            : nodes_(nodes),
+              idx_(idx) {}
+
+        // clang-format off
+        [[nodiscard]] constexpr auto getLat() const noexcept
+            -> common::Latitude
+            requires has_lat_lng
+        // clang-format on
+        {
+            return common::Latitude{fromCoordinate(nodes_->lats_[idx_])};
+        }
+
+        // clang-format off
+        [[nodiscard]] constexpr auto getLng() const noexcept
+            -> common::Longitude
+            requires has_lat_lng
+        // clang-format on
+        {
+            return common::Longitude{fromCoordinate(nodes_->lngs_[idx_])};
+        }
+
+        // clang-format off
+        [[nodiscard]] constexpr auto getLvl() const noexcept
+            -> common::NodeLevel
+            requires has_level
+        // clang-format on
+        {
+            return nodes_->levels_[idx_];
+        }
+
+        // clang-format off
+        [[nodiscard]] constexpr auto getID2() const noexcept
+            -> common::NodeID
+            requires has_id2
+        // clang-format on
+        {
+            return nodes_->id2s_[idx_];
+        }
+
+        // clang-format off
+        [[nodiscard]] constexpr auto getElevation() const noexcept
+            -> common::Elevation
+            requires has_elevation
+        // clang-format on
+        {
+            return nodes_->elevations_[idx_];
+        }
+
+        /**
+         * @returns the complete node rebuilt from all columns, fixed point
+         * coordinates are rounded to 7 decimal places
+         */
+        [[nodiscard]] constexpr auto get() const noexcept
+            -> Node
+        {
+            return nodes_->rebuildNode(idx_);
+        }
+
+        constexpr operator Node() const noexcept
+        {
+            return get();
+        }
+
+    private:
+        const ColumnarOffsetArrayNodes* nodes_;
+        std::size_t idx_;
+    };
+
+    /**
+     * pointer like handle of a node returned by getNode, it is empty if the node does not exist
+     */
+    class NodePointer
+    {
+    public:
+        constexpr NodePointer() noexcept = default;
+
+        constexpr NodePointer(NodeRef ref) noexcept
+            : ref_(ref) {}
+
+        [[nodiscard]] constexpr explicit operator bool() const noexcept
+        {
+            return ref_.has_value();
+        }
+
+        [[nodiscard]] constexpr auto operator->() const noexcept
+            -> const NodeRef*
+        {
+            return &ref_.value();
+        }
+
+        [[nodiscard]] constexpr auto operator*() const noexcept
+            -> const NodeRef&
+        {
+            return ref_.value();
+        }
+
+    private:
+        std::optional<NodeRef> ref_;
+    };
+
+    ColumnarOffsetArrayNodes(std::vector<Node> nodes) noexcept
+        : number_of_nodes_(nodes.size())
+    {
+        static_assert(concepts::HasNodes<ColumnarOffsetArrayNodes>);
+        static_assert(concepts::HasNontrivialNodes<ColumnarOffsetArrayNodes>);
+        static_assert(concepts::HasAccessableNodes<ColumnarOffsetArrayNodes>);
+        static_assert(!has_level || concepts::WriteableNodeLevels<ColumnarOffsetArrayNodes>);
+
+        lats_.resize(has_lat_lng ? number_of_nodes_ : 0);
+        lngs_.resize(has_lat_lng ? number_of_nodes_ : 0);
+        levels_.resize(has_level ? number_of_nodes_ : 0, common::NodeLevel{0});
+        id2s_.resize(has_id2 ? number_of_nodes_ : 0, common::NodeID{0});
+        elevations_.resize(has_elevation ? number_of_nodes_ : 0, common::Elevation{0});
+
+        util::forEachIndex(number_of_nodes_, [&](const auto i) {
+            const auto& node = nodes[i];
+
+            if constexpr(has_lat_lng) {
+                lats_[i] = toCoordinate(node.getLat().get());
+                lngs_[i] = toCoordinate(node.getLng().get());
+            }
+
+            if constexpr(has_level) {
+                levels_[i] = node.getLvl();
+            }
+
+            if constexpr(has_id2) {
+                id2s_[i] = node.getID2();
+            }
+
+            if constexpr(has_elevation) {
+                elevations_[i] = node.getElevation();
+            }
+        });
+    }
+
+    ColumnarOffsetArrayNodes(ColumnarOffsetArrayNodes&&) noexcept = default;
+    ColumnarOffsetArrayNodes(const ColumnarOffsetArrayNodes&) noexcept = default;
+
+    auto operator=(ColumnarOffsetArrayNodes&&) noexcept
+        -> ColumnarOffsetArrayNodes& = default;
+
+    auto operator=(const ColumnarOffsetArrayNodes&) noexcept
+        -> ColumnarOffsetArrayNodes& = default;
+
+    constexpr auto nodeExists(common::NodeID id) const noexcept -> bool
+    {
+        return id.get() < numberOfNodes();
+    }
+
+    constexpr auto getNode(common::NodeID id) const noexcept -> NodePointer
+    {
+        if(nodeExists(id)) {
+            return NodeRef{this, id.get()};
+        }
+
+        return NodePointer{};
+    }
+
+    constexpr auto numberOfNodes() const noexcept -> std::size_t
+    {
+        return number_of_nodes_;
+    }
+
+    /**
+     * @returns a random access range of proxies of all nodes
+     */
+    auto getNodes() const noexcept
+    {
+        return std::views::iota(std::size_t{0}, numberOfNodes())
+            | std::views::transform([this](const auto idx) {
+                   return NodeRef{this, idx};
+               });
+    }
+
+    // clang-format off
+    constexpr auto getNodeLevel(common::NodeID id) const noexcept
+        -> std::optional<common::NodeLevel>
+        requires has_level
+    // clang-format on
+    {
+        if(nodeExists(id)) {
+            return levels_[id.get()];
+        }
+
+        return std::nullopt;
+    }
+
+    // clang-format off
+    constexpr auto getNodeLevelUnsafe(common::NodeID id) const noexcept
+        -> common::NodeLevel
+        requires has_level
+    // clang-format on
+    {
+        return levels_[id.get()];
+    }
+
+    // clang-format off
+    constexpr auto setNodeLevel(common::NodeID id, common::NodeLevel lvl) noexcept
+        -> void
+        requires has_level
+    // clang-format on
+    {
+        if(nodeExists(id)) {
+            levels_[id.get()] = lvl;
+        }
+    }
+
+    // clang-format off
+    [[nodiscard]] constexpr auto getNodeLevels() const noexcept
+        -> std::span<const common::NodeLevel>
+        requires has_level
+    // clang-format on
+    {
+        return levels_;
+    }
+
+    // clang-format off
+    /**
+     * @returns the latitude column, fixed point coordinates are scaled by 10^7
+     */
+    [[nodiscard]] constexpr auto getLatitudes() const noexcept
+        -> std::span<const Coordinate>
+        requires has_lat_lng
+    // clang-format on
+    {
+        return lats_;
+    }
+
+    // clang-format off
+    /**
+     * @returns the longitude column, fixed point coordinates are scaled by 10^7
+     */
+    [[nodiscard]] constexpr auto getLongitudes() const noexcept
+        -> std::span<const Coordinate>
+        requires has_lat_lng
+    // clang-format on
+    {
+        return lngs_;
+    }
+
+private:
+    [[nodiscard]] constexpr static auto toCoordinate(double value) noexcept
+        -> Coordinate
+    {
+        if constexpr(has_fixed_point_coordinates) {
+            return static_cast<std::int32_t>(std::lround(value * FIXED_POINT_FACTOR));
+        } else {
+            return value;
+        }
+    }
+
+    [[nodiscard]] constexpr static auto fromCoordinate(Coordinate value) noexcept
+        -> double
+    {
+        if constexpr(has_fixed_point_coordinates) {
+            return static_cast<double>(value) / FIXED_POINT_FACTOR;
+        } else {
+            return value;
+        }
+    }
+
+    // the node types which can be stored column wise are the FMINodes and the SimpleMapNodes
+    [[nodiscard]] constexpr auto rebuildNode(std::size_t idx) const noexcept
+        -> Node
+    {
+        const common::Latitude lat{fromCoordinate(lats_[idx])};
+        const common::Longitude lng{fromCoordinate(lngs_[idx])};
+
+        if constexpr(has_id2 and has_elevation and has_level) {
+            return Node{id2s_[idx], lat, lng, elevations_[idx], levels_[idx]};
+        } else if constexpr(has_id2 and has_elevation) {
+            return Node{id2s_[idx], lat, lng, elevations_[idx]};
+        } else if constexpr(has_level) {
+            return Node{lat, lng, levels_[idx]};
+        } else {
+            return Node{lat, lng};
+        }
+    }
+
+    /**
+     * node i gets the attributes of node perm[i], all columns are gathered
+     * in a single parallel pass over the nodes
+     */
+    auto permuteNodes(const std::vector<std::size_t>& perm) noexcept
+        -> void
+    {
+        const auto number_of_nodes = numberOfNodes();
+
+        std::vector<Coordinate> lats(has_lat_lng ? number_of_nodes : 0);
+        std::vector<Coordinate> lngs(has_lat_lng ? number_of_nodes : 0);
+        std::vector<common::NodeLevel> levels(has_level ? number_of_nodes : 0, common::NodeLevel{0});
+        std::vector<common::NodeID> id2s(has_id2 ? number_of_nodes : 0, common::NodeID{0});
+        std::vector<common::Elevation> elevations(has_elevation ? number_of_nodes : 0, common::Elevation{0});
+
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            const auto old_idx = perm[i];
+
+            if constexpr(has_lat_lng) {
+                lats[i] = lats_[old_idx];
+                lngs[i] = lngs_[old_idx];
+            }
+
+            if constexpr(has_level) {
+                levels[i] = levels_[old_idx];
+            }
+
+            if constexpr(has_id2) {
+                id2s[i] = id2s_[old_idx];
+            }
+
+            if constexpr(has_elevation) {
+                elevations[i] = elevations_[old_idx];
+            }
+        });
+
+        lats_ = std::move(lats);
+        lngs_ = std::move(lngs);
+        levels_ = std::move(levels);
+        id2s_ = std::move(id2s);
+        elevations_ = std::move(elevations);
+    }
+
+private:
+    friend Graph;
+
+    std::vector<Coordinate> lats_;
+    std::vector<Coordinate> lngs_;
+    std::vector<common::NodeLevel> levels_;
+
+    // cold columns
+    std::vector<common::NodeID> id2s_;
+    std::vector<common::Elevation> elevations_;
+
+    std::size_t number_of_nodes_;
+};
+
+} // namespace graphs
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <algorithm>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/BackwardConnections.hpp>
+#include <concepts/Edges.hpp>
+#include <concepts/ForwardConnections.hpp>
+#include <concepts/NodeLevels.hpp>
+#include <concepts/Nodes.hpp>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * every function in this file orders the nodes of a graph for memory locality.
+ * the node* functions return the rank of every node in the new order, the reorder*
+ * functions apply the order to the graph via sortNodesAccordingTo and return the
+ * permutation and the inverse permutation, which can be used to remap the node ids of
+ * oracles calculated on the old order, e.g. via HubLabelLookup::applyNodePermutation
+ */
+
+namespace impl {
+
+// the curve is calculated on a 2^16 x 2^16 grid
+constexpr static inline std::uint32_t HILBERT_GRID_SIZE = 1u << 16;
+
+[[nodiscard]] constexpr auto hilbertIndex(std::uint32_t x, std::uint32_t y) noexcept
+    -> std::uint64_t
+{
+    std::uint64_t d = 0;
+    for(std::uint32_t s = HILBERT_GRID_SIZE / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) > 0 ? 1 : 0;
+        const std::uint32_t ry = (y & s) > 0 ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+        // rotate the quadrant
+        if(ry == 0) {
+            if(rx == 1) {
+                x = HILBERT_GRID_SIZE - 1 - x;
+                y = HILBERT_GRID_SIZE - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+
+    return d;
+}
+
+template<class Graph>
+auto forEachNeighbourOf(const Graph& graph, common::NodeID node, auto&& func) noexcept
+    -> void
+{
+    if constexpr(concepts::ForwardConnections<Graph>) {
+        for(const auto id : graph.getForwardEdgeIDsOf(node)) {
+            func(graph.getEdge(id)->getTrg());
+        }
+    }
+
+    if constexpr(concepts::BackwardConnections<Graph>) {
+        for(const auto id : graph.getBackwardEdgeIDsOf(node)) {
+            func(graph.getBackwardEdge(id)->getTrg());
+        }
+    }
+}
+
+// wraps a rank vector into the comparator expected by sortNodesAccordingTo
+[[nodiscard]] inline auto byRank(std::vector<std::size_t> ranks) noexcept
+{
+    return [ranks = std::move(ranks)](const auto& /* graph */) {
+        return [&ranks](const auto lhs, const auto rhs) {
+            return ranks[lhs.get()] < ranks[rhs.get()];
+        };
+    };
+}
+
+} // namespace impl
+
+/**
+ * @returns the position of every node on a hilbert curve over the bounding box of all nodes
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasNodes<Graph>
+      && concepts::HasLatLng<typename Graph::NodeType>
+// clang-format on
+[[nodiscard]] auto nodeRanksByHilbertCurve(const Graph& graph) noexcept
+    -> std::vector<std::size_t>
+{
+    const auto number_of_nodes = graph.numberOfNodes();
+
+    auto min_lat = std::numeric_limits<double>::max();
+    auto max_lat = std::numeric_limits<double>::lowest();
+    auto min_lng = std::numeric_limits<double>::max();
+    auto max_lng = std::numeric_limits<double>::lowest();
+
+    for(std::size_t i = 0; i < number_of_nodes; i++) {
+        const auto node = graph.getNode(common::NodeID{i});
+        min_lat = std::min(min_lat, static_cast<double>(node->getLat().get()));
+        max_lat = std::max(max_lat, static_cast<double>(node->getLat().get()));
+        min_lng = std::min(min_lng, static_cast<double>(node->getLng().get()));
+        max_lng = std::max(max_lng, static_cast<double>(node->getLng().get()));
+    }
+
+    const auto to_grid = [](double value, double min, double max) {
+        if(max <= min) {
+            return std::uint32_t{0};
+        }
+        const auto scaled = (value - min) / (max - min) * (impl::HILBERT_GRID_SIZE - 1);
+        return static_cast<std::uint32_t>(scaled);
+    };
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> keys(number_of_nodes);
+    for(std::size_t i = 0; i < number_of_nodes; i++) {
+        const auto node = graph.getNode(common::NodeID{i});
+        const auto x = to_grid(static_cast<double>(node->getLng().get()), min_lng, max_lng);
+        const auto y = to_grid(static_cast<double>(node->getLat().get()), min_lat, max_lat);
+        keys[i] = std::pair{impl::hilbertIndex(x, y), i};
+    }
+
+    std::sort(std::begin(keys), std::end(keys));
+
+    std::vector<std::size_t> ranks(number_of_nodes);
+    for(std::size_t rank = 0; rank < number_of_nodes; rank++) {
+        ranks[keys[rank].second] = rank;
+    }
+
+    return ranks;
+}
+
+/**
+ * @returns the breadth first search visiting order starting at seed, edges are followed
+ * in both directions. nodes which are not reachable are visited by restarting the search
+ * at the smallest unvisited node
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasNodes<Graph>
+      && (concepts::ForwardConnections<Graph> || concepts::BackwardConnections<Graph>)
+// clang-format on
+[[nodiscard]] auto nodeRanksByBFS(const Graph& graph, common::NodeID seed) noexcept
+    -> std::vector<std::size_t>
+{
+    const auto number_of_nodes = graph.numberOfNodes();
+    constexpr auto unvisited = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t> ranks(number_of_nodes, unvisited);
+    std::size_t next_rank = 0;
+    std::size_t next_restart = 0;
+
+    std::queue<common::NodeID> queue;
+    auto start = seed;
+
+    while(next_rank < number_of_nodes) {
+        ranks[start.get()] = next_rank++;
+        queue.emplace(start);
+
+        while(!queue.empty()) {
+            const auto current = queue.front();
+            queue.pop();
+
+            impl::forEachNeighbourOf(graph, current, [&](const auto neig) {
+                if(ranks[neig.get()] == unvisited) {
+                    ranks[neig.get()] = next_rank++;
+                    queue.emplace(neig);
+                }
+            });
+        }
+
+        while(next_restart < number_of_nodes and ranks[next_restart] != unvisited) {
+            next_restart++;
+        }
+        start = common::NodeID{next_restart};
+    }
+
+    return ranks;
+}
+
+/**
+ * @returns the depth first search preorder starting at seed, edges are followed
+ * in both directions. nodes which are not reachable are visited by restarting the search
+ * at the smallest unvisited node
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasNodes<Graph>
+      && (concepts::ForwardConnections<Graph> || concepts::BackwardConnections<Graph>)
+// clang-format on
+[[nodiscard]] auto nodeRanksByDFS(const Graph& graph, common::NodeID seed) noexcept
+    -> std::vector<std::size_t>
+{
+    const auto number_of_nodes = graph.numberOfNodes();
+    constexpr auto unvisited = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t> ranks(number_of_nodes, unvisited);
+    std::size_t next_rank = 0;
+    std::size_t next_restart = 0;
+
+    std::vector<common::NodeID> stack;
+    auto start = seed;
+
+    while(next_rank < number_of_nodes) {
+        stack.emplace_back(start);
+
+        while(!stack.empty()) {
+            const auto current = stack.back();
+            stack.pop_back();
+
+            if(ranks[current.get()] != unvisited) {
+                continue;
+            }
+            ranks[current.get()] = next_rank++;
+
+            impl::forEachNeighbourOf(graph, current, [&](const auto neig) {
+                if(ranks[neig.get()] == unvisited) {
+                    stack.emplace_back(neig);
+                }
+            });
+        }
+
+        while(next_restart < number_of_nodes and ranks[next_restart] != unvisited) {
+            next_restart++;
+        }
+        start = common::NodeID{next_restart};
+    }
+
+    return ranks;
+}
+
+/**
+ * @returns a rank where nodes are ordered by level descending and nodes of the same level
+ * are ordered along a hilbert curve. the level order required by PHAST is preserved
+ */
+// clang-format off
+template<class Graph>
+requires concepts::ReadableNodeLevels<Graph>
+      && concepts::HasLatLng<typename Graph::NodeType>
+// clang-format on
+[[nodiscard]] auto nodeRanksByLevelThenHilbertCurve(const Graph& graph) noexcept
+    -> std::vector<std::size_t>
+{
+    const auto number_of_nodes = graph.numberOfNodes();
+    const auto hilbert_ranks = nodeRanksByHilbertCurve(graph);
+
+    std::vector<std::size_t> order(number_of_nodes);
+    std::iota(std::begin(order), std::end(order), 0);
+    std::sort(std::begin(order),
+              std::end(order),
+              [&](const auto lhs, const auto rhs) {
+                  const auto lhs_lvl = graph.getNodeLevelUnsafe(common::NodeID{lhs});
+                  const auto rhs_lvl = graph.getNodeLevelUnsafe(common::NodeID{rhs});
+                  if(lhs_lvl != rhs_lvl) {
+                      return lhs_lvl > rhs_lvl;
+                  }
+                  return hilbert_ranks[lhs] < hilbert_ranks[rhs];
+              });
+
+    std::vector<std::size_t> ranks(number_of_nodes);
+    for(std::size_t rank = 0; rank < number_of_nodes; rank++) {
+        ranks[order[rank]] = rank;
+    }
+
+    return ranks;
+}
+
+template<class Graph>
+auto reorderNodesByHilbertCurve(Graph& graph) noexcept
+    -> std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+{
+    return graph.sortNodesAccordingTo(impl::byRank(nodeRanksByHilbertCurve(graph)));
+}
+
+template<class Graph>
+auto reorderNodesByBFS(Graph& graph, common::NodeID seed = common::NodeID{0}) noexcept
+    -> std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+{
+    return graph.sortNodesAccordingTo(impl::byRank(nodeRanksByBFS(graph, seed)));
+}
+
+template<class Graph>
+auto reorderNodesByDFS(Graph& graph, common::NodeID seed = common::NodeID{0}) noexcept
+    -> std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+{
+    return graph.sortNodesAccordingTo(impl::byRank(nodeRanksByDFS(graph, seed)));
+}
+
+template<class Graph>
+auto reorderNodesByLevelThenHilbertCurve(Graph& graph) noexcept
+    -> std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+{
+    return graph.sortNodesAccordingTo(impl::byRank(nodeRanksByLevelThenHilbertCurve(graph)));
+}
+
+/**
+ * orders the edges by their source node, so that the edges scanned when settling
+ * consecutive nodes are stored next to each other. should be called after the nodes
+ * are reordered
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasEdges<Graph>
+      && concepts::HasSource<typename Graph::EdgeType>
+      && concepts::HasTarget<typename Graph::EdgeType>
+// clang-format on
+auto reorderEdgesBySource(Graph& graph) noexcept
+    -> std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+{
+    return graph.sortEdgesAccordingTo([](const auto& g) {
+        return [&g](const auto lhs, const auto rhs) {
+            const auto* lhs_edge = g.getEdge(lhs);
+            const auto* rhs_edge = g.getEdge(rhs);
+            return std::pair{lhs_edge->getSrc(), lhs_edge->getTrg()}
+            < std::pair{rhs_edge->getSrc(), rhs_edge->getTrg()};
+        };
+    });
+}
+
+} // namespace graphs
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <common/EmptyBase.hpp>
 #include <concepts/Parseable.hpp>
 #include <concepts/Permutable.hpp>
 #include <concepts/Sortable.hpp>
+#include <execution>
 #include <graphs/offsetarray/OffsetArrayBackwardGraph.hpp>
 #include <graphs/offsetarray/OffsetArrayEdges.hpp>
 #include <graphs/offsetarray/OffsetArrayForwardGraph.hpp>
 #include <graphs/offsetarray/OffsetArrayNodes.hpp>
+#include <numeric>
+#include <utils/Permutation.hpp>
 
 namespace graphs {
 
@@ -99,6 +103,11 @@ public:
     using NodeType = Node;
     using EdgeType = Edge;
 
+    // added edges are compacted once they are more than 1/COMPACTION_RATIO of all edges,
+    // but not before MIN_COMPACTION_SIZE edges are pending
+    constexpr static inline std::size_t COMPACTION_RATIO = 16;
+    constexpr static inline std::size_t MIN_COMPACTION_SIZE = 1024;
+
     OffsetArray(std::vector<Node> nodes,
                 std::vector<Edge> edges) noexcept
         requires HasForwardEdges &&(!HasBackwardEdges)
@@ -211,7 +220,6 @@ public:
         -> bool
     {
         const auto number_of_nodes = this->numberOfNodes();
-        const auto number_of_edges = this->numberOfEdges();
 
         if(number_of_nodes != perm.size() or number_of_nodes != inv_perm.size()) {
             return false;
@@ -219,46 +227,30 @@ public:
 
         // apply the permutation to the forward offsetarray
         if constexpr(concepts::ForwardConnections<OffsetArray>) {
-            std::vector<size_t> forward_offset(number_of_nodes + 1, 0);
-            std::vector<common::EdgeID> forward_neigbours;
-            forward_neigbours.reserve(number_of_edges);
-
-            for(size_t i = 0; i < number_of_nodes; i++) {
-                common::NodeID n{perm[i]};
-                const auto neigs = this->getForwardEdgeIDsOf(n);
-                forward_neigbours.insert(std::end(forward_neigbours),
-                                         std::begin(neigs),
-                                         std::end(neigs));
-
-                forward_offset[i + 1] = forward_neigbours.size();
-            }
+            auto [forward_offset, forward_neigbours] =
+                permuteConnections(perm, [&](const auto n) {
+                    return this->getForwardEdgeIDsOf(n);
+                });
             this->forward_offset_ = std::move(forward_offset);
             this->forward_neigbours_ = std::move(forward_neigbours);
+            this->dropForwardOverflow();
         }
 
         // apply the permutation to the backward offsetarray
         if constexpr(concepts::BackwardConnections<OffsetArray>) {
-            std::vector<size_t> backward_offset(number_of_nodes + 1, 0);
-            std::vector<common::EdgeID> backward_neigbours;
-            backward_neigbours.reserve(number_of_edges);
-
-
-            for(size_t i = 0; i < number_of_nodes; i++) {
-                common::NodeID n{perm[i]};
-                const auto neigs = this->getBackwardEdgeIDsOf(n);
-                backward_neigbours.insert(std::end(backward_neigbours),
-                                          std::begin(neigs),
-                                          std::end(neigs));
-
-                backward_offset[i + 1] = backward_neigbours.size();
-            }
+            auto [backward_offset, backward_neigbours] =
+                permuteConnections(perm, [&](const auto n) {
+                    return this->getBackwardEdgeIDsOf(n);
+                });
             this->backward_offset_ = std::move(backward_offset);
             this->backward_neigbours_ = std::move(backward_neigbours);
+            this->dropBackwardOverflow();
         }
 
         // update the sources and targets of edges in the graph
         if constexpr(concepts::HasEdges<OffsetArray>) {
-            for(auto& e : this->edges_) {
+            util::forEachIndex(this->edges_.size(), [&](const auto i) {
+                auto& e = this->edges_[i];
 
                 // update src if available
                 if constexpr(concepts::HasSource<EdgeType>) {
@@ -273,13 +265,12 @@ public:
                     auto new_trg = common::NodeID{inv_perm[current_trg.get()]};
                     e.setTrg(new_trg);
                 }
-            }
+            });
         }
 
-        // update the nodes_ array if available
+        // update the stored nodes if available
         if constexpr(!std::is_same_v<NodeType, common::NodeID>) {
-            this->nodes_ = util::applyPermutation(std::move(this->nodes_),
-                                                  std::move(perm));
+            this->permuteNodes(std::move(perm));
         }
 
         return true;
@@ -322,24 +313,17 @@ public:
             return false;
         }
 
+        // the ids in the overflow lists are remapped as part of the offsetarrays
+        compact();
+
         // apply the permutation to the forward connections
         if constexpr(HasForwardEdges) {
-            std::transform(std::begin(this->forward_neigbours_),
-                           std::end(this->forward_neigbours_),
-                           std::begin(this->forward_neigbours_),
-                           [&](auto id) {
-                               return common::EdgeID{inv_perm[id.get()]};
-                           });
+            util::remapIDs(this->forward_neigbours_, inv_perm);
         }
 
         // apply the permutation to the backward connections
         if constexpr(HasBackwardEdges) {
-            std::transform(std::begin(this->backward_neigbours_),
-                           std::end(this->backward_neigbours_),
-                           std::begin(this->backward_neigbours_),
-                           [&](auto id) {
-                               return common::EdgeID{inv_perm[id.get()]};
-                           });
+            util::remapIDs(this->backward_neigbours_, inv_perm);
         }
 
         this->edges_ = util::applyPermutation(std::move(this->edges_),
@@ -347,126 +331,118 @@ public:
 
         // permute the shortcuts
         if constexpr(concepts::CanHaveShortcuts<EdgeType>) {
-            for(auto& edge : this->edges_) {
+            util::forEachIndex(this->edges_.size(), [&](const auto i) {
+                auto& edge = this->edges_[i];
                 if(!edge.isShortcut()) {
-                    continue;
+                    return;
                 }
 
                 const auto [first, second] = edge.getShortcutUnsafe();
                 edge.setShortcut(common::EdgeID{inv_perm[first.get()]},
                                  common::EdgeID{inv_perm[second.get()]});
-            }
+            });
         }
 
         return true;
     }
 
+    /**
+     * the ids of the new edges are appended to overflow lists of their nodes instead of
+     * rebuilding the offsetarrays, the graph compacts itself once the overflow lists hold
+     * more than 1/COMPACTION_RATIO of all edges
+     */
     auto addEdges(std::vector<Edge> new_edges) noexcept
         -> void
     {
-        if constexpr(HasForwardEdges) {
-            addEdgesForward(new_edges);
-        }
+        const auto number_of_edges = this->numberOfEdges();
 
-        if constexpr(HasBackwardEdges) {
-            addEdgesBackward(new_edges);
+        for(std::size_t i = 0; i < new_edges.size(); i++) {
+            const common::EdgeID id{number_of_edges + i};
+
+            if constexpr(HasForwardEdges) {
+                this->insertForwardEdgeID(new_edges[i].getSrc(), id);
+            }
+
+            if constexpr(HasBackwardEdges) {
+                this->insertBackwardEdgeID(new_edges[i].getTrg(), id);
+            }
         }
 
         this->edges_.reserve(this->edges_.size() + new_edges.size());
         this->edges_.insert(std::end(this->edges_),
                             std::make_move_iterator(std::begin(new_edges)),
                             std::make_move_iterator(std::end(new_edges)));
+
+        const auto threshold = std::max(MIN_COMPACTION_SIZE, this->numberOfEdges() / COMPACTION_RATIO);
+        if(numberOfPendingEdges() > threshold) {
+            compact();
+        }
     }
 
-private:
-    auto addEdgesForward(const std::vector<Edge>& new_edges) noexcept
-        -> void requires HasForwardEdges
+    /**
+     * merges the edges added since the last compaction into the offsetarrays
+     */
+    auto compact() noexcept
+        -> void
     {
-        const auto number_of_nodes = this->numberOfNodes();
-        const auto number_of_edges = this->numberOfEdges();
-        const auto number_of_new_edges = new_edges.size();
-
-        const auto inv_perm = [&] {
-            std::vector<std::size_t> perm(new_edges.size(), 0);
-            std::iota(std::begin(perm), std::end(perm), 0);
-            std::sort(std::begin(perm), std::end(perm),
-                      [&](const auto lhs, const auto rhs) {
-                          const auto& lhs_edge = new_edges[lhs];
-                          const auto& rhs_edge = new_edges[rhs];
-                          const auto& lhs_src = lhs_edge.getSrc();
-                          const auto& rhs_src = rhs_edge.getSrc();
-                          return lhs_src < rhs_src;
-                      });
-            return perm;
-        }();
-
-
-        std::size_t idx = 0;
-        std::vector<size_t> forward_offset(number_of_nodes + 1, 0);
-        std::vector<common::EdgeID> forward_neigbours;
-        forward_neigbours.reserve(number_of_edges + number_of_new_edges);
-
-        for(size_t i = 0; i < number_of_nodes; i++) {
-            const auto current = common::NodeID{i};
-            const auto ids = this->getForwardEdgeIDsOf(current);
-
-            std::copy(std::begin(ids), std::end(ids),
-                      std::back_inserter(forward_neigbours));
-
-            while(idx < number_of_new_edges and new_edges[inv_perm[idx]].getSrc() == current) {
-                forward_neigbours.emplace_back(number_of_edges + inv_perm[idx]);
-                idx++;
-            }
-
-            forward_offset[i + 1] = forward_neigbours.size();
+        if constexpr(HasForwardEdges) {
+            this->compactForwardEdgeIDs();
         }
 
-        this->forward_offset_ = std::move(forward_offset);
-        this->forward_neigbours_ = std::move(forward_neigbours);
+        if constexpr(HasBackwardEdges) {
+            this->compactBackwardEdgeIDs();
+        }
     }
 
-    auto addEdgesBackward(const std::vector<Edge>& new_edges) noexcept
-        -> void requires HasBackwardEdges
+    /**
+     * @returns the number of edges which were added since the last compaction. both directions
+     * are counted, because deleting edge ids compacts only the direction it is called for
+     */
+    [[nodiscard]] auto numberOfPendingEdges() const noexcept
+        -> std::size_t
     {
-        const auto number_of_nodes = this->numberOfNodes();
-        const auto number_of_edges = this->numberOfEdges();
-        const auto number_of_new_edges = new_edges.size();
-
-        const auto inv_perm = [&] {
-            std::vector<std::size_t> perm(new_edges.size(), 0);
-            std::iota(std::begin(perm), std::end(perm), 0);
-            std::sort(std::begin(perm), std::end(perm),
-                      [&](const auto lhs, const auto rhs) {
-                          const auto& lhs_edge = new_edges[lhs];
-                          const auto& rhs_edge = new_edges[rhs];
-                          const auto& lhs_trg = lhs_edge.getTrg();
-                          const auto& rhs_trg = rhs_edge.getTrg();
-                          return lhs_trg < rhs_trg;
-                      });
-            return perm;
-        }();
-
-        std::size_t idx = 0;
-        std::vector<size_t> backward_offset(number_of_nodes + 1, 0);
-        std::vector<common::EdgeID> backward_neigbours;
-        backward_neigbours.reserve(number_of_edges + number_of_new_edges);
-
-        for(size_t i = 0; i < number_of_nodes; i++) {
-            const auto current = common::NodeID{i};
-            const auto ids = this->getBackwardEdgeIDsOf(current);
-
-            std::copy(std::begin(ids), std::end(ids),
-                      std::back_inserter(backward_neigbours));
-
-            while(idx < number_of_new_edges and new_edges[inv_perm[idx]].getTrg() == current) {
-                backward_neigbours.emplace_back(number_of_edges + inv_perm[idx]);
-                idx++;
-            }
-
-            backward_offset[i + 1] = backward_neigbours.size();
+        if constexpr(HasForwardEdges and HasBackwardEdges) {
+            return std::max(this->numberOfPendingForwardEdges(),
+                            this->numberOfPendingBackwardEdges());
+        } else if constexpr(HasForwardEdges) {
+            return this->numberOfPendingForwardEdges();
+        } else {
+            return this->numberOfPendingBackwardEdges();
         }
-        this->backward_offset_ = std::move(backward_offset);
-        this->backward_neigbours_ = std::move(backward_neigbours);
+    }
+
+private:
+    /**
+     * builds the offsetarray of the permuted graph, node i of the new graph
+     * gets the edge ids of node perm[i]. the degrees are gathered in parallel, a prefix sum
+     * yields the offsets and afterwards every node copies its ids into its own slot
+     */
+    template<class GetIDs>
+    static auto permuteConnections(const std::vector<std::size_t>& perm,
+                                   GetIDs&& get_ids) noexcept
+        -> std::pair<std::vector<std::size_t>, std::vector<common::EdgeID>>
+    {
+        const auto number_of_nodes = perm.size();
+
+        std::vector<std::size_t> offset(number_of_nodes + 1, 0);
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            offset[i + 1] = get_ids(common::NodeID{perm[i]}).size();
+        });
+
+        std::inclusive_scan(std::execution::par,
+                            std::begin(offset),
+                            std::end(offset),
+                            std::begin(offset));
+
+        std::vector<common::EdgeID> neigbours(offset.back(), common::UNKNOWN_EDGE_ID);
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            const auto ids = get_ids(common::NodeID{perm[i]});
+            std::copy(std::begin(ids),
+                      std::end(ids),
+                      std::begin(neigbours) + offset[i]);
+        });
+
+        return std::pair{std::move(offset), std::move(neigbours)};
     }
 };
 
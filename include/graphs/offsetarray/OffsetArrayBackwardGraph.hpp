@@ -5,16 +5,12 @@
 #include <concepts/BackwardConnections.hpp>
 #include <concepts/Edges.hpp>
 #include <execution>
+#include <numeric>
+#include <unordered_map>
+#include <utils/Permutation.hpp>
 #include <vector>
 
 
-// forward declare PHAST to be able to make it a friend of OffsetArrayBackwardGraph
-namespace algorithms::distoracle {
-template<class N, class E>
-class PHAST;
-}
-
-
 namespace graphs {
 
 template<class Node, class Edge, class Graph>
@@ -118,6 +114,14 @@ public:
             return {};
         }
 
+        // without pending edges the lookup is skipped
+        if(!backward_overflow_.empty()) {
+            if(const auto overflow = backward_overflow_.find(node.get());
+               overflow != std::end(backward_overflow_)) {
+                return overflow->second;
+            }
+        }
+
         const auto start_offset = backward_offset_[node.get()];
         const auto end_offset = backward_offset_[node.get() + 1];
         const auto *start = &backward_neigbours_[start_offset];
@@ -133,6 +137,14 @@ public:
             return {};
         }
 
+        // without pending edges the lookup is skipped
+        if(!backward_overflow_.empty()) {
+            if(const auto overflow = backward_overflow_.find(node.get());
+               overflow != std::end(backward_overflow_)) {
+                return overflow->second;
+            }
+        }
+
         const auto start_offset = backward_offset_[node.get()];
         const auto end_offset = backward_offset_[node.get() + 1];
         auto *start = &backward_neigbours_[start_offset];
@@ -203,6 +215,76 @@ public:
         }
         this->backward_offset_ = std::move(backward_offset);
         this->backward_neigbours_ = std::move(backward_neigbours);
+        dropBackwardOverflow();
+    }
+
+    /**
+     * appends the id of a new edge to the backward connections of a node. the first new edge
+     * of a node copies its ids into an overflow list, which replaces its slice of the
+     * offsetarray until the next compaction, such that no offsetarray is rebuilt
+     */
+    auto insertBackwardEdgeID(common::NodeID node, common::EdgeID id) noexcept
+        -> void
+    {
+        // like the constructor, edges of unknown nodes are not connected
+        if(!impl().nodeExists(node)) {
+            return;
+        }
+
+        auto overflow = backward_overflow_.find(node.get());
+        if(overflow == std::end(backward_overflow_)) {
+            const auto ids = getBackwardEdgeIDsOf(node);
+            std::vector overflow_ids(std::begin(ids), std::end(ids));
+            overflow = backward_overflow_.emplace(node.get(), std::move(overflow_ids)).first;
+        }
+
+        overflow->second.emplace_back(id);
+        pending_backward_edges_++;
+    }
+
+    /**
+     * merges the overflow lists into the offsetarray, the degrees and the ids
+     * of all nodes are gathered in parallel
+     */
+    auto compactBackwardEdgeIDs() noexcept
+        -> void
+    {
+        if(backward_overflow_.empty()) {
+            return;
+        }
+
+        const auto number_of_nodes = impl().numberOfNodes();
+
+        std::vector<size_t> backward_offset(number_of_nodes + 1, 0);
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            backward_offset[i + 1] = getBackwardEdgeIDsOf(common::NodeID{i}).size();
+        });
+
+        std::inclusive_scan(std::execution::par,
+                            std::begin(backward_offset),
+                            std::end(backward_offset),
+                            std::begin(backward_offset));
+
+        std::vector<common::EdgeID> backward_neigbours(backward_offset.back(), common::UNKNOWN_EDGE_ID);
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            const auto ids = getBackwardEdgeIDsOf(common::NodeID{i});
+            std::copy(std::begin(ids),
+                      std::end(ids),
+                      std::begin(backward_neigbours) + backward_offset[i]);
+        });
+
+        this->backward_offset_ = std::move(backward_offset);
+        this->backward_neigbours_ = std::move(backward_neigbours);
+        dropBackwardOverflow();
+    }
+
+    /**
+     * @returns the number of edges which were added since the last compaction
+     */
+    constexpr auto numberOfPendingBackwardEdges() const noexcept
+        -> std::size_t
+    {
+        return pending_backward_edges_;
     }
 
 
@@ -216,12 +298,22 @@ private:
 	  return static_cast<const Graph &>(*this);
     }
 
+    // used once the overflow lists are part of a rebuilt offsetarray
+    auto dropBackwardOverflow() noexcept
+        -> void
+    {
+        backward_overflow_ = {};
+        pending_backward_edges_ = 0;
+    }
+
     friend Graph;
-    //PHAST needs access to the backward_offset_
-    friend class algorithms::distoracle::PHAST<Node, Edge>;
 
     std::vector<common::EdgeID> backward_neigbours_;
     std::vector<size_t> backward_offset_;
+    // the complete ids of the nodes which got edges since the last compaction,
+    // only these nodes have an entry such that the first insertion is not O(n)
+    std::unordered_map<std::size_t, std::vector<common::EdgeID>> backward_overflow_;
+    std::size_t pending_backward_edges_ = 0;
     // clang-format on
 };
 
@@ -107,9 +107,12 @@ public:
         std::vector nodes{first};
         common::Weight weight{0};
 
+        // the stack is empty after every top level edge and is reused for the next one
+        std::vector<common::EdgeID> edge_stack;
+
         for(const auto edge_id : edges) {
 
-            std::vector edge_stack{edge_id};
+            edge_stack.emplace_back(edge_id);
             while(!edge_stack.empty()) {
                 const auto current = edge_stack.back();
                 edge_stack.pop_back();
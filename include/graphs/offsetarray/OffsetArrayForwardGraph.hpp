@@ -4,6 +4,9 @@
 #include <concepts/Edges.hpp>
 #include <concepts/ForwardConnections.hpp>
 #include <execution>
+#include <numeric>
+#include <unordered_map>
+#include <utils/Permutation.hpp>
 #include <vector>
 
 namespace graphs {
@@ -104,6 +107,14 @@ public:
             return {};
         }
 
+        // without pending edges the lookup is skipped
+        if(!forward_overflow_.empty()) {
+            if(const auto overflow = forward_overflow_.find(node.get());
+               overflow != std::end(forward_overflow_)) {
+                return overflow->second;
+            }
+        }
+
         const auto start_offset = forward_offset_[node.get()];
         const auto end_offset = forward_offset_[node.get() + 1];
         const auto *start = &forward_neigbours_[start_offset];
@@ -119,6 +130,14 @@ public:
             return {};
         }
 
+        // without pending edges the lookup is skipped
+        if(!forward_overflow_.empty()) {
+            if(const auto overflow = forward_overflow_.find(node.get());
+               overflow != std::end(forward_overflow_)) {
+                return overflow->second;
+            }
+        }
+
         const auto start_offset = forward_offset_[node.get()];
         const auto end_offset = forward_offset_[node.get() + 1];
         auto *start = &forward_neigbours_[start_offset];
@@ -189,6 +208,76 @@ public:
         }
         this->forward_offset_ = std::move(forward_offset);
         this->forward_neigbours_ = std::move(forward_neigbours);
+        dropForwardOverflow();
+    }
+
+    /**
+     * appends the id of a new edge to the forward connections of a node. the first new edge
+     * of a node copies its ids into an overflow list, which replaces its slice of the
+     * offsetarray until the next compaction, such that no offsetarray is rebuilt
+     */
+    auto insertForwardEdgeID(common::NodeID node, common::EdgeID id) noexcept
+        -> void
+    {
+        // like the constructor, edges of unknown nodes are not connected
+        if(!impl().nodeExists(node)) {
+            return;
+        }
+
+        auto overflow = forward_overflow_.find(node.get());
+        if(overflow == std::end(forward_overflow_)) {
+            const auto ids = getForwardEdgeIDsOf(node);
+            std::vector overflow_ids(std::begin(ids), std::end(ids));
+            overflow = forward_overflow_.emplace(node.get(), std::move(overflow_ids)).first;
+        }
+
+        overflow->second.emplace_back(id);
+        pending_forward_edges_++;
+    }
+
+    /**
+     * merges the overflow lists into the offsetarray, the degrees and the ids
+     * of all nodes are gathered in parallel
+     */
+    auto compactForwardEdgeIDs() noexcept
+        -> void
+    {
+        if(forward_overflow_.empty()) {
+            return;
+        }
+
+        const auto number_of_nodes = impl().numberOfNodes();
+
+        std::vector<size_t> forward_offset(number_of_nodes + 1, 0);
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            forward_offset[i + 1] = getForwardEdgeIDsOf(common::NodeID{i}).size();
+        });
+
+        std::inclusive_scan(std::execution::par,
+                            std::begin(forward_offset),
+                            std::end(forward_offset),
+                            std::begin(forward_offset));
+
+        std::vector<common::EdgeID> forward_neigbours(forward_offset.back(), common::UNKNOWN_EDGE_ID);
+        util::forEachIndex(number_of_nodes, [&](const auto i) {
+            const auto ids = getForwardEdgeIDsOf(common::NodeID{i});
+            std::copy(std::begin(ids),
+                      std::end(ids),
+                      std::begin(forward_neigbours) + forward_offset[i]);
+        });
+
+        this->forward_offset_ = std::move(forward_offset);
+        this->forward_neigbours_ = std::move(forward_neigbours);
+        dropForwardOverflow();
+    }
+
+    /**
+     * @returns the number of edges which were added since the last compaction
+     */
+    constexpr auto numberOfPendingForwardEdges() const noexcept
+        -> std::size_t
+    {
+        return pending_forward_edges_;
     }
 
 
@@ -203,10 +292,22 @@ public:
 	  return static_cast<const Graph &>(*this);
     }
 
+    // used once the overflow lists are part of a rebuilt offsetarray
+    auto dropForwardOverflow() noexcept
+        -> void
+    {
+        forward_overflow_ = {};
+        pending_forward_edges_ = 0;
+    }
+
     friend Graph;
 
     std::vector<common::EdgeID> forward_neigbours_;
     std::vector<size_t> forward_offset_;
+    // the complete ids of the nodes which got edges since the last compaction,
+    // only these nodes have an entry such that the first insertion is not O(n)
+    std::unordered_map<std::size_t, std::vector<common::EdgeID>> forward_overflow_;
+    std::size_t pending_forward_edges_ = 0;
     // clang-format off
   };
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <concepts/NodeLevels.hpp>
+#include <graphs/nodes/ColumnarNode.hpp>
+#include <graphs/offsetarray/ColumnarOffsetArrayNodes.hpp>
 #include <concepts/Nodes.hpp>
 #include <numeric>
 #include <utils/Permutation.hpp>
@@ -126,19 +128,30 @@ public:
 private:
     friend Graph;
 
+    auto permuteNodes(std::vector<std::size_t> perm) noexcept
+        -> void
+    {
+        nodes_ = util::applyPermutation(std::move(nodes_), std::move(perm));
+    }
+
     std::vector<Node> nodes_;
     // clang-format on
 };
 
+template<class Graph, class Node>
+using NonTrivialOrColumnarOffsetArrayNodes = std::conditional_t<is_columnar_node<Node>,
+                                                                ColumnarOffsetArrayNodes<Graph, Node>,
+                                                                NonTrivialOffsetArrayNodes<Graph, Node>>;
+
 template<class Graph, class Node>
 class OffsetArrayNodes : public std::conditional_t<std::is_same_v<Node, common::NodeID>,
                                                    TrivialOffsetArrayNodes,
-                                                   NonTrivialOffsetArrayNodes<Graph, Node>>
+                                                   NonTrivialOrColumnarOffsetArrayNodes<Graph, Node>>
 {
 public:
     constexpr OffsetArrayNodes(std::vector<Node> nodes) noexcept
         requires(!std::is_same_v<Node, common::NodeID>)
-        : NonTrivialOffsetArrayNodes<Graph, Node>(std::move(nodes)) {}
+        : NonTrivialOrColumnarOffsetArrayNodes<Graph, Node>(std::move(nodes)) {}
 };
 
 
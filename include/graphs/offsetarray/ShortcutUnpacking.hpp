@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <common/BasicGraphTypes.hpp>
+#include <concepts/Edges.hpp>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace graphs {
+
+/**
+ * lazy view over the original edges of a sequence of possibly shortcut edges.
+ * the shortcut tree of an edge is only expanded while iterating, the stack used for
+ * the expansion is borrowed from the caller, such that it can be reused for many paths
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasEdges<Graph>
+      && concepts::CanHaveShortcuts<typename Graph::EdgeType>
+// clang-format on
+class UnpackedEdgeRange
+{
+public:
+    class Iterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = common::EdgeID;
+
+        Iterator() noexcept = default;
+
+        Iterator(const UnpackedEdgeRange* range) noexcept
+            : range_(range)
+        {
+            range_->stack_->clear();
+            advance();
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> common::EdgeID
+        {
+            return current_;
+        }
+
+        auto operator++() noexcept
+            -> Iterator&
+        {
+            advance();
+            return *this;
+        }
+
+        auto operator++(int) noexcept
+            -> void
+        {
+            advance();
+        }
+
+        [[nodiscard]] auto operator==(std::default_sentinel_t) const noexcept
+            -> bool
+        {
+            return done_;
+        }
+
+    private:
+        auto advance() noexcept
+            -> void
+        {
+            auto& stack = *range_->stack_;
+
+            while(true) {
+                if(stack.empty()) {
+                    if(next_top_level_ == range_->edges_.size()) {
+                        done_ = true;
+                        return;
+                    }
+                    stack.emplace_back(range_->edges_[next_top_level_++]);
+                }
+
+                const auto id = stack.back();
+                stack.pop_back();
+
+                const auto* edge = range_->graph_->getEdge(id);
+                if(!edge->isShortcut()) {
+                    current_ = id;
+                    return;
+                }
+
+                // push the second half first, such that the first half is expanded first
+                const auto [first, second] = edge->getShortcutUnsafe();
+                stack.emplace_back(second);
+                stack.emplace_back(first);
+            }
+        }
+
+    private:
+        const UnpackedEdgeRange* range_ = nullptr;
+        std::size_t next_top_level_ = 0;
+        common::EdgeID current_ = common::UNKNOWN_EDGE_ID;
+        bool done_ = false;
+    };
+
+    UnpackedEdgeRange(const Graph& graph,
+                      std::span<const common::EdgeID> edges,
+                      std::vector<common::EdgeID>& stack) noexcept
+        : graph_(&graph),
+          edges_(edges),
+          stack_(&stack) {}
+
+    /**
+     * starting a new iteration invalidates all running iterations, because they share the stack
+     */
+    [[nodiscard]] auto begin() const noexcept
+        -> Iterator
+    {
+        return Iterator{this};
+    }
+
+    [[nodiscard]] constexpr auto end() const noexcept
+        -> std::default_sentinel_t
+    {
+        return std::default_sentinel;
+    }
+
+private:
+    const Graph* graph_;
+    std::span<const common::EdgeID> edges_;
+    std::vector<common::EdgeID>* stack_;
+};
+
+/**
+ * @returns for every edge the number of shortcuts which have it as direct child,
+ * edges which are part of many shortcuts are expanded most often
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasEdges<Graph>
+      && concepts::CanHaveShortcuts<typename Graph::EdgeType>
+// clang-format on
+[[nodiscard]] auto countShortcutReferences(const Graph& graph) noexcept
+    -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> references(graph.numberOfEdges(), 0);
+
+    for(std::size_t i = 0; i < graph.numberOfEdges(); i++) {
+        const auto* edge = graph.getEdge(common::EdgeID{i});
+        if(edge->isShortcut()) {
+            const auto [first, second] = edge->getShortcutUnsafe();
+            references[first.get()]++;
+            references[second.get()]++;
+        }
+    }
+
+    return references;
+}
+
+/**
+ * stores the fully expanded node sequences of the k most used shortcuts, the usage of every
+ * edge is given by the caller, e.g. by countShortcutReferences or by counting the top level
+ * edges of a sample of queries. edges without an entry in usage count as unused. the stored
+ * sequence of a shortcut contains all nodes of the shortcut except of its source
+ */
+// clang-format off
+template<class Graph>
+requires concepts::HasEdges<Graph>
+      && concepts::HasTarget<typename Graph::EdgeType>
+      && concepts::CanHaveShortcuts<typename Graph::EdgeType>
+// clang-format on
+class ShortcutCache
+{
+    using Slot = std::uint32_t;
+    constexpr static inline Slot NO_SLOT = std::numeric_limits<Slot>::max();
+
+public:
+    ShortcutCache(const Graph& graph,
+                  std::span<const std::size_t> usage,
+                  std::size_t k) noexcept
+        : slots_(graph.numberOfEdges(), NO_SLOT),
+          offsets_{0}
+    {
+        // the usage of a sample may not cover the edges added after it was taken
+        const auto number_of_used_edges = std::min(graph.numberOfEdges(), usage.size());
+
+        std::vector<std::size_t> shortcuts;
+        for(std::size_t i = 0; i < number_of_used_edges; i++) {
+            if(graph.getEdge(common::EdgeID{i})->isShortcut() and usage[i] > 0) {
+                shortcuts.emplace_back(i);
+            }
+        }
+
+        k = std::min({k, shortcuts.size(), static_cast<std::size_t>(NO_SLOT)});
+        std::partial_sort(std::begin(shortcuts),
+                          std::begin(shortcuts) + k,
+                          std::end(shortcuts),
+                          [&](const auto lhs, const auto rhs) {
+                              return usage[lhs] > usage[rhs];
+                          });
+        shortcuts.resize(k);
+
+        std::vector<common::EdgeID> stack;
+        for(std::size_t slot = 0; slot < shortcuts.size(); slot++) {
+            const auto id = common::EdgeID{shortcuts[slot]};
+            const auto range = UnpackedEdgeRange{graph, std::span{&id, 1}, stack};
+
+            for(const auto edge_id : range) {
+                nodes_.emplace_back(graph.getEdge(edge_id)->getTrg());
+            }
+
+            offsets_.emplace_back(nodes_.size());
+            slots_[id.get()] = static_cast<Slot>(slot);
+        }
+    }
+
+    /**
+     * @returns the nodes of the expanded shortcut without its source,
+     * nullopt if the edge is not cached
+     */
+    [[nodiscard]] auto getUnpackedNodes(common::EdgeID id) const noexcept
+        -> std::optional<std::span<const common::NodeID>>
+    {
+        if(id.get() >= slots_.size()) {
+            return std::nullopt;
+        }
+
+        const auto slot = slots_[id.get()];
+        if(slot == NO_SLOT) {
+            return std::nullopt;
+        }
+
+        const auto first = offsets_[slot];
+        const auto last = offsets_[slot + 1];
+        return std::span{nodes_.data() + first, last - first};
+    }
+
+    [[nodiscard]] auto numberOfCachedShortcuts() const noexcept
+        -> std::size_t
+    {
+        return offsets_.size() - 1;
+    }
+
+private:
+    std::vector<Slot> slots_;
+    std::vector<std::size_t> offsets_;
+    std::vector<common::NodeID> nodes_;
+};
+
+} // namespace graphs
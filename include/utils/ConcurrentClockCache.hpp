@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/**
+ * a key value cache which can be shared by many threads. the keys are spread over shards which
+ * are locked independently, every shard owns an equal part of the memory budget and evicts with
+ * the CLOCK algorithm, i.e. a hand sweeps over the entries and evicts the first one which was not
+ * read since the last sweep. invalidate drops all entries in constant time by starting a new
+ * epoch, entries of older epochs are never returned and evicted first
+ */
+template<class Key, class Value, class Hash = std::hash<Key>>
+class ConcurrentClockCache
+{
+    struct Slot
+    {
+        Key key_{};
+        Value value_{};
+        std::size_t bytes_ = 0;
+        std::size_t epoch_ = 0;
+        bool referenced_ = false;
+        bool used_ = false;
+    };
+
+public:
+    // estimated memory of an entry which is not part of the value, i.e. the slot and the
+    // node of the index which holds the key, the slot index and two pointers
+    constexpr static inline std::size_t ENTRY_OVERHEAD = sizeof(Slot)
+        + sizeof(Key) + sizeof(std::size_t) + 2 * sizeof(void*);
+
+    explicit ConcurrentClockCache(std::size_t memory_budget,
+                                  std::size_t number_of_shards = 16) noexcept
+        : shards_(std::max(number_of_shards, std::size_t{1})),
+          budget_per_shard_(memory_budget / shards_.size()) {}
+
+    ConcurrentClockCache(const ConcurrentClockCache&) = delete;
+    auto operator=(const ConcurrentClockCache&) -> ConcurrentClockCache& = delete;
+
+    [[nodiscard]] auto find(const Key& key) noexcept
+        -> std::optional<Value>
+    {
+        auto& shard = shardOf(key);
+        const std::lock_guard lock{shard.mutex_};
+
+        const auto iter = shard.index_.find(key);
+        if(iter == std::end(shard.index_)) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        auto& slot = shard.slots_[iter->second];
+        if(slot.epoch_ != epoch_.load(std::memory_order_acquire)) {
+            release(shard, iter->second);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        slot.referenced_ = true;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return slot.value_;
+    }
+
+    /**
+     * @returns the current epoch, it has to be read before the value of an insert is computed
+     */
+    [[nodiscard]] auto epoch() const noexcept
+        -> std::size_t
+    {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * inserts or replaces the value of the key, extra_bytes is the memory the value owns
+     * outside of itself. epoch is the epoch read before the value was computed, values
+     * computed before an invalidation and values which do not fit into the budget of a
+     * shard are not inserted
+     */
+    auto insert(const Key& key, Value value, std::size_t epoch, std::size_t extra_bytes = 0) noexcept
+        -> void
+    {
+        const auto bytes = ENTRY_OVERHEAD + extra_bytes;
+        if(bytes > budget_per_shard_) {
+            return;
+        }
+
+        auto& shard = shardOf(key);
+        const std::lock_guard lock{shard.mutex_};
+
+        // an invalidation after this check stores the entry with the old epoch,
+        // such that it is never returned
+        if(epoch != epoch_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        if(const auto iter = shard.index_.find(key); iter != std::end(shard.index_)) {
+            release(shard, iter->second);
+        }
+
+        while(shard.bytes_ + bytes > budget_per_shard_) {
+            evictOne(shard);
+        }
+
+        std::size_t idx;
+        if(shard.free_.empty()) {
+            idx = shard.slots_.size();
+            shard.slots_.emplace_back();
+        } else {
+            idx = shard.free_.back();
+            shard.free_.pop_back();
+        }
+
+        shard.slots_[idx] = Slot{key,
+                                 std::move(value),
+                                 bytes,
+                                 epoch,
+                                 false,
+                                 true};
+        shard.index_.emplace(key, idx);
+        shard.bytes_ += bytes;
+    }
+
+    /**
+     * drops all entries, e.g. after the weights of the graph of a cached oracle changed
+     */
+    auto invalidate() noexcept
+        -> void
+    {
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    [[nodiscard]] auto hits() const noexcept
+        -> std::size_t
+    {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto misses() const noexcept
+        -> std::size_t
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto evictions() const noexcept
+        -> std::size_t
+    {
+        return evictions_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @returns the fraction of lookups which hit the cache, 0 if there were no lookups
+     */
+    [[nodiscard]] auto hitRate() const noexcept
+        -> double
+    {
+        const auto lookups = hits() + misses();
+        if(lookups == 0) {
+            return 0.0;
+        }
+
+        return static_cast<double>(hits()) / static_cast<double>(lookups);
+    }
+
+    /**
+     * @returns the estimated memory of all entries, including the ones of older epochs
+     */
+    [[nodiscard]] auto usedBytes() const noexcept
+        -> std::size_t
+    {
+        std::size_t bytes = 0;
+        for(const auto& shard : shards_) {
+            const std::lock_guard lock{shard.mutex_};
+            bytes += shard.bytes_;
+        }
+        return bytes;
+    }
+
+private:
+    struct Shard
+    {
+        mutable std::mutex mutex_;
+        std::vector<Slot> slots_;
+        std::vector<std::size_t> free_;
+        std::unordered_map<Key, std::size_t, Hash> index_;
+        std::size_t hand_ = 0;
+        std::size_t bytes_ = 0;
+    };
+
+    [[nodiscard]] auto shardOf(const Key& key) noexcept
+        -> Shard&
+    {
+        return shards_[Hash{}(key) % shards_.size()];
+    }
+
+    static auto release(Shard& shard, std::size_t idx) noexcept
+        -> void
+    {
+        auto& slot = shard.slots_[idx];
+        shard.index_.erase(slot.key_);
+        shard.bytes_ -= slot.bytes_;
+        slot = Slot{};
+        shard.free_.emplace_back(idx);
+    }
+
+    // the shard is never empty when this is called, therefore the hand finds
+    // an entry to evict after at most two sweeps
+    auto evictOne(Shard& shard) noexcept
+        -> void
+    {
+        const auto epoch = epoch_.load(std::memory_order_acquire);
+
+        while(true) {
+            const auto idx = shard.hand_;
+            shard.hand_ = (shard.hand_ + 1) % shard.slots_.size();
+
+            auto& slot = shard.slots_[idx];
+            if(!slot.used_) {
+                continue;
+            }
+
+            if(slot.referenced_ and slot.epoch_ == epoch) {
+                slot.referenced_ = false;
+                continue;
+            }
+
+            release(shard, idx);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+private:
+    std::vector<Shard> shards_;
+    std::size_t budget_per_shard_;
+    std::atomic<std::size_t> epoch_ = 0;
+    std::atomic<std::size_t> hits_ = 0;
+    std::atomic<std::size_t> misses_ = 0;
+    std::atomic<std::size_t> evictions_ = 0;
+};
+
+} // namespace util
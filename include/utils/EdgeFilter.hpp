@@ -0,0 +1,157 @@
+#pragma once
+
+#include <bit>
+#include <common/BasicGraphTypes.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/**
+ * the default edge filter policy of the engines, no edge is blocked such that
+ * the check is compiled out completely
+ */
+struct NoEdgeFilter
+{
+    constexpr static inline bool is_enabled = false;
+
+    template<class Edge>
+    constexpr auto isBlocked(common::EdgeID /*id*/, const Edge& /*edge*/) const noexcept
+        -> bool
+    {
+        return false;
+    }
+};
+
+/**
+ * a bitset over the edge ids of a graph, every set bit blocks the corresponding edge.
+ * edges added to the graph after the mask was created are never blocked, blocking or
+ * unblocking them does nothing
+ */
+class EdgeMask
+{
+public:
+    explicit EdgeMask(std::size_t number_of_edges) noexcept
+        : words_((number_of_edges + BITS_PER_WORD - 1) / BITS_PER_WORD, 0),
+          number_of_edges_(number_of_edges) {}
+
+    auto block(common::EdgeID id) noexcept
+        -> void
+    {
+        if(id.get() >= number_of_edges_) {
+            return;
+        }
+
+        words_[id.get() / BITS_PER_WORD] |= bitOf(id);
+    }
+
+    auto unblock(common::EdgeID id) noexcept
+        -> void
+    {
+        if(id.get() >= number_of_edges_) {
+            return;
+        }
+
+        words_[id.get() / BITS_PER_WORD] &= ~bitOf(id);
+    }
+
+    [[nodiscard]] auto isBlocked(common::EdgeID id) const noexcept
+        -> bool
+    {
+        if(id.get() >= number_of_edges_) {
+            return false;
+        }
+
+        return (words_[id.get() / BITS_PER_WORD] & bitOf(id)) != 0;
+    }
+
+    [[nodiscard]] auto numberOfEdges() const noexcept
+        -> std::size_t
+    {
+        return number_of_edges_;
+    }
+
+    [[nodiscard]] auto numberOfBlockedEdges() const noexcept
+        -> std::size_t
+    {
+        return std::accumulate(std::begin(words_),
+                               std::end(words_),
+                               std::size_t{0},
+                               [](const auto sum, const auto word) {
+                                   return sum + std::popcount(word);
+                               });
+    }
+
+private:
+    constexpr static inline std::size_t BITS_PER_WORD = 64;
+
+    [[nodiscard]] constexpr static auto bitOf(common::EdgeID id) noexcept
+        -> std::uint64_t
+    {
+        return std::uint64_t{1} << (id.get() % BITS_PER_WORD);
+    }
+
+private:
+    std::vector<std::uint64_t> words_;
+    std::size_t number_of_edges_;
+};
+
+/**
+ * blocks the edges of a shared mask, the mask is never modified through the filter
+ * such that one mask can be read by the engines of all threads at once.
+ * copying the filter only copies the pointer to the mask
+ */
+class EdgeMaskFilter
+{
+public:
+    constexpr static inline bool is_enabled = true;
+
+    explicit EdgeMaskFilter(std::shared_ptr<const EdgeMask> mask) noexcept
+        : mask_(std::move(mask)) {}
+
+    template<class Edge>
+    [[nodiscard]] auto isBlocked(common::EdgeID id, const Edge& /*edge*/) const noexcept
+        -> bool
+    {
+        return mask_->isBlocked(id);
+    }
+
+    [[nodiscard]] auto getMask() const noexcept
+        -> const std::shared_ptr<const EdgeMask>&
+    {
+        return mask_;
+    }
+
+private:
+    std::shared_ptr<const EdgeMask> mask_;
+};
+
+/**
+ * blocks every edge whose type fullfills the predicate, e.g. all motorways for slow vehicles.
+ * the predicate is called concurrently by all threads querying an engine
+ */
+template<class Predicate>
+class EdgeTypeFilter
+{
+public:
+    constexpr static inline bool is_enabled = true;
+
+    explicit EdgeTypeFilter(Predicate predicate) noexcept
+        : predicate_(std::move(predicate)) {}
+
+    template<class Edge>
+    [[nodiscard]] auto isBlocked(common::EdgeID /*id*/, const Edge& edge) const noexcept
+        -> bool
+    {
+        return std::invoke(predicate_, edge.getEdgeType());
+    }
+
+private:
+    Predicate predicate_;
+};
+
+} // namespace util
@@ -1,11 +1,41 @@
 #pragma once
 
+#include <algorithm>
+#include <common/Range.hpp>
+#include <concepts>
+#include <execution>
 #include <functional>
 #include <utility>
 #include <vector>
 
 namespace util {
 
+// below this size the permutations are applied sequentially,
+// the parallel algorithms do not pay off for such small vectors
+constexpr static inline std::size_t PARALLEL_PERMUTATION_THRESHOLD = 1ul << 14;
+
+/**
+ * calls func for every index in [0, size), in parallel if size is large enough.
+ * func has to be safe to call concurrently for different indices
+ */
+template<class F>
+auto forEachIndex(std::size_t size, F&& func) noexcept
+    -> void
+{
+    if(size < PARALLEL_PERMUTATION_THRESHOLD) {
+        for(std::size_t i = 0; i < size; i++) {
+            func(i);
+        }
+        return;
+    }
+
+    const auto range = common::range(size);
+    std::for_each(std::execution::par,
+                  std::begin(range),
+                  std::end(range),
+                  std::forward<F>(func));
+}
+
 
 [[nodiscard]] inline auto isValidPermutation(const std::vector<std::size_t>& permutation) noexcept
     -> bool
@@ -20,9 +50,14 @@ namespace util {
                        [](auto b) { return b; });
 }
 
+/**
+ * applies the permutation by following its cycles and swapping the elements in place.
+ * besides the permutation itself no additional memory is needed, but the cycles are
+ * followed sequentially
+ */
 template<class T>
-[[nodiscard]] auto applyPermutation(std::vector<T> vec,
-                                    std::vector<std::size_t> permutation) noexcept
+[[nodiscard]] auto applyPermutationInPlace(std::vector<T> vec,
+                                           std::vector<std::size_t> permutation) noexcept
     -> std::vector<T>
 {
     for(std::size_t i = 0; i < vec.size(); i++) {
@@ -40,6 +75,50 @@ template<class T>
     return std::move(vec);
 }
 
+/**
+ * applies the permutation such that result[i] == vec[permutation[i]].
+ * the elements are gathered in parallel into a second vector, which needs the elements
+ * to be default constructible or copyable. for all other element types the permutation
+ * is applied in place via applyPermutationInPlace
+ */
+template<class T>
+[[nodiscard]] auto applyPermutation(std::vector<T> vec,
+                                    std::vector<std::size_t> permutation) noexcept
+    -> std::vector<T>
+{
+    if constexpr(std::default_initializable<T>) {
+        std::vector<T> result(vec.size());
+        forEachIndex(vec.size(), [&](const auto i) {
+            result[i] = std::move(vec[permutation[i]]);
+        });
+        return result;
+
+    } else if constexpr(std::copy_constructible<T> and std::is_copy_assignable_v<T>) {
+        // the copy only provides constructed elements which are overwritten afterwards
+        auto result = vec;
+        forEachIndex(vec.size(), [&](const auto i) {
+            result[i] = std::move(vec[permutation[i]]);
+        });
+        return result;
+
+    } else {
+        return applyPermutationInPlace(std::move(vec), std::move(permutation));
+    }
+}
+
+/**
+ * replaces every id in ids by mapping[id], the ids are updated in parallel
+ */
+template<class ID>
+auto remapIDs(std::vector<ID>& ids,
+              const std::vector<std::size_t>& mapping) noexcept
+    -> void
+{
+    forEachIndex(ids.size(), [&](const auto i) {
+        ids[i] = ID{mapping[ids[i].get()]};
+    });
+}
+
 
 // permutations are a monoid, we can combine them
 [[nodiscard]] inline auto combine(const std::vector<std::size_t>& first,
@@ -47,10 +126,9 @@ template<class T>
     -> std::vector<std::size_t>
 {
     std::vector<std::size_t> combined(first.size());
-
-    for(std::size_t i = 0; i < first.size(); i++) {
+    forEachIndex(first.size(), [&](const auto i) {
         combined[i] = second[first[i]];
-    }
+    });
 
     return combined;
 }
@@ -62,10 +140,11 @@ template<class T>
 [[nodiscard]] inline auto inversePermutation(const std::vector<std::size_t>& permutation) noexcept
     -> std::vector<std::size_t>
 {
+    // every position is written exactly once, hence the scatter can run in parallel
     std::vector<std::size_t> inverse_perm(permutation.size(), 0);
-    for(std::size_t i = 0; i < permutation.size(); i++) {
+    forEachIndex(permutation.size(), [&](const auto i) {
         inverse_perm[permutation[i]] = i;
-    }
+    });
 
     return inverse_perm;
 }
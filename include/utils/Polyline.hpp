@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cmath>
+#include <common/BasicGraphTypes.hpp>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace util {
+
+/**
+ * appends a single signed value in the encoded polyline format, the value is
+ * zigzag encoded and written in chunks of 5 bits, least significant chunk first
+ */
+inline auto appendPolylineValue(std::string& out, std::int64_t value) noexcept
+    -> void
+{
+    auto bits = static_cast<std::uint64_t>(value) << 1;
+    if(value < 0) {
+        bits = ~bits;
+    }
+
+    while(bits >= 0x20) {
+        out.push_back(static_cast<char>((0x20 | (bits & 0x1f)) + 63));
+        bits >>= 5;
+    }
+
+    out.push_back(static_cast<char>(bits + 63));
+}
+
+/**
+ * appends the coordinates in the encoded polyline format to out, coordinates can be any
+ * range of lat/lng pairs and is consumed in a single pass. precision is the number of
+ * decimal places kept, 5 for the common polyline format and 6 for polyline6
+ */
+template<class Coordinates>
+auto appendPolyline(std::string& out,
+                    Coordinates&& coordinates,
+                    int precision = 5) noexcept
+    -> void
+{
+    const auto factor = std::pow(10.0, precision);
+
+    std::int64_t last_lat = 0;
+    std::int64_t last_lng = 0;
+
+    for(const auto& [lat, lng] : coordinates) {
+        const auto current_lat = std::llround(lat.get() * factor);
+        const auto current_lng = std::llround(lng.get() * factor);
+
+        appendPolylineValue(out, current_lat - last_lat);
+        appendPolylineValue(out, current_lng - last_lng);
+
+        last_lat = current_lat;
+        last_lng = current_lng;
+    }
+}
+
+template<class Coordinates>
+[[nodiscard]] auto encodePolyline(Coordinates&& coordinates, int precision = 5) noexcept
+    -> std::string
+{
+    std::string out;
+    appendPolyline(out, std::forward<Coordinates>(coordinates), precision);
+    return out;
+}
+
+} // namespace util
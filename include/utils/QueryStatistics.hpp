@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <fmt/core.h>
+#include <string>
+#include <string_view>
+#include <tbb/enumerable_thread_specific.h>
+
+namespace util {
+
+enum class QueryCounter : std::size_t {
+    SETTLED_NODES,
+    RELAXED_EDGES,
+    STALLED_NODES,
+    QUEUE_PUSHES,
+    SCANNED_LABEL_ENTRIES,
+    ORACLE_QUERIES,
+};
+
+constexpr inline std::size_t NUMBER_OF_QUERY_COUNTERS = 6;
+
+[[nodiscard]] constexpr inline auto queryCounterName(QueryCounter counter) noexcept
+    -> std::string_view
+{
+    switch(counter) {
+    case QueryCounter::SETTLED_NODES:
+        return "settled_nodes";
+    case QueryCounter::RELAXED_EDGES:
+        return "relaxed_edges";
+    case QueryCounter::STALLED_NODES:
+        return "stalled_nodes";
+    case QueryCounter::QUEUE_PUSHES:
+        return "queue_pushes";
+    case QueryCounter::SCANNED_LABEL_ENTRIES:
+        return "scanned_label_entries";
+    case QueryCounter::ORACLE_QUERIES:
+        return "oracle_queries";
+    }
+
+    return "unknown";
+}
+
+/**
+ * the default statistics policy of the engines, every call is a noop such that
+ * the counting is compiled out completely
+ */
+struct NoStatistics
+{
+    constexpr static inline bool is_enabled = false;
+
+    constexpr auto count(QueryCounter /*counter*/, std::size_t /*n*/ = 1) noexcept
+        -> void {}
+
+    constexpr auto beginQuery() noexcept
+        -> void {}
+
+    constexpr auto endQuery() noexcept
+        -> void {}
+
+    constexpr auto merge(const NoStatistics& /*other*/) noexcept
+        -> void {}
+};
+
+/**
+ * counts the work of every query and aggregates the counters of all finished queries
+ * into totals, maxima and log2 histograms. an instance must only be used by one thread
+ * at a time, the engines therefore keep one instance per thread and merge them on request
+ */
+class QueryStatistics
+{
+public:
+    constexpr static inline bool is_enabled = true;
+
+    // bucket i counts the queries with a counter value of bit width i,
+    // i.e. the buckets are 0, 1, 2-3, 4-7, ...
+    constexpr static inline std::size_t NUMBER_OF_BUCKETS = 65;
+
+    using Counters = std::array<std::size_t, NUMBER_OF_QUERY_COUNTERS>;
+    using Histogram = std::array<std::size_t, NUMBER_OF_BUCKETS>;
+
+    auto count(QueryCounter counter, std::size_t n = 1) noexcept
+        -> void
+    {
+        current_[static_cast<std::size_t>(counter)] += n;
+    }
+
+    auto beginQuery() noexcept
+        -> void
+    {
+        current_.fill(0);
+    }
+
+    auto endQuery() noexcept
+        -> void
+    {
+        for(std::size_t i = 0; i < NUMBER_OF_QUERY_COUNTERS; i++) {
+            const auto value = current_[i];
+            totals_[i] += value;
+            max_[i] = std::max(max_[i], value);
+            histograms_[i][std::bit_width(value)]++;
+        }
+
+        last_query_ = current_;
+        number_of_queries_++;
+    }
+
+    auto merge(const QueryStatistics& other) noexcept
+        -> void
+    {
+        for(std::size_t i = 0; i < NUMBER_OF_QUERY_COUNTERS; i++) {
+            totals_[i] += other.totals_[i];
+            max_[i] = std::max(max_[i], other.max_[i]);
+            for(std::size_t b = 0; b < NUMBER_OF_BUCKETS; b++) {
+                histograms_[i][b] += other.histograms_[i][b];
+            }
+        }
+
+        number_of_queries_ += other.number_of_queries_;
+    }
+
+    [[nodiscard]] auto numberOfQueries() const noexcept
+        -> std::size_t
+    {
+        return number_of_queries_;
+    }
+
+    /**
+     * @returns the counter of the last finished query
+     */
+    [[nodiscard]] auto lastQuery(QueryCounter counter) const noexcept
+        -> std::size_t
+    {
+        return last_query_[static_cast<std::size_t>(counter)];
+    }
+
+    [[nodiscard]] auto total(QueryCounter counter) const noexcept
+        -> std::size_t
+    {
+        return totals_[static_cast<std::size_t>(counter)];
+    }
+
+    [[nodiscard]] auto max(QueryCounter counter) const noexcept
+        -> std::size_t
+    {
+        return max_[static_cast<std::size_t>(counter)];
+    }
+
+    [[nodiscard]] auto histogram(QueryCounter counter) const noexcept
+        -> const Histogram&
+    {
+        return histograms_[static_cast<std::size_t>(counter)];
+    }
+
+    /**
+     * dumps the aggregated counters as json, the histogram maps the inclusive upper
+     * bound of every non empty bucket to the number of queries in it
+     */
+    [[nodiscard]] auto toJson() const noexcept
+        -> std::string
+    {
+        auto json = fmt::format("{{\"queries\": {}, \"counters\": {{", number_of_queries_);
+
+        for(std::size_t i = 0; i < NUMBER_OF_QUERY_COUNTERS; i++) {
+            json += fmt::format("{}\"{}\": {{\"total\": {}, \"max\": {}, \"histogram\": {{",
+                                i == 0 ? "" : ", ",
+                                queryCounterName(static_cast<QueryCounter>(i)),
+                                totals_[i],
+                                max_[i]);
+
+            bool first = true;
+            for(std::size_t b = 0; b < NUMBER_OF_BUCKETS; b++) {
+                if(histograms_[i][b] == 0) {
+                    continue;
+                }
+
+                const auto upper_bound = b == 0 ? 0ul : (~0ul >> (64 - b));
+                json += fmt::format("{}\"{}\": {}", first ? "" : ", ", upper_bound, histograms_[i][b]);
+                first = false;
+            }
+
+            json += "}}";
+        }
+
+        json += "}}";
+        return json;
+    }
+
+private:
+    Counters current_{};
+    Counters last_query_{};
+    Counters totals_{};
+    Counters max_{};
+    std::array<Histogram, NUMBER_OF_QUERY_COUNTERS> histograms_{};
+    std::size_t number_of_queries_ = 0;
+};
+
+/**
+ * begins a query on construction and ends it on destruction, such that
+ * every return path of a query is recorded
+ */
+template<class Statistics>
+class QueryScope
+{
+public:
+    explicit QueryScope(Statistics& statistics) noexcept
+        : statistics_(statistics)
+    {
+        statistics_.beginQuery();
+    }
+
+    ~QueryScope() noexcept
+    {
+        statistics_.endQuery();
+    }
+
+    QueryScope(const QueryScope&) = delete;
+    auto operator=(const QueryScope&) -> QueryScope& = delete;
+
+private:
+    Statistics& statistics_;
+};
+
+/**
+ * the statistics of an engine, every thread counts into its own instance
+ * and combine merges the instances of all threads
+ */
+template<class Statistics>
+class ThreadLocalStatistics
+{
+public:
+    [[nodiscard]] auto local() const noexcept
+        -> Statistics&
+    {
+        return statistics_.local();
+    }
+
+    [[nodiscard]] auto combine() const noexcept
+        -> Statistics
+    {
+        Statistics combined;
+        for(const auto& statistics : statistics_) {
+            combined.merge(statistics);
+        }
+        return combined;
+    }
+
+    auto clear() noexcept
+        -> void
+    {
+        statistics_.clear();
+    }
+
+private:
+    mutable tbb::enumerable_thread_specific<Statistics> statistics_;
+};
+
+template<>
+class ThreadLocalStatistics<NoStatistics>
+{
+public:
+    [[nodiscard]] auto local() const noexcept
+        -> NoStatistics&
+    {
+        return statistics_;
+    }
+
+    [[nodiscard]] constexpr auto combine() const noexcept
+        -> NoStatistics
+    {
+        return NoStatistics{};
+    }
+
+    constexpr auto clear() noexcept
+        -> void {}
+
+private:
+    [[no_unique_address]] mutable NoStatistics statistics_;
+};
+
+} // namespace util
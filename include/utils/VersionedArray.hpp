@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace util {
+
+/**
+ * an array where every entry carries the generation in which it was written.
+ * entries written in an older generation are stale and read as the default value,
+ * clearing the whole array is therefore a single increment of the generation.
+ * besides its value an entry can be marked as settled in the current generation,
+ * which replaces the separate settled bitsets of the search engines
+ */
+template<class T>
+class VersionedArray
+{
+    using Stamp = std::uint32_t;
+
+    struct Entry
+    {
+        T value_;
+        Stamp stamp_;
+    };
+
+public:
+    VersionedArray(std::size_t size, T default_value) noexcept
+        : entries_(size, Entry{default_value, 0}),
+          default_value_(default_value) {}
+
+    [[nodiscard]] auto operator[](std::size_t idx) const noexcept
+        -> T
+    {
+        const auto& entry = entries_[idx];
+        return entry.stamp_ >= reached_ ? entry.value_ : default_value_;
+    }
+
+    auto set(std::size_t idx, T value) noexcept
+        -> void
+    {
+        auto& entry = entries_[idx];
+        entry.value_ = value;
+        entry.stamp_ = std::max(entry.stamp_, reached_);
+    }
+
+    /**
+     * @returns true if the entry was written since the last clear
+     */
+    [[nodiscard]] auto isSet(std::size_t idx) const noexcept
+        -> bool
+    {
+        return entries_[idx].stamp_ >= reached_;
+    }
+
+    /**
+     * marks the entry as settled, the value of an entry that
+     * was not written since the last clear is reset to the default value
+     */
+    auto settle(std::size_t idx) noexcept
+        -> void
+    {
+        auto& entry = entries_[idx];
+        if(entry.stamp_ < reached_) {
+            entry.value_ = default_value_;
+        }
+        entry.stamp_ = reached_ + 1;
+    }
+
+    [[nodiscard]] auto isSettled(std::size_t idx) const noexcept
+        -> bool
+    {
+        return entries_[idx].stamp_ == reached_ + 1;
+    }
+
+    /**
+     * invalidates all entries in O(1), only when the generation counter
+     * overflows all stamps have to be touched
+     */
+    auto clear() noexcept
+        -> void
+    {
+        // every generation uses two stamps, one for reached and one for settled entries
+        if(reached_ >= std::numeric_limits<Stamp>::max() - 2) {
+            for(auto& entry : entries_) {
+                entry.stamp_ = 0;
+            }
+            reached_ = 0;
+        }
+
+        reached_ += 2;
+    }
+
+    /**
+     * writes the current value of every entry into out,
+     * stale entries are written as the default value
+     */
+    auto exportTo(std::vector<T>& out) const noexcept
+        -> void
+    {
+        out.resize(entries_.size());
+        for(std::size_t i = 0; i < entries_.size(); i++) {
+            out[i] = (*this)[i];
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept
+        -> std::size_t
+    {
+        return entries_.size();
+    }
+
+private:
+    std::vector<Entry> entries_;
+    T default_value_;
+    // stamp 0 is used by freshly constructed entries, hence the first generation starts at 2
+    Stamp reached_ = 2;
+};
+
+} // namespace util
@@ -0,0 +1,152 @@
+//all the includes you want to use before the gtest include
+#include "../../globals.hpp"
+#include <algorithms/distoracle/CachedOracle.hpp>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelCalculator.hpp>
+#include <algorithms/pathfinding/dijkstra/BidirectionalDijkstra.hpp>
+#include <execution>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+#include <utils/ConcurrentClockCache.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(CachedOracleTest, AndorraCachedCHDijkstraTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+
+    // the budget is too small for all queries such that entries are evicted
+    const algorithms::distoracle::CachedOracle cached{
+        algorithms::distoracle::CHDijkstra{graph}, 16 * 1024, 4};
+
+    static_assert(decltype(cached)::is_threadsafe);
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    std::vector<std::pair<common::NodeID, common::NodeID>> queries;
+    std::vector<common::Weight> expected;
+    for(std::size_t i = 0; i < 2000; i++) {
+        // every third query repeats an earlier one
+        const auto q = i % 3 == 0 ? i / 3 : i;
+        queries.emplace_back(common::NodeID{(q * 7919) % number_of_nodes},
+                             common::NodeID{(q * 104729 + 13) % number_of_nodes});
+        expected.emplace_back(dijkstra.distanceBetween(queries.back().first, queries.back().second));
+    }
+
+    std::vector<common::Weight> results(queries.size());
+    std::transform(std::execution::par,
+                   std::begin(queries),
+                   std::end(queries),
+                   std::begin(results),
+                   [&](const auto query) {
+                       return cached.distanceBetween(query.first, query.second);
+                   });
+
+    EXPECT_EQ(results, expected);
+
+    const auto& cache = cached.distanceCache();
+    EXPECT_EQ(cache.hits() + cache.misses(), queries.size());
+    EXPECT_GT(cache.evictions(), 0ul);
+    EXPECT_LE(cache.usedBytes(), 16ul * 1024);
+
+    // the same queries again hit the cache
+    const auto hits = cache.hits();
+    EXPECT_EQ(cached.distanceBetween(queries.back().first, queries.back().second), expected.back());
+    EXPECT_EQ(cache.hits(), hits + 1);
+}
+
+TEST(CachedOracleTest, ToyCachedHubLabelsTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = algorithms::distoracle::prepareGraphForHubLabelCalculator(std::move(graph_opt.value()));
+
+    algorithms::distoracle::HubLabelCalculator calculator{graph};
+    const auto lookup = calculator.constructHubLabelLookup();
+    const algorithms::distoracle::CachedOracle cached{[&] { return lookup; }, 1024 * 1024};
+
+    for(std::size_t round = 0; round < 2; round++) {
+        for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+            for(std::size_t j = 0; j < graph.numberOfNodes(); j++) {
+                EXPECT_EQ(cached.distanceBetween(common::NodeID{i}, common::NodeID{j}),
+                          lookup.distanceBetween(common::NodeID{i}, common::NodeID{j}));
+            }
+        }
+    }
+
+    EXPECT_DOUBLE_EQ(cached.distanceCache().hitRate(), 0.5);
+}
+
+TEST(CachedOracleTest, AndorraInvalidatePathsTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    using Graph = std::remove_cvref_t<decltype(graph)>;
+    using Engine = algorithms::pathfinding::BidirectionalDijkstra<Graph>;
+
+    // the engine is not threadsafe, every thread gets its own engine
+    algorithms::distoracle::CachedOracle cached{[&] { return Engine{graph}; }, 1024 * 1024};
+    static_assert(decltype(cached)::is_threadsafe);
+
+    const common::NodeID source{0};
+    const common::NodeID target{graph.numberOfNodes() / 2};
+
+    const auto path = cached.pathBetween(source, target);
+    ASSERT_TRUE(path);
+    EXPECT_EQ(cached.pathBetween(source, target), path);
+    EXPECT_EQ(cached.pathCache().hits(), 1ul);
+
+    // replace the graph by one where the first edge of the path is more expensive
+    const auto changed = graph.getForwardEdgeIDBetween((*path)[0], (*path)[1]);
+    ASSERT_TRUE(changed);
+
+    std::vector<graphs::FMIEdge<false>> edges;
+    for(std::size_t i = 0; i < graph.numberOfEdges(); i++) {
+        const auto& edge = *graph.getEdge(common::EdgeID{i});
+        const auto weight = i == changed->get() ? common::Weight{1000000} : edge.getWeight();
+        edges.emplace_back(edge.getSrc(), edge.getTrg(), weight, edge.getSpeed(), edge.getEdgeType());
+    }
+
+    const auto nodes = graph.getNodes();
+    graph = Graph{std::vector(std::begin(nodes), std::end(nodes)), std::move(edges)};
+
+    // without invalidation the stale results are returned
+    EXPECT_EQ(cached.pathBetween(source, target), path);
+
+    cached.invalidate();
+
+    Engine reference{graph};
+    EXPECT_EQ(cached.pathBetween(source, target), reference.pathBetween(source, target));
+    EXPECT_EQ(cached.distanceBetween(source, target), reference.distanceBetween(source, target));
+    EXPECT_NE(cached.distanceBetween(source, target), path->getCost());
+}
+
+TEST(CachedOracleTest, StaleInsertIsDroppedTest)
+{
+    util::ConcurrentClockCache<int, int> cache{1024 * 1024};
+
+    // the value is computed while the cache is invalidated
+    const auto epoch = cache.epoch();
+    cache.invalidate();
+    cache.insert(1, 42, epoch);
+    EXPECT_FALSE(cache.find(1));
+
+    cache.insert(1, 42, cache.epoch());
+    EXPECT_EQ(cache.find(1), 42);
+}
@@ -0,0 +1,89 @@
+//all the includes you want to use before the gtest include
+#include "../../globals.hpp"
+#include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/PHASTIsochrone.hpp>
+#include <algorithms/pathfinding/dijkstra/Dijkstra.hpp>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/NodeOrdering.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(PHASTIsochroneTest, AndorraCompareWithDijkstraTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    // sort the nodes by level first, such that the node ids of the
+    // full graph and of the graph prepared for PHAST are the same
+    graphs::reorderNodesByLevelThenHilbertCurve(graph);
+    auto phast_graph = algorithms::distoracle::prepareGraphForPHAST(graph);
+
+    const algorithms::pathfinding::Dijkstra dijkstra{graph};
+    const algorithms::distoracle::PHASTIsochrone isochrone_engine{phast_graph};
+
+    // 5 minutes, the weights are travel times in 1/100 seconds
+    const auto limit = common::Weight{30000};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    std::vector<common::NodeID> sources;
+    for(std::size_t i = 0; i < 8; i++) {
+        sources.emplace_back((i * 7919) % number_of_nodes);
+    }
+
+    const auto isochrones = isochrone_engine.isochronesFrom(sources, limit);
+    ASSERT_EQ(isochrones.size(), sources.size());
+
+    for(std::size_t i = 0; i < sources.size(); i++) {
+        auto expected = dijkstra.distancesWithin(sources[i], limit);
+        std::sort(std::begin(expected), std::end(expected));
+
+        const auto& isochrone = isochrones[i];
+        EXPECT_EQ(isochrone.reachable_, expected);
+
+        std::vector<bool> reachable(number_of_nodes, false);
+        for(const auto& [node, _] : expected) {
+            reachable[node.get()] = true;
+        }
+
+        // all non shortcut edges leaving the reachable area and nothing else
+        std::vector<common::EdgeID> expected_boundary;
+        for(std::size_t e = 0; e < phast_graph.numberOfEdges(); e++) {
+            const auto* edge = phast_graph.getEdge(common::EdgeID{e});
+            if(!edge->isShortcut()
+               and reachable[edge->getSrc().get()]
+               and !reachable[edge->getTrg().get()]) {
+                expected_boundary.emplace_back(e);
+            }
+        }
+
+        auto boundary = isochrone.boundary_edges_;
+        std::sort(std::begin(boundary), std::end(boundary));
+        EXPECT_EQ(boundary, expected_boundary);
+    }
+}
+
+TEST(PHASTIsochroneTest, ToyZeroLimitTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = algorithms::distoracle::prepareGraphForPHAST(std::move(graph_opt.value()));
+
+    const algorithms::distoracle::PHASTIsochrone isochrone_engine{graph};
+
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        const auto isochrone = isochrone_engine.isochroneFrom(common::NodeID{i}, common::Weight{0});
+
+        ASSERT_EQ(isochrone.reachable_.size(), 1);
+        EXPECT_EQ(isochrone.reachable_[0].first, common::NodeID{i});
+        EXPECT_EQ(isochrone.reachable_[0].second, common::Weight{0});
+    }
+}
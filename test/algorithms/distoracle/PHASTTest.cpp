@@ -51,3 +51,69 @@ TEST(PHASTTest, ToyAllToAllPHASTTest)
         EXPECT_EQ(dists[i], dijkstra.distanceBetween(common::NodeID{4}, common::NodeID{i}));
     }
 }
+
+TEST(PHASTTest, AndorraCompareWithCHDijkstraTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForPHAST(std::move(graph));
+
+    algorithms::distoracle::PHAST phast{graph};
+    algorithms::distoracle::CHDijkstra dijkstra{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 5; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto dists = phast.distancesFrom(source);
+
+        for(std::size_t j = 0; j < number_of_nodes; j += 37) {
+            EXPECT_EQ(dists[j], dijkstra.distanceBetween(source, common::NodeID{j}));
+        }
+    }
+}
+
+TEST(PHASTTest, AndorraDistanceTableTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForPHAST(std::move(graph));
+
+    const algorithms::distoracle::PHAST phast{graph};
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    std::vector<common::NodeID> sources;
+    std::vector<common::NodeID> targets;
+    for(std::size_t i = 0; i < 6; i++) {
+        sources.emplace_back((i * 7919) % number_of_nodes);
+    }
+    for(std::size_t i = 0; i < 40; i++) {
+        targets.emplace_back((i * 104729 + 13) % number_of_nodes);
+    }
+
+    std::vector<common::Weight> table(sources.size() * targets.size());
+    std::vector<common::Weight> ch_table(sources.size() * targets.size());
+    ASSERT_TRUE(phast.distanceTable(sources, targets, table));
+    ASSERT_TRUE(dijkstra.distanceTable(sources, targets, ch_table));
+
+    for(std::size_t i = 0; i < sources.size(); i++) {
+        for(std::size_t j = 0; j < targets.size(); j++) {
+            const auto expected = dijkstra.distanceBetween(sources[i], targets[j]);
+            EXPECT_EQ(table[i * targets.size() + j], expected);
+            EXPECT_EQ(ch_table[i * targets.size() + j], expected);
+        }
+    }
+
+    // the table has to match the number of sources and targets
+    std::vector<common::Weight> too_small(sources.size());
+    EXPECT_FALSE(phast.distanceTable(sources, targets, too_small));
+    EXPECT_FALSE(dijkstra.distanceTable(sources, targets, too_small));
+}
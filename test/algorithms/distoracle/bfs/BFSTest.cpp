@@ -0,0 +1,123 @@
+// all the includes you want to use before the gtest include
+
+#include "../../../globals.hpp"
+#include <algorithms/distoracle/bfs/BFS.hpp>
+#include <algorithms/distoracle/bfs/DirectionOptimizingBFS.hpp>
+#include <algorithms/distoracle/bfs/MultiSourceBFS.hpp>
+#include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
+#include <graphs/edges/SimpleEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+#include <algorithm>
+#include <bit>
+#include <span>
+
+#include <gtest/gtest.h>
+
+
+TEST(DistanceOracleBFSTest, ToyHopDistanceTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::SimpleEdge>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    // without weights dijkstra uses a weight of 1 for every edge
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+    const algorithms::distoracle::BFS bfs{graph};
+    const algorithms::distoracle::DirectionOptimizingBFS do_bfs{graph};
+
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        for(std::size_t j = 0; j < graph.numberOfNodes(); j++) {
+            const auto expected = dijkstra.distanceBetween(common::NodeID{i}, common::NodeID{j});
+            EXPECT_EQ(bfs.distanceBetween(common::NodeID{i}, common::NodeID{j}), expected);
+            EXPECT_EQ(do_bfs.distanceBetween(common::NodeID{i}, common::NodeID{j}), expected);
+        }
+
+        EXPECT_EQ(bfs.distancesFrom(common::NodeID{i}), dijkstra.distancesFrom(common::NodeID{i}));
+        EXPECT_EQ(do_bfs.distancesFrom(common::NodeID{i}), dijkstra.distancesFrom(common::NodeID{i}));
+    }
+}
+
+TEST(DistanceOracleBFSTest, AndorraOneToAllTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::SimpleEdge>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+    const algorithms::distoracle::BFS bfs{graph};
+    const algorithms::distoracle::DirectionOptimizingBFS<std::remove_cvref_t<decltype(graph)>, util::QueryStatistics> do_bfs{graph};
+
+    for(std::size_t i = 0; i < 10; i++) {
+        const common::NodeID source{(i * 7919) % graph.numberOfNodes()};
+        const auto expected = dijkstra.distancesFrom(source);
+
+        EXPECT_EQ(bfs.distancesFrom(source), expected);
+        EXPECT_EQ(do_bfs.distancesFrom(source), expected);
+    }
+
+    EXPECT_EQ(do_bfs.statistics().numberOfQueries(), 10ul);
+}
+
+TEST(DistanceOracleBFSTest, AndorraMultiSourceTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::SimpleEdge>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const algorithms::distoracle::BFS bfs{graph};
+    const algorithms::distoracle::MultiSourceBFS ms_bfs{graph};
+
+    // two groups of sources, a duplicated source and a duplicated target
+    std::vector<common::NodeID> sources;
+    for(std::size_t i = 0; i < 100; i++) {
+        sources.emplace_back((i * 7919) % graph.numberOfNodes());
+    }
+    sources.emplace_back(sources.front());
+
+    std::vector<common::NodeID> targets;
+    for(std::size_t i = 0; i < 50; i++) {
+        targets.emplace_back((i * 104729 + 13) % graph.numberOfNodes());
+    }
+    targets.emplace_back(targets.front());
+    targets.emplace_back(sources[3]);
+
+    std::vector<common::Weight> out(sources.size() * targets.size());
+    std::vector<common::Weight> expected(sources.size() * targets.size());
+    ASSERT_TRUE(ms_bfs.distanceTable(sources, targets, out));
+    ASSERT_TRUE(bfs.distanceTable(sources, targets, expected));
+    EXPECT_EQ(out, expected);
+
+    std::vector<common::NodeID> too_many(65, common::NodeID{0});
+    EXPECT_FALSE(ms_bfs.visitFrom(too_many, [](auto...) {}));
+
+    const auto group = std::span{sources}.first(64);
+    std::vector<std::vector<common::Weight>> expected_distances;
+    std::size_t expected_reached = 0;
+    for(const auto source : group) {
+        const auto& distances = expected_distances.emplace_back(bfs.distancesFrom(source));
+        expected_reached += std::count_if(std::begin(distances), std::end(distances), [](const auto d) {
+            return d != common::INFINITY_WEIGHT;
+        });
+    }
+
+    std::size_t reached = 0;
+    EXPECT_TRUE(ms_bfs.visitFrom(group, [&](const auto node, const auto sources_bits, const auto distance) {
+        reached += std::popcount(sources_bits);
+        for(std::size_t i = 0; i < group.size(); i++) {
+            if(sources_bits & (std::uint64_t{1} << i)) {
+                EXPECT_EQ(expected_distances[i][node.get()], distance);
+            }
+        }
+    }));
+
+    // every source reaches a node exactly once
+    EXPECT_EQ(reached, expected_reached);
+}
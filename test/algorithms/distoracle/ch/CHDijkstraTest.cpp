@@ -2,6 +2,7 @@
 
 #include "../../../globals.hpp"
 #include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <execution>
 #include <fmt/ranges.h>
 #include <graphs/edges/FMIEdge.hpp>
 #include <graphs/nodes/FMINode.hpp>
@@ -139,3 +140,194 @@ TEST(DistanceOracleCHDijkstraTest, StgRegbzTest)
         EXPECT_EQ(dijk_dist, dist);
     }
 }
+
+TEST(DistanceOracleCHDijkstraTest, AndorraSharedEngineParallelTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    std::vector<std::pair<common::NodeID, common::NodeID>> queries;
+    for(std::size_t i = 0; i < 2000; i++) {
+        queries.emplace_back(common::NodeID{(i * 7919) % number_of_nodes},
+                             common::NodeID{(i * 104729 + 13) % number_of_nodes});
+    }
+
+    // sequential reference with an explicit context
+    auto context = dijkstra.createSearchContext();
+    std::vector<common::Weight> expected;
+    for(const auto& [source, target] : queries) {
+        expected.emplace_back(dijkstra.distanceBetween(context, source, target));
+    }
+
+    // all threads query the same engine, each with its own pooled context
+    std::vector<common::Weight> results(queries.size());
+    std::transform(std::execution::par,
+                   std::begin(queries),
+                   std::end(queries),
+                   std::begin(results),
+                   [&](const auto query) {
+                       return dijkstra.distanceBetween(query.first, query.second);
+                   });
+
+    EXPECT_EQ(results, expected);
+}
+
+TEST(DistanceOracleCHDijkstraTest, AndorraQueryStatisticsTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+    const algorithms::distoracle::CHDijkstra<decltype(graph), true, util::QueryStatistics> instrumented{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 100; i++) {
+        const common::NodeID source{(i * 7919) % number_of_nodes};
+        const common::NodeID target{(i * 104729 + 13) % number_of_nodes};
+
+        EXPECT_EQ(instrumented.distanceBetween(source, target), dijkstra.distanceBetween(source, target));
+
+        const auto& last = instrumented.localStatistics();
+        EXPECT_GT(last.lastQuery(util::QueryCounter::SETTLED_NODES), 0ul);
+        EXPECT_LE(last.lastQuery(util::QueryCounter::STALLED_NODES),
+                  last.lastQuery(util::QueryCounter::SETTLED_NODES));
+        EXPECT_LE(last.lastQuery(util::QueryCounter::QUEUE_PUSHES),
+                  last.lastQuery(util::QueryCounter::RELAXED_EDGES));
+    }
+
+    const auto statistics = instrumented.statistics();
+    EXPECT_EQ(statistics.numberOfQueries(), 100ul);
+    EXPECT_GE(statistics.total(util::QueryCounter::SETTLED_NODES),
+              statistics.max(util::QueryCounter::SETTLED_NODES));
+}
+
+TEST(DistanceOracleCHDijkstraTest, AndorraInterleavedQueryTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    const algorithms::distoracle::CHDijkstra<decltype(graph), true, util::QueryStatistics> dijkstra{graph};
+    const algorithms::distoracle::CHDijkstra<decltype(graph), false, util::QueryStatistics> unstalled{graph};
+
+    std::size_t exhaustive_settled = 0;
+    std::size_t interleaved_settled = 0;
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 100; i++) {
+        const common::NodeID source{(i * 7919) % number_of_nodes};
+        const common::NodeID target{(i * 104729 + 13) % number_of_nodes};
+
+        const auto expected = dijkstra.distanceBetween(source, target);
+        exhaustive_settled += dijkstra.localStatistics().lastQuery(util::QueryCounter::SETTLED_NODES);
+
+        EXPECT_EQ(dijkstra.distanceBetweenInterleaved(source, target), expected);
+        interleaved_settled += dijkstra.localStatistics().lastQuery(util::QueryCounter::SETTLED_NODES);
+
+        EXPECT_EQ(unstalled.distanceBetweenInterleaved(source, target), expected);
+        EXPECT_EQ(dijkstra.distanceBetweenInterleaved(source, source), common::Weight{0});
+
+        // the partial searches of the interleaved query must not be reused
+        EXPECT_EQ(dijkstra.distanceBetween(source, target), expected);
+    }
+
+    EXPECT_LT(interleaved_settled, exhaustive_settled);
+}
+
+TEST(DistanceOracleCHDijkstraTest, AndorraSearchSpaceCacheTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+    algorithms::distoracle::CHDijkstra cached{graph};
+    cached.enableSearchSpaceCache(4, 2, 2);
+
+    ASSERT_NE(cached.sourceSearchSpaceCache(), nullptr);
+    ASSERT_NE(cached.targetSearchSpaceCache(), nullptr);
+
+    // few hot sources and targets, every pair is queried twice with other pairs in between
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t round = 0; round < 3; round++) {
+        for(std::size_t i = 0; i < 40; i++) {
+            const common::NodeID source{((i % 3) * 7919) % number_of_nodes};
+            const common::NodeID target{((i % 5) * 104729 + 13) % number_of_nodes};
+
+            EXPECT_EQ(cached.distanceBetween(source, target), dijkstra.distanceBetween(source, target));
+        }
+    }
+
+    const auto* source_cache = cached.sourceSearchSpaceCache();
+    EXPECT_GT(source_cache->hits(), 0ul);
+    EXPECT_GT(source_cache->insertions(), 0ul);
+    EXPECT_EQ(source_cache->hits() + source_cache->misses(), 120ul);
+    EXPECT_GT(cached.targetSearchSpaceCache()->hitRate(), 0.5);
+
+    // the parents of a cached search space form a tree of upward edges
+    const auto search_space = source_cache->peek(common::NodeID{0});
+    ASSERT_NE(search_space, nullptr);
+
+    for(const auto& entry : *search_space) {
+        if(entry.node_ == common::NodeID{0}) {
+            EXPECT_EQ(entry.distance_, common::Weight{0});
+            EXPECT_EQ(entry.parent_, common::UNKNOWN_NODE_ID);
+            continue;
+        }
+
+        ASSERT_NE(entry.parent_, common::UNKNOWN_NODE_ID);
+        const auto* edge = graph.getForwardEdgeBetween(entry.parent_, entry.node_);
+        ASSERT_NE(edge, nullptr);
+
+        const auto parent = std::find_if(std::begin(*search_space),
+                                         std::end(*search_space),
+                                         [&](const auto& other) {
+                                             return other.node_ == entry.parent_;
+                                         });
+        ASSERT_NE(parent, std::end(*search_space));
+        EXPECT_EQ(parent->distance_ + edge->getWeight(), entry.distance_);
+    }
+
+    // the caches are shared by all threads
+    std::vector<std::pair<common::NodeID, common::NodeID>> queries;
+    std::vector<common::Weight> expected;
+    for(std::size_t i = 0; i < 1000; i++) {
+        const common::NodeID source{((i % 7) * 7919) % number_of_nodes};
+        const common::NodeID target{((i % 11) * 104729 + 13) % number_of_nodes};
+        queries.emplace_back(source, target);
+        expected.emplace_back(dijkstra.distanceBetween(source, target));
+    }
+
+    std::vector<common::Weight> results(queries.size());
+    std::transform(std::execution::par,
+                   std::begin(queries),
+                   std::end(queries),
+                   std::begin(results),
+                   [&](const auto query) {
+                       return cached.distanceBetween(query.first, query.second);
+                   });
+
+    EXPECT_EQ(results, expected);
+    EXPECT_GT(source_cache->evictions(), 0ul);
+}
@@ -0,0 +1,94 @@
+// all the includes you want to use before the gtest include
+
+#include "../../../globals.hpp"
+#include <algorithms/distoracle/dijkstra/DeltaStepping.hpp>
+#include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
+#include <execution>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(DistanceOracleDeltaSteppingTest, ToyOneToAllTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+
+    // every edge is light, heavy or both kinds occur
+    for(const auto delta : {1l, 3l, 100l}) {
+        const algorithms::distoracle::DeltaStepping delta_stepping{graph, common::Weight{delta}};
+
+        for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+            EXPECT_EQ(delta_stepping.distancesFrom(common::NodeID{i}),
+                      dijkstra.distancesFrom(common::NodeID{i}));
+        }
+    }
+}
+
+TEST(DistanceOracleDeltaSteppingTest, AndorraOneToAllTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+    const algorithms::distoracle::DeltaStepping<std::remove_cvref_t<decltype(graph)>, util::QueryStatistics> delta_stepping{graph};
+
+    EXPECT_GE(delta_stepping.getDelta(), common::Weight{1});
+
+    std::vector<common::NodeID> sources;
+    for(std::size_t i = 0; i < 16; i++) {
+        sources.emplace_back((i * 7919) % graph.numberOfNodes());
+    }
+
+    // the queries of different threads run at the same time as the parallel relaxations
+    std::vector<bool> equal(sources.size());
+    std::transform(std::execution::par,
+                   std::begin(sources),
+                   std::end(sources),
+                   std::begin(equal),
+                   [&](const auto source) {
+                       const auto distances = delta_stepping.distancesFrom(source);
+                       return distances == dijkstra.distancesFrom(source);
+                   });
+
+    EXPECT_TRUE(std::all_of(std::begin(equal), std::end(equal), [](const auto e) { return e; }));
+
+    const auto statistics = delta_stepping.statistics();
+    EXPECT_EQ(statistics.numberOfQueries(), sources.size());
+    EXPECT_GE(statistics.total(util::QueryCounter::SETTLED_NODES), sources.size());
+}
+
+TEST(DistanceOracleDeltaSteppingTest, AndorraDistanceTableTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+    const algorithms::distoracle::DeltaStepping delta_stepping{graph, common::Weight{1000}};
+
+    const std::vector sources{common::NodeID{0}, common::NodeID{42}, common::NodeID{1000}};
+    const std::vector targets{common::NodeID{7}, common::NodeID{4242}, common::NodeID{10000}, common::NodeID{0}};
+
+    std::vector<common::Weight> out(sources.size() * targets.size());
+    std::vector<common::Weight> expected(sources.size() * targets.size());
+    ASSERT_TRUE(delta_stepping.distanceTable(sources, targets, out));
+    ASSERT_TRUE(dijkstra.distanceTable(sources, targets, expected));
+    EXPECT_EQ(out, expected);
+
+    std::vector<common::Weight> too_small(1);
+    EXPECT_FALSE(delta_stepping.distanceTable(sources, targets, too_small));
+}
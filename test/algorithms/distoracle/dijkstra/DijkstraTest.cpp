@@ -111,3 +111,30 @@ TEST(DistanceOracleDijkstraTest, StgRegbzTest)
         EXPECT_EQ(dijk_dist, dist);
     }
 }
+
+TEST(DistanceOracleDijkstraTest, DistanceTableTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+
+    const std::vector sources{common::NodeID{0}, common::NodeID{1}, common::NodeID{4}};
+    const std::vector targets{common::NodeID{3}, common::NodeID{0}, common::NodeID{1}};
+    std::vector<common::Weight> table(sources.size() * targets.size());
+
+    ASSERT_TRUE(dijkstra.distanceTable(sources, targets, table));
+
+    EXPECT_EQ(table[0], common::Weight{8});
+    EXPECT_EQ(table[1], common::Weight{0});
+    EXPECT_EQ(table[2], common::Weight{9});
+    EXPECT_EQ(table[3], common::INFINITY_WEIGHT);
+    EXPECT_EQ(table[4], common::INFINITY_WEIGHT);
+    EXPECT_EQ(table[5], common::Weight{0});
+    EXPECT_EQ(table[6], common::Weight{1});
+    EXPECT_EQ(table[7], common::Weight{10});
+    EXPECT_EQ(table[8], common::Weight{2});
+}
@@ -64,6 +64,34 @@ TEST(DistanceOracleHubLabelTest, ParallelHubLabelToyTest)
     }
 }
 
+TEST(DistanceOracleHubLabelTest, HubLabelDistanceTableToyTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForHubLabelCalculator(std::move(graph));
+
+    algorithms::distoracle::HubLabelCalculator calculator{graph};
+    const auto hl_lookup = calculator.constructHubLabelLookup();
+
+    std::vector<common::NodeID> nodes;
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        nodes.emplace_back(i);
+    }
+
+    std::vector<common::Weight> table(nodes.size() * nodes.size());
+    ASSERT_TRUE(hl_lookup.distanceTable(nodes, nodes, table));
+
+    for(std::size_t i = 0; i < nodes.size(); i++) {
+        for(std::size_t j = 0; j < nodes.size(); j++) {
+            EXPECT_EQ(table[i * nodes.size() + j], hl_lookup.distanceBetween(nodes[i], nodes[j]));
+        }
+    }
+}
+
 TEST(DistanceOracleHubLabelTest, HubLabelNodePermutationTest)
 {
     auto example_graph = data_dir + "ch-fmi-example.txt";
@@ -266,3 +294,41 @@ TEST(DistanceOracleHubLabelTest, StgRegbzPermutationTest)
 }
 
 #endif
+
+TEST(DistanceOracleHubLabelTest, HubLabelQueryStatisticsToyTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForHubLabelCalculator(std::move(graph));
+
+    algorithms::distoracle::HubLabelCalculator calculator{graph};
+    const auto hl_lookup = calculator.constructHubLabelLookup();
+
+    algorithms::distoracle::HubLabelCalculator instrumented_calculator{graph};
+    const algorithms::distoracle::BasicHubLabelLookup<util::QueryStatistics> instrumented{
+        instrumented_calculator.constructHubLabelLookup()};
+
+    std::vector<common::NodeID> nodes;
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        nodes.emplace_back(i);
+    }
+
+    for(const auto source : nodes) {
+        for(const auto target : nodes) {
+            EXPECT_EQ(instrumented.distanceBetween(source, target), hl_lookup.distanceBetween(source, target));
+            EXPECT_GT(instrumented.localStatistics().lastQuery(util::QueryCounter::SCANNED_LABEL_ENTRIES), 0ul);
+        }
+    }
+
+    // every row of a table is a single query
+    std::vector<common::Weight> table(nodes.size() * nodes.size());
+    ASSERT_TRUE(instrumented.distanceTable(nodes, nodes, table));
+
+    const auto statistics = instrumented.statistics();
+    EXPECT_EQ(statistics.numberOfQueries(), nodes.size() * nodes.size() + nodes.size());
+    EXPECT_EQ(statistics.total(util::QueryCounter::SETTLED_NODES), 0ul);
+}
@@ -0,0 +1,91 @@
+//all the includes you want to use before the gtest include
+#include "../../../globals.hpp"
+#include <algorithm>
+#include <algorithms/distoracle/patches/WSPD.hpp>
+#include <algorithms/distoracle/patches/quadtree/QuadTreeConstructor.hpp>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+auto sortPairs(std::vector<algorithms::WellSeparatedPair> pairs) noexcept
+    -> std::vector<algorithms::WellSeparatedPair>
+{
+    std::sort(std::begin(pairs),
+              std::end(pairs),
+              [](const auto& lhs, const auto& rhs) {
+                  return std::pair{lhs.first_, lhs.second_} < std::pair{rhs.first_, rhs.second_};
+              });
+    return pairs;
+}
+
+// every unordered pair of nodes has to be covered by exactly one pair of the decomposition,
+// nodes at the same position end up together in one leaf and are not covered
+auto numberOfCoveredNodePairs(const algorithms::QuadTree& tree,
+                              const std::vector<algorithms::WellSeparatedPair>& pairs) noexcept
+    -> std::size_t
+{
+    std::size_t covered = 0;
+    for(const auto& pair : pairs) {
+        covered += tree.getNode(pair.first_).size() * tree.getNode(pair.second_).size();
+    }
+
+    for(std::size_t i = 0; i < tree.numberOfNodes(); i++) {
+        const auto& node = tree.getNode(i);
+        if(node.isLeaf()) {
+            covered += node.size() * (node.size() - std::min(node.size(), std::size_t{1})) / 2;
+        }
+    }
+
+    return covered;
+}
+
+} // namespace
+
+TEST(WSPDTest, ToyWSPDTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    auto tree_opt = algorithms::QuadTreeConstructor{graph}.constuctQuadTree();
+    ASSERT_TRUE(tree_opt);
+    const auto& tree = tree_opt.value();
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    const auto wspd = algorithms::calculateWSPD(tree, 0.5);
+
+    EXPECT_EQ(numberOfCoveredNodePairs(tree, wspd), number_of_nodes * (number_of_nodes - 1) / 2);
+    EXPECT_EQ(algorithms::countWSPDPairs(tree, 0.5), wspd.size());
+    EXPECT_EQ(sortPairs(algorithms::calculateWSPDInParallel(tree, 0.5)), sortPairs(wspd));
+}
+
+TEST(WSPDTest, AndorraParallelWSPDTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    auto tree_opt = algorithms::QuadTreeConstructor{graph}.constuctQuadTree();
+    ASSERT_TRUE(tree_opt);
+    const auto& tree = tree_opt.value();
+
+    const auto number_of_nodes = graph.numberOfNodes();
+
+    for(const auto epsilon : {2.0, 0.5}) {
+        const auto wspd = algorithms::calculateWSPD(tree, epsilon);
+        const auto parallel_wspd = algorithms::calculateWSPDInParallel(tree, epsilon);
+
+        EXPECT_EQ(algorithms::countWSPDPairs(tree, epsilon), wspd.size());
+        EXPECT_EQ(sortPairs(parallel_wspd), sortPairs(wspd));
+        EXPECT_EQ(numberOfCoveredNodePairs(tree, parallel_wspd), number_of_nodes * (number_of_nodes - 1) / 2);
+    }
+}
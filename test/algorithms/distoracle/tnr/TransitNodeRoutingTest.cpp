@@ -0,0 +1,136 @@
+//all the includes you want to use before the gtest include
+
+#include "../../../globals.hpp"
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelCalculator.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelLookup.hpp>
+#include <algorithms/distoracle/tnr/TransitNodeRouting.hpp>
+#include <execution>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/CHSearchGraph.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(DistanceOracleTransitNodeRoutingTest, ToyAllPairsTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+
+    for(std::size_t number_of_transit_nodes = 0; number_of_transit_nodes <= graph.numberOfNodes(); number_of_transit_nodes++) {
+        const algorithms::distoracle::TransitNodeRouting tnr{graph, number_of_transit_nodes};
+
+        EXPECT_GE(tnr.numberOfTransitNodes(), 1ul);
+        EXPECT_LE(tnr.numberOfTransitNodes(), std::max(number_of_transit_nodes, 1ul));
+
+        for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+            for(std::size_t j = 0; j < graph.numberOfNodes(); j++) {
+                EXPECT_EQ(tnr.distanceBetween(common::NodeID{i}, common::NodeID{j}),
+                          dijkstra.distanceBetween(common::NodeID{i}, common::NodeID{j}));
+            }
+        }
+    }
+}
+
+TEST(DistanceOracleTransitNodeRoutingTest, AndorraTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+
+    using Graph = std::remove_cvref_t<decltype(graph)>;
+    const algorithms::distoracle::CHDijkstra<Graph, true, util::QueryStatistics> dijkstra{graph};
+    const algorithms::distoracle::TransitNodeRouting<Graph, util::QueryStatistics> tnr{graph, 256};
+
+    EXPECT_LE(tnr.numberOfTransitNodes(), 256ul);
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    std::vector<std::pair<common::NodeID, common::NodeID>> queries;
+    for(std::size_t i = 0; i < 2000; i++) {
+        queries.emplace_back(common::NodeID{(i * 7919) % number_of_nodes},
+                             common::NodeID{(i * 104729 + 13) % number_of_nodes});
+    }
+
+    std::vector<common::Weight> results(queries.size());
+    std::transform(std::execution::par,
+                   std::begin(queries),
+                   std::end(queries),
+                   std::begin(results),
+                   [&](const auto query) {
+                       return tnr.distanceBetween(query.first, query.second);
+                   });
+
+    std::size_t local_queries = 0;
+    for(std::size_t i = 0; i < queries.size(); i++) {
+        const auto [source, target] = queries[i];
+        EXPECT_EQ(results[i], dijkstra.distanceBetween(source, target));
+        local_queries += tnr.isLocal(source, target);
+    }
+
+    // most of the random queries are long distance queries
+    EXPECT_LT(local_queries, queries.size() / 2);
+
+    const auto statistics = tnr.statistics();
+    EXPECT_EQ(statistics.numberOfQueries(), queries.size());
+    EXPECT_EQ(statistics.total(util::QueryCounter::ORACLE_QUERIES), local_queries);
+
+    // the searches of the locality filter stop at the transit nodes
+    const auto settled_nodes = statistics.total(util::QueryCounter::SETTLED_NODES);
+    EXPECT_GT(settled_nodes, 0ul);
+    EXPECT_LT(settled_nodes, dijkstra.statistics().total(util::QueryCounter::SETTLED_NODES));
+    RecordProperty("settled_nodes", std::to_string(settled_nodes));
+}
+
+TEST(DistanceOracleTransitNodeRoutingTest, AndorraMemoryTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+    const graphs::CHSearchGraph search_graph{graph};
+
+    const algorithms::distoracle::TransitNodeRouting tnr{search_graph, 256};
+
+    algorithms::distoracle::HubLabelCalculator calculator{search_graph};
+    const auto hl_lookup = calculator.constructHubLabelLookupInParallel();
+
+    // only the table and the access nodes are stored, no search spaces
+    EXPECT_LT(tnr.memoryUsage(), hl_lookup.memoryUsage() / 4);
+    RecordProperty("tnr_bytes", std::to_string(tnr.memoryUsage()));
+    RecordProperty("hl_bytes", std::to_string(hl_lookup.memoryUsage()));
+}
+
+TEST(DistanceOracleTransitNodeRoutingTest, AndorraSearchGraphTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+    const graphs::CHSearchGraph search_graph{graph};
+
+    const algorithms::distoracle::CHDijkstra dijkstra{search_graph};
+    const algorithms::distoracle::TransitNodeRouting tnr{search_graph, 128};
+
+    const auto number_of_nodes = search_graph.numberOfNodes();
+    for(std::size_t i = 0; i < 500; i++) {
+        const common::NodeID source{(i * 7919) % number_of_nodes};
+        const common::NodeID target{(i * 104729 + 13) % number_of_nodes};
+        EXPECT_EQ(tnr.distanceBetween(source, target), dijkstra.distanceBetween(source, target));
+    }
+}
@@ -0,0 +1,98 @@
+//all the includes you want to use before the gtest include
+
+#include "../../../globals.hpp"
+#include <algorithms/pathfinding/astar/AStar.hpp>
+#include <algorithms/pathfinding/astar/GreatCirclePotential.hpp>
+#include <algorithms/pathfinding/astar/LandmarkPotential.hpp>
+#include <algorithms/pathfinding/dijkstra/Dijkstra.hpp>
+#include <fmt/ranges.h>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+
+TEST(PathFindingAStarTest, ToyLandmarkTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    for(const auto selection : {algorithms::pathfinding::LandmarkSelection::FARTHEST,
+                                algorithms::pathfinding::LandmarkSelection::AVOID}) {
+        algorithms::pathfinding::LandmarkPotential potential{graph, 2, selection};
+        algorithms::pathfinding::AStar astar{graph, potential};
+        algorithms::pathfinding::Dijkstra dijkstra{graph};
+
+        // a temporary potential would dangle inside of the engine
+        static_assert(!std::is_constructible_v<decltype(astar), const decltype(graph)&, decltype(potential)&&>);
+
+        EXPECT_EQ(potential.getLandmarks().size(), 2);
+
+        for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+            for(std::size_t j = 0; j < graph.numberOfNodes(); j++) {
+                const auto source = common::NodeID{i};
+                const auto target = common::NodeID{j};
+
+                EXPECT_EQ(astar.distanceBetween(source, target),
+                          dijkstra.distanceBetween(source, target));
+            }
+        }
+
+        auto actual_opt = astar.pathBetween(common::NodeID{4}, common::NodeID{0});
+        ASSERT_TRUE(actual_opt);
+        auto expected = graphs::Path{std::vector{common::NodeID{4}, common::NodeID{3}, common::NodeID{2}, common::NodeID{0}}, common::Weight{10}};
+        EXPECT_EQ(actual_opt.value(), expected);
+
+        EXPECT_FALSE(astar.pathBetween(common::NodeID{1}, common::NodeID{0}));
+    }
+}
+
+TEST(PathFindingAStarTest, AndorraCompareWithDijkstraTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    common::Speed max_speed{0};
+    for(std::size_t i = 0; i < graph.numberOfEdges(); i++) {
+        max_speed = std::max(max_speed, graph.getEdge(common::EdgeID{i})->getSpeed());
+    }
+
+    // the weights of the andorra graph are travel times in 1/100 seconds
+    using GreatCircle = algorithms::pathfinding::GreatCirclePotential<decltype(graph)>;
+    const auto weight_per_meter = GreatCircle::travelTimeWeightPerMeter(max_speed, 100);
+    const GreatCircle great_circle{graph, weight_per_meter};
+    const algorithms::pathfinding::LandmarkPotential farthest{graph, 8, algorithms::pathfinding::LandmarkSelection::FARTHEST};
+    const algorithms::pathfinding::LandmarkPotential avoid{graph, 8, algorithms::pathfinding::LandmarkSelection::AVOID};
+
+    algorithms::pathfinding::AStar great_circle_astar{graph, great_circle};
+    algorithms::pathfinding::AStar farthest_astar{graph, farthest};
+    algorithms::pathfinding::AStar avoid_astar{graph, avoid};
+    algorithms::pathfinding::Dijkstra dijkstra{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 100; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto target = common::NodeID{(i * 104729 + 13) % number_of_nodes};
+
+        const auto expected = dijkstra.distanceBetween(source, target);
+        EXPECT_EQ(great_circle_astar.distanceBetween(source, target), expected);
+        EXPECT_EQ(farthest_astar.distanceBetween(source, target), expected);
+        EXPECT_EQ(avoid_astar.distanceBetween(source, target), expected);
+
+        const auto path_opt = avoid_astar.pathBetween(source, target);
+        ASSERT_EQ(path_opt.has_value(), expected != common::INFINITY_WEIGHT);
+        if(path_opt) {
+            EXPECT_EQ(path_opt->getSource(), source);
+            EXPECT_EQ(path_opt->getTarget(), target);
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <algorithms/pathfinding/ch/CHDijkstra.hpp>
 #include <fmt/ranges.h>
 #include <graphs/edges/FMIEdge.hpp>
+#include <graphs/edges/PackedFMIEdge.hpp>
 #include <graphs/nodes/FMINode.hpp>
 #include <graphs/offsetarray/OffsetArray.hpp>
 #include <parsing/offsetarray/Parser.hpp>
@@ -327,3 +328,153 @@ TEST(PathFindingCHDijkstraTest, MixedSourcesPathTest)
     expected = graphs::Path{std::vector{common::NodeID{4}, common::NodeID{3}}, common::Weight{1}};
     EXPECT_EQ(actual, expected);
 }
+
+TEST(PathFindingCHDijkstraTest, AndorraPackedEdgesTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+    auto packed_graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::PackedFMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    ASSERT_TRUE(packed_graph_opt);
+    auto graph = algorithms::pathfinding::prepareGraphForCHDijkstra(std::move(graph_opt.value()));
+    auto packed_graph = algorithms::pathfinding::prepareGraphForCHDijkstra(std::move(packed_graph_opt.value()));
+
+    algorithms::pathfinding::CHDijkstra dijkstra{graph};
+    algorithms::pathfinding::CHDijkstra packed_dijkstra{packed_graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 200; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto target = common::NodeID{(i * 104729 + 13) % number_of_nodes};
+
+        EXPECT_EQ(packed_dijkstra.distanceBetween(source, target),
+                  dijkstra.distanceBetween(source, target));
+        EXPECT_EQ(packed_dijkstra.pathBetween(source, target),
+                  dijkstra.pathBetween(source, target));
+    }
+}
+
+TEST(PathFindingCHDijkstraTest, UnpackedEdgesTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = algorithms::pathfinding::prepareGraphForCHDijkstra(std::move(graph_opt.value()));
+
+    algorithms::pathfinding::CHDijkstra dijkstra{graph};
+
+    EXPECT_FALSE(dijkstra.unpackedEdgesBetween(common::NodeID{1}, common::NodeID{0}));
+
+    for(std::size_t s = 0; s < graph.numberOfNodes(); s++) {
+        for(std::size_t t = 0; t < graph.numberOfNodes(); t++) {
+            const auto source = common::NodeID{s};
+            const auto target = common::NodeID{t};
+            const auto path = dijkstra.pathBetween(source, target);
+            const auto range = dijkstra.unpackedEdgesBetween(source, target);
+
+            ASSERT_EQ(path.has_value(), range.has_value());
+            if(!path) {
+                continue;
+            }
+
+            std::size_t idx = 0;
+            common::Weight cost{0};
+            for(const auto id : range.value()) {
+                const auto* edge = graph.getEdge(id);
+                EXPECT_FALSE(edge->isShortcut());
+                EXPECT_EQ(edge->getSrc(), path.value()[idx]);
+                EXPECT_EQ(edge->getTrg(), path.value()[idx + 1]);
+                cost += edge->getWeight();
+                idx++;
+            }
+
+            EXPECT_EQ(cost, path->getCost());
+        }
+    }
+}
+
+TEST(PathFindingCHDijkstraTest, AndorraShortcutCacheTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = algorithms::pathfinding::prepareGraphForCHDijkstra(std::move(graph_opt.value()));
+
+    const auto usage = graphs::countShortcutReferences(graph);
+    const graphs::ShortcutCache cache{graph, usage, 1000};
+    EXPECT_EQ(cache.numberOfCachedShortcuts(), 1000);
+
+    algorithms::pathfinding::CHDijkstra dijkstra{graph};
+    algorithms::pathfinding::CHDijkstra cached_dijkstra{graph, cache};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 200; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto target = common::NodeID{(i * 104729 + 13) % number_of_nodes};
+
+        EXPECT_EQ(cached_dijkstra.pathBetween(source, target),
+                  dijkstra.pathBetween(source, target));
+    }
+
+    // a usage which does not cover all edges counts the missing ones as unused
+    const auto half = usage.size() / 2;
+    const graphs::ShortcutCache partial_cache{graph, std::span{usage}.first(half), graph.numberOfEdges()};
+    EXPECT_GT(partial_cache.numberOfCachedShortcuts(), 0ul);
+
+    for(std::size_t i = 0; i < graph.numberOfEdges(); i++) {
+        const common::EdgeID id{i};
+        if(i >= half or usage[i] == 0 or !graph.getEdge(id)->isShortcut()) {
+            EXPECT_FALSE(partial_cache.getUnpackedNodes(id));
+        } else {
+            EXPECT_TRUE(partial_cache.getUnpackedNodes(id));
+        }
+    }
+    EXPECT_FALSE(partial_cache.getUnpackedNodes(common::EdgeID{graph.numberOfEdges()}));
+}
+
+TEST(PathFindingCHDijkstraTest, AndorraEdgePathTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = algorithms::pathfinding::prepareGraphForCHDijkstra(std::move(graph_opt.value()));
+
+    algorithms::pathfinding::CHDijkstra dijkstra{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 200; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto target = common::NodeID{(i * 104729 + 13) % number_of_nodes};
+
+        const auto path = dijkstra.pathBetween(source, target);
+        const auto edge_path = dijkstra.edgePathBetween(source, target);
+
+        ASSERT_EQ(path.has_value(), edge_path.has_value());
+        if(!path) {
+            continue;
+        }
+
+        EXPECT_EQ(edge_path->source(), source);
+        EXPECT_EQ(edge_path->target(), target);
+        EXPECT_EQ(edge_path->cost(), path->getCost());
+
+        if(source == target) {
+            EXPECT_EQ(edge_path->numberOfNodes(), 1);
+            continue;
+        }
+
+        EXPECT_EQ(edge_path->toPath(), path.value());
+
+        std::vector<std::pair<common::Latitude, common::Longitude>> coordinates;
+        for(std::size_t j = 0; j < path->getNumberOfNodes(); j++) {
+            const auto* node = graph.getNode(path.value()[j]);
+            coordinates.emplace_back(node->getLat(), node->getLng());
+        }
+
+        EXPECT_EQ(edge_path->toPolyline(), util::encodePolyline(coordinates));
+    }
+}
@@ -0,0 +1,119 @@
+//all the includes you want to use before the gtest include
+
+#include "../../../globals.hpp"
+#include <algorithms/pathfinding/dijkstra/BidirectionalDijkstra.hpp>
+#include <algorithms/pathfinding/dijkstra/Dijkstra.hpp>
+#include <fmt/ranges.h>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+
+TEST(PathFindingBidirectionalDijkstraTest, ToyDistanceTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    algorithms::pathfinding::BidirectionalDijkstra dijkstra{graph};
+
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{0}, common::NodeID{0}), common::Weight{0});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{0}, common::NodeID{1}), common::Weight{9});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{1}, common::NodeID{0}), common::INFINITY_WEIGHT);
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{0}, common::NodeID{2}), common::Weight{8});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{1}, common::NodeID{2}), common::INFINITY_WEIGHT);
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{0}, common::NodeID{3}), common::Weight{8});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{1}, common::NodeID{3}), common::INFINITY_WEIGHT);
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{0}, common::NodeID{4}), common::Weight{7});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{1}, common::NodeID{4}), common::INFINITY_WEIGHT);
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{2}, common::NodeID{0}), common::Weight{6});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{3}, common::NodeID{0}), common::Weight{9});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{4}, common::NodeID{0}), common::Weight{10});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{2}, common::NodeID{1}), common::Weight{5});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{3}, common::NodeID{1}), common::Weight{8});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{4}, common::NodeID{1}), common::Weight{2});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{2}, common::NodeID{3}), common::Weight{5});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{3}, common::NodeID{2}), common::Weight{3});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{4}, common::NodeID{2}), common::Weight{4});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{2}, common::NodeID{4}), common::Weight{4});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{3}, common::NodeID{4}), common::Weight{7});
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{4}, common::NodeID{3}), common::Weight{1});
+}
+
+TEST(PathFindingBidirectionalDijkstraTest, ToyPathTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    algorithms::pathfinding::BidirectionalDijkstra dijkstra{graph};
+
+    auto actual_opt = dijkstra.pathBetween(common::NodeID{0}, common::NodeID{3});
+    ASSERT_TRUE(actual_opt);
+    auto actual = std::move(actual_opt.value());
+    auto expected = graphs::Path{std::vector{common::NodeID{0}, common::NodeID{4}, common::NodeID{3}}, common::Weight{8}};
+    EXPECT_EQ(actual, expected);
+
+    actual_opt = dijkstra.pathBetween(common::NodeID{4}, common::NodeID{0});
+    ASSERT_TRUE(actual_opt);
+    actual = std::move(actual_opt.value());
+    expected = graphs::Path{std::vector{common::NodeID{4}, common::NodeID{3}, common::NodeID{2}, common::NodeID{0}}, common::Weight{10}};
+    EXPECT_EQ(actual, expected);
+
+    actual_opt = dijkstra.pathBetween(common::NodeID{2}, common::NodeID{2});
+    ASSERT_TRUE(actual_opt);
+    actual = std::move(actual_opt.value());
+    expected = graphs::Path{std::vector{common::NodeID{2}}, common::Weight{0}};
+    EXPECT_EQ(actual, expected);
+
+    actual_opt = dijkstra.pathBetween(common::NodeID{1}, common::NodeID{4});
+    ASSERT_FALSE(actual_opt);
+}
+
+TEST(PathFindingBidirectionalDijkstraTest, AndorraCompareWithDijkstraTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    algorithms::pathfinding::BidirectionalDijkstra bidirectional{graph};
+    algorithms::pathfinding::Dijkstra dijkstra{graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 200; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto target = common::NodeID{(i * 104729 + 13) % number_of_nodes};
+
+        const auto expected = dijkstra.distanceBetween(source, target);
+        EXPECT_EQ(bidirectional.distanceBetween(source, target), expected);
+
+        const auto path_opt = bidirectional.pathBetween(source, target);
+        ASSERT_EQ(path_opt.has_value(), expected != common::INFINITY_WEIGHT);
+
+        if(path_opt) {
+            const auto& path = path_opt.value();
+            EXPECT_EQ(path.getCost(), expected);
+            EXPECT_EQ(path.getSource(), source);
+            EXPECT_EQ(path.getTarget(), target);
+
+            //every consecutive pair of nodes has to be connected by an edge
+            common::Weight cost{0};
+            for(std::size_t j = 1; j < path.getNumberOfNodes(); j++) {
+                const auto* edge = graph.getForwardEdgeBetween(path[j - 1], path[j]);
+                ASSERT_NE(edge, nullptr);
+                cost += edge->getWeight();
+            }
+            EXPECT_LE(cost, expected);
+        }
+    }
+}
@@ -327,3 +327,87 @@ TEST(PathFindingDijkstraTest, MixedSourcesPathTest)
     expected = graphs::Path{std::vector{common::NodeID{4}, common::NodeID{3}}, common::Weight{1}};
     EXPECT_EQ(actual, expected);
 }
+
+TEST(PathFindingDijkstraTest, DistancesToTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    const algorithms::pathfinding::Dijkstra dijkstra{graph};
+
+    const std::vector targets{common::NodeID{3}, common::NodeID{1}, common::NodeID{3}, common::NodeID{0}};
+    const auto distances = dijkstra.distancesTo(common::NodeID{4}, targets);
+
+    ASSERT_EQ(distances.size(), 4);
+    EXPECT_EQ(distances[0], common::Weight{1});
+    EXPECT_EQ(distances[1], common::Weight{2});
+    EXPECT_EQ(distances[2], common::Weight{1});
+    EXPECT_EQ(distances[3], common::Weight{10});
+
+    // the search of node 4 is continued
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{4}, common::NodeID{2}), common::Weight{4});
+
+    const auto unreachable = dijkstra.distancesTo(common::NodeID{1}, targets);
+    EXPECT_EQ(unreachable[0], common::INFINITY_WEIGHT);
+    EXPECT_EQ(unreachable[1], common::Weight{0});
+    EXPECT_EQ(unreachable[3], common::INFINITY_WEIGHT);
+}
+
+TEST(PathFindingDijkstraTest, DistancesWithinTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    const algorithms::pathfinding::Dijkstra dijkstra{graph};
+
+    const auto reached = dijkstra.distancesWithin(common::NodeID{0}, common::Weight{8});
+
+    ASSERT_EQ(reached.size(), 4);
+    EXPECT_EQ(reached[0], std::pair(common::NodeID{0}, common::Weight{0}));
+    EXPECT_EQ(reached[1], std::pair(common::NodeID{4}, common::Weight{7}));
+    EXPECT_EQ(reached[2].second, common::Weight{8});
+    EXPECT_EQ(reached[3].second, common::Weight{8});
+
+    // the bounded search can be continued beyond the limit
+    EXPECT_EQ(dijkstra.distanceBetween(common::NodeID{0}, common::NodeID{1}), common::Weight{9});
+}
+
+TEST(PathFindingDijkstraTest, AndorraDistancesToTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    const algorithms::pathfinding::Dijkstra dijkstra{graph};
+    auto reference_context = dijkstra.createSearchContext();
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    std::vector<common::NodeID> targets;
+    for(std::size_t i = 0; i < 50; i++) {
+        targets.emplace_back((i * 104729 + 13) % number_of_nodes);
+    }
+
+    for(std::size_t i = 0; i < 5; i++) {
+        const common::NodeID source{(i * 7919) % number_of_nodes};
+        const auto distances = dijkstra.distancesTo(source, targets);
+
+        for(std::size_t j = 0; j < targets.size(); j++) {
+            EXPECT_EQ(distances[j], dijkstra.distanceBetween(reference_context, source, targets[j]));
+        }
+
+        // 10 minutes, the weights are travel times in 1/100 seconds
+        const auto limit = common::Weight{60000};
+        for(const auto& [node, dist] : dijkstra.distancesWithin(source, limit)) {
+            EXPECT_LE(dist, limit);
+            EXPECT_EQ(dist, dijkstra.distanceBetween(reference_context, source, node));
+        }
+    }
+}
@@ -0,0 +1,80 @@
+//all the includes you want to use before the gtest include
+#include <graphs/edges/PackedFMIEdge.hpp>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+TEST(PackedFMIEdgeTest, PackedFMIEdgeWithShortcutParsingTest)
+{
+    auto edge_opt = graphs::PackedFMIEdge<true>::parse("26513 26506 1177 0 -1 94502 63826");
+    ASSERT_TRUE(edge_opt);
+
+    auto edge = edge_opt.value();
+
+    EXPECT_EQ(edge.getSrc(), common::NodeID{26513});
+    EXPECT_EQ(edge.getTrg(), common::NodeID{26506});
+    EXPECT_EQ(edge.getWeight(), common::Weight{1177});
+    EXPECT_EQ(edge.getEdgeType(), common::Type{0});
+    EXPECT_EQ(edge.getSpeed(), common::Speed{-1});
+
+    auto expected = std::optional{std::pair{common::EdgeID(94502), common::EdgeID(63826)}};
+    EXPECT_EQ(edge.getShortcut(), expected);
+    EXPECT_TRUE(edge.isShortcut());
+
+    edge.setShortcut(common::EdgeID{1}, common::EdgeID{2});
+    auto expected2 = std::pair{common::EdgeID(1), common::EdgeID(2)};
+    EXPECT_EQ(edge.getShortcutUnsafe(), expected2);
+
+
+    edge_opt = graphs::PackedFMIEdge<true>::parse("26513 26504 448 13 5 -1 -1");
+    ASSERT_TRUE(edge_opt);
+
+    edge = edge_opt.value();
+
+    EXPECT_EQ(edge.getSrc(), common::NodeID{26513});
+    EXPECT_EQ(edge.getTrg(), common::NodeID{26504});
+    EXPECT_EQ(edge.getWeight(), common::Weight{448});
+    EXPECT_EQ(edge.getEdgeType(), common::Type{13});
+    EXPECT_EQ(edge.getSpeed(), common::Speed{5});
+
+    EXPECT_EQ(edge.getShortcut(), std::nullopt);
+    EXPECT_FALSE(edge.isShortcut());
+}
+
+TEST(PackedFMIEdgeTest, PackedFMIEdgeWithoutShortcutParsingTest)
+{
+    auto edge_opt = graphs::PackedFMIEdge<false>::parse("26513 26504 448 13 5");
+    ASSERT_TRUE(edge_opt);
+
+    auto edge = edge_opt.value();
+
+    EXPECT_EQ(edge.getSrc(), common::NodeID{26513});
+    EXPECT_EQ(edge.getTrg(), common::NodeID{26504});
+    EXPECT_EQ(edge.getWeight(), common::Weight{448});
+    EXPECT_EQ(edge.getEdgeType(), common::Type{13});
+    EXPECT_EQ(edge.getSpeed(), common::Speed{5});
+
+    edge.setSrc(common::NodeID{1});
+    edge.setTrg(common::NodeID{2});
+    EXPECT_EQ(edge.getSrc(), common::NodeID{1});
+    EXPECT_EQ(edge.getTrg(), common::NodeID{2});
+}
+
+TEST(PackedFMIEdgeTest, FailingPackedFMIEdgeParsingTest)
+{
+    auto edge_opt = graphs::PackedFMIEdge<true>::parse("#26513 26506 1177 0 -1 94502 63826");
+    ASSERT_FALSE(edge_opt);
+
+    edge_opt = graphs::PackedFMIEdge<true>::parse("26506 1177 0 -1 94502 63826");
+    ASSERT_FALSE(edge_opt);
+
+    // values which do not fit into the packed fields are rejected
+    edge_opt = graphs::PackedFMIEdge<true>::parse("4294967296 26506 1177 0 -1 94502 63826");
+    ASSERT_FALSE(edge_opt);
+
+    edge_opt = graphs::PackedFMIEdge<true>::parse("26513 26506 1177 0 40000 94502 63826");
+    ASSERT_FALSE(edge_opt);
+
+    auto simple_edge_opt = graphs::PackedFMIEdge<false>::parse("26513 26506 -3 13 5");
+    ASSERT_FALSE(simple_edge_opt);
+}
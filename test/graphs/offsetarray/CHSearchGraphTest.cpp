@@ -0,0 +1,127 @@
+//all the includes you want to use before the gtest include
+#include "../../globals.hpp"
+#include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelCalculator.hpp>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/CHSearchGraph.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <parsing/offsetarray/Parser.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(CHSearchGraphTest, AndorraCompareWithPreparedGraphsTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const graphs::CHSearchGraph search_graph{graph};
+    const auto ch_graph = algorithms::distoracle::prepareGraphForCHDijkstra(graph);
+    const auto phast_graph = algorithms::distoracle::prepareGraphForPHAST(graph);
+
+    ASSERT_EQ(search_graph.numberOfNodes(), graph.numberOfNodes());
+
+    const algorithms::distoracle::CHDijkstra dijkstra{ch_graph};
+    const algorithms::distoracle::CHDijkstra search_graph_dijkstra{search_graph};
+    const algorithms::distoracle::PHAST phast{phast_graph};
+    const algorithms::distoracle::BasicPHAST search_graph_phast{search_graph};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 5; i++) {
+        const auto source = common::NodeID{(i * 7919) % number_of_nodes};
+        const auto source_rank = search_graph.getRankOf(source);
+
+        for(std::size_t j = 0; j < number_of_nodes; j += 37) {
+            const auto target = common::NodeID{j};
+            const auto target_rank = search_graph.getRankOf(target);
+            EXPECT_EQ(search_graph.getOriginalNodeOf(target_rank), target);
+            EXPECT_EQ(dijkstra.distanceBetween(source, target),
+                      search_graph_dijkstra.distanceBetween(source_rank, target_rank));
+        }
+
+        // both graphs number the nodes by level descending in the same way
+        EXPECT_EQ(phast.distancesFrom(source_rank),
+                  search_graph_phast.distancesFrom(source_rank));
+    }
+}
+
+TEST(CHSearchGraphTest, ToyHubLabelTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const graphs::CHSearchGraph search_graph{graph};
+    const auto ch_graph = algorithms::distoracle::prepareGraphForCHDijkstra(graph);
+
+    algorithms::distoracle::HubLabelCalculator calculator{search_graph};
+    const auto lookup = calculator.constructHubLabelLookupInParallel();
+    const algorithms::distoracle::CHDijkstra dijkstra{ch_graph};
+
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        for(std::size_t j = 0; j < graph.numberOfNodes(); j++) {
+            const auto source = common::NodeID{i};
+            const auto target = common::NodeID{j};
+
+            EXPECT_EQ(dijkstra.distanceBetween(source, target),
+                      lookup.distanceBetween(search_graph.getRankOf(source),
+                                             search_graph.getRankOf(target)));
+        }
+    }
+}
+
+TEST(CHSearchGraphTest, AndorraUnpackArcsTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    const graphs::CHSearchGraph search_graph{graph};
+
+    // the unpacked edges of an arc form a path of original edges with the weight of the arc
+    const auto check_arc = [&](const auto& arc, auto src, auto trg, const auto& edge_ids) {
+        ASSERT_FALSE(edge_ids.empty());
+
+        auto current = src;
+        common::Weight weight{0};
+        for(const auto id : edge_ids) {
+            const auto* edge = graph.getEdge(id);
+            ASSERT_FALSE(edge->isShortcut());
+            ASSERT_EQ(edge->getSrc(), current);
+            current = edge->getTrg();
+            weight += edge->getWeight();
+        }
+
+        EXPECT_EQ(current, trg);
+        EXPECT_EQ(weight, arc.getWeight());
+    };
+
+    std::size_t number_of_shortcuts = 0;
+    for(std::size_t n = 0; n < search_graph.numberOfNodes(); n++) {
+        const auto rank = common::NodeID{n};
+        const auto node = search_graph.getOriginalNodeOf(rank);
+
+        for(const auto& arc : search_graph.getForwardArcsOf(rank)) {
+            const auto trg = search_graph.getOriginalNodeOf(arc.getTrg());
+            const auto edge_ids = search_graph.unpackForwardArc(arc);
+            number_of_shortcuts += edge_ids.size() > 1;
+            check_arc(arc, node, trg, edge_ids);
+        }
+
+        for(const auto& arc : search_graph.getBackwardArcsOf(rank)) {
+            const auto src = search_graph.getOriginalNodeOf(arc.getTrg());
+            check_arc(arc, src, node, search_graph.unpackBackwardArc(arc));
+        }
+    }
+
+    EXPECT_GT(number_of_shortcuts, 0);
+}
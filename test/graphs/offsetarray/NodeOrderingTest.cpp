@@ -0,0 +1,137 @@
+// all the includes you want to use before the gtest include
+
+#include "../../globals.hpp"
+#include <algorithm>
+#include <algorithms/distoracle/PHAST.hpp>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelCalculator.hpp>
+#include <algorithms/distoracle/hublabels/HubLabelLookup.hpp>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/NodeOrdering.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <numeric>
+#include <parsing/offsetarray/Parser.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+auto isPermutation(std::vector<std::size_t> ranks) noexcept
+    -> bool
+{
+    std::vector<std::size_t> expected(ranks.size());
+    std::iota(std::begin(expected), std::end(expected), 0);
+    std::sort(std::begin(ranks), std::end(ranks));
+    return ranks == expected;
+}
+
+} // namespace
+
+
+TEST(NodeOrderingTest, RanksArePermutationsTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+
+    EXPECT_TRUE(isPermutation(graphs::nodeRanksByHilbertCurve(graph)));
+    EXPECT_TRUE(isPermutation(graphs::nodeRanksByBFS(graph, common::NodeID{0})));
+    EXPECT_TRUE(isPermutation(graphs::nodeRanksByDFS(graph, common::NodeID{42})));
+
+    const auto bfs_ranks = graphs::nodeRanksByBFS(graph, common::NodeID{42});
+    EXPECT_EQ(bfs_ranks[42], 0);
+}
+
+TEST(NodeOrderingTest, AndorraBFSOrderKeepsDistancesTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+    auto reordered = graph;
+
+    const auto [perm, inv_perm] = graphs::reorderNodesByBFS(reordered);
+    graphs::reorderEdgesBySource(reordered);
+
+    const algorithms::distoracle::Dijkstra dijkstra{graph};
+    const algorithms::distoracle::Dijkstra reordered_dijkstra{reordered};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 100; i++) {
+        const common::NodeID source{(i * 7919) % number_of_nodes};
+        const common::NodeID target{(i * 104729 + 13) % number_of_nodes};
+
+        const auto dist = dijkstra.distanceBetween(source, target);
+        const auto reordered_dist = reordered_dijkstra.distanceBetween(common::NodeID{inv_perm[source.get()]},
+                                                                       common::NodeID{inv_perm[target.get()]});
+
+        EXPECT_EQ(dist, reordered_dist);
+    }
+}
+
+TEST(NodeOrderingTest, AndorraLevelThenHilbertOrderTest)
+{
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+    auto reordered = graph;
+
+    const auto [perm, inv_perm] = graphs::reorderNodesByLevelThenHilbertCurve(reordered);
+
+    // the order has to be level descending
+    for(std::size_t i = 1; i < reordered.numberOfNodes(); i++) {
+        EXPECT_GE(reordered.getNodeLevelUnsafe(common::NodeID{i - 1}),
+                  reordered.getNodeLevelUnsafe(common::NodeID{i}));
+    }
+
+    graph = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(graph));
+    reordered = algorithms::distoracle::prepareGraphForPHAST(std::move(reordered));
+
+    const algorithms::distoracle::CHDijkstra dijkstra{graph};
+    const algorithms::distoracle::PHAST phast{reordered};
+
+    const auto number_of_nodes = graph.numberOfNodes();
+    for(std::size_t i = 0; i < 3; i++) {
+        const common::NodeID source{(i * 7919) % number_of_nodes};
+        const auto distances = phast.distancesFrom(common::NodeID{inv_perm[source.get()]});
+
+        for(std::size_t j = 0; j < number_of_nodes; j += 41) {
+            const auto dist = dijkstra.distanceBetween(source, common::NodeID{j});
+            EXPECT_EQ(dist, distances[inv_perm[j]]);
+        }
+    }
+}
+
+TEST(NodeOrderingTest, HubLabelRemapTest)
+{
+    auto example_graph = data_dir + "ch-fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<true>, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+    graph = algorithms::distoracle::prepareGraphForHubLabelCalculator(std::move(graph));
+
+    algorithms::distoracle::HubLabelCalculator calculator{graph};
+    auto hl_lookup = calculator.constructHubLabelLookup();
+    auto reordered_lookup = hl_lookup;
+
+    auto reordered = graph;
+    auto [perm, inv_perm] = graphs::reorderNodesByDFS(reordered, common::NodeID{3});
+    ASSERT_TRUE(reordered_lookup.applyNodePermutation(perm, inv_perm));
+
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        for(std::size_t j = 0; j < graph.numberOfNodes(); j++) {
+            const auto dist = hl_lookup.distanceBetween(common::NodeID{i}, common::NodeID{j});
+            const auto reordered_dist = reordered_lookup.distanceBetween(common::NodeID{inv_perm[i]},
+                                                                         common::NodeID{inv_perm[j]});
+            EXPECT_EQ(dist, reordered_dist);
+        }
+    }
+}
@@ -2,7 +2,10 @@
 
 #include "../../globals.hpp"
 #include <fmt/ranges.h>
+#include <algorithms/distoracle/ch/CHDijkstra.hpp>
+#include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
 #include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/ColumnarNode.hpp>
 #include <graphs/nodes/FMINode.hpp>
 #include <graphs/offsetarray/OffsetArray.hpp>
 #include <parsing/offsetarray/Parser.hpp>
@@ -1731,3 +1734,203 @@ TEST(OffsetArrayTest, OffsetArrayEdgeAdditionTest)
     EXPECT_FALSE(graph.checkIfEdgeExistsBetween(common::NodeID{4}, common::NodeID{4}));
 
 }
+
+TEST(OffsetArrayTest, OffsetArrayEdgeAdditionCompactionTest)
+{
+    auto example_graph = data_dir + "fmi-example.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    auto graph = std::move(graph_opt.value());
+
+    std::vector new_edges{
+        graphs::FMIEdge<false>::parse("0 0 1 3 50").value(),
+        graphs::FMIEdge<false>::parse("1 0 1 3 50").value(),
+        graphs::FMIEdge<false>::parse("0 3 1 3 50").value()};
+
+    graph.addEdges(std::move(new_edges));
+    EXPECT_EQ(graph.numberOfPendingEdges(), 3ul);
+
+    std::vector<std::vector<common::EdgeID>> forward_before;
+    std::vector<std::vector<common::EdgeID>> backward_before;
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        const auto forward = graph.getForwardEdgeIDsOf(common::NodeID{i});
+        const auto backward = graph.getBackwardEdgeIDsOf(common::NodeID{i});
+        forward_before.emplace_back(std::begin(forward), std::end(forward));
+        backward_before.emplace_back(std::begin(backward), std::end(backward));
+    }
+
+    // the new ids are appended to the ids of their nodes
+    EXPECT_EQ(forward_before[0].back(), common::EdgeID{11});
+    EXPECT_EQ(forward_before[1].back(), common::EdgeID{10});
+    EXPECT_EQ(backward_before[0].back(), common::EdgeID{10});
+    EXPECT_EQ(backward_before[3].back(), common::EdgeID{11});
+
+    graph.compact();
+    EXPECT_EQ(graph.numberOfPendingEdges(), 0ul);
+
+    for(std::size_t i = 0; i < graph.numberOfNodes(); i++) {
+        const auto forward = graph.getForwardEdgeIDsOf(common::NodeID{i});
+        const auto backward = graph.getBackwardEdgeIDsOf(common::NodeID{i});
+        EXPECT_EQ(std::vector(std::begin(forward), std::end(forward)), forward_before[i]);
+        EXPECT_EQ(std::vector(std::begin(backward), std::end(backward)), backward_before[i]);
+    }
+
+    // deleting forward ids compacts only the forward direction, the backward edges stay pending
+    graph.addEdges({graphs::FMIEdge<false>::parse("2 4 1 3 50").value()});
+    graph.deleteForwardEdgesIDsIf([](const auto& /*graph*/) {
+        return [](const auto /*id*/) {
+            return false;
+        };
+    });
+    EXPECT_EQ(graph.numberOfPendingEdges(), 1ul);
+    EXPECT_EQ(graph.getBackwardEdgeIDsOf(common::NodeID{4}).back(), common::EdgeID{12});
+
+    graph.compact();
+    EXPECT_EQ(graph.numberOfPendingEdges(), 0ul);
+    EXPECT_EQ(graph.getBackwardEdgeIDsOf(common::NodeID{4}).back(), common::EdgeID{12});
+}
+
+TEST(OffsetArrayTest, AndorraEdgeAdditionOverlayTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+    using Graph = std::remove_cvref_t<decltype(graph)>;
+
+    // the last edges are added in small batches to a graph built without them
+    constexpr std::size_t number_of_added_edges = 2000;
+    const auto number_of_edges = graph.numberOfEdges();
+    const auto nodes = graph.getNodes();
+
+    std::vector<graphs::FMIEdge<false>> edges;
+    for(std::size_t i = 0; i < number_of_edges - number_of_added_edges; i++) {
+        edges.emplace_back(*graph.getEdge(common::EdgeID{i}));
+    }
+    Graph partial{std::vector(std::begin(nodes), std::end(nodes)), std::move(edges)};
+
+    for(auto i = number_of_edges - number_of_added_edges; i < number_of_edges; i += 100) {
+        std::vector<graphs::FMIEdge<false>> batch;
+        for(auto j = i; j < i + 100; j++) {
+            batch.emplace_back(*graph.getEdge(common::EdgeID{j}));
+        }
+        partial.addEdges(std::move(batch));
+    }
+
+    ASSERT_EQ(partial.numberOfEdges(), number_of_edges);
+    ASSERT_EQ(partial.numberOfPendingEdges(), number_of_added_edges);
+
+    const auto check_distances = [&] {
+        const algorithms::distoracle::Dijkstra reference{graph};
+        const algorithms::distoracle::Dijkstra dijkstra{partial};
+
+        for(std::size_t i = 0; i < 5; i++) {
+            const common::NodeID source{(i * 7919) % graph.numberOfNodes()};
+            EXPECT_EQ(dijkstra.distancesFrom(source), reference.distancesFrom(source));
+        }
+    };
+
+    check_distances();
+    partial.compact();
+    EXPECT_EQ(partial.numberOfPendingEdges(), 0ul);
+    check_distances();
+
+    // a batch larger than the compaction threshold is compacted right away
+    std::vector<graphs::FMIEdge<false>> batch;
+    for(std::size_t i = 0; i < 2 * number_of_edges / Graph::COMPACTION_RATIO; i++) {
+        batch.emplace_back(*graph.getEdge(common::EdgeID{i}));
+    }
+    partial.addEdges(std::move(batch));
+    EXPECT_EQ(partial.numberOfPendingEdges(), 0ul);
+}
+
+TEST(OffsetArrayTest, ColumnarNodesMatchRowNodesTest)
+{
+    using RowNode = graphs::FMINode<true>;
+    using ColumnarNode = graphs::ColumnarNode<RowNode>;
+
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto row_opt = parsing::parseFromFMIFile<RowNode, graphs::FMIEdge<true>>(example_graph);
+    auto columnar_opt = parsing::parseFromFMIFile<ColumnarNode, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(row_opt);
+    ASSERT_TRUE(columnar_opt);
+
+    // the sorting by level permutes all columns
+    auto row = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(row_opt.value()));
+    auto columnar = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(columnar_opt.value()));
+
+    ASSERT_EQ(row.numberOfNodes(), columnar.numberOfNodes());
+    EXPECT_FALSE(columnar.getNode(common::NodeID{columnar.numberOfNodes()}));
+
+    for(std::size_t i = 0; i < row.numberOfNodes(); i++) {
+        const common::NodeID id{i};
+        const auto* row_node = row.getNode(id);
+        const auto columnar_node = columnar.getNode(id);
+
+        ASSERT_TRUE(columnar_node);
+        EXPECT_EQ(columnar_node->getLat(), row_node->getLat());
+        EXPECT_EQ(columnar_node->getLng(), row_node->getLng());
+        EXPECT_EQ(columnar_node->getLvl(), row_node->getLvl());
+        EXPECT_EQ(columnar.getNodeLevelUnsafe(id), row.getNodeLevelUnsafe(id));
+        EXPECT_EQ(columnar_node->getID2(), row_node->getID2());
+        EXPECT_EQ(columnar_node->getElevation(), row_node->getElevation());
+
+        // the complete node is rebuilt from the columns
+        EXPECT_EQ(columnar_node->get(), *row_node);
+    }
+
+    std::size_t idx = 0;
+    for(const auto& node : columnar.getNodes()) {
+        EXPECT_EQ(node.getLat(), row.getNodes()[idx++].getLat());
+    }
+    EXPECT_EQ(idx, row.numberOfNodes());
+
+    columnar.setNodeLevel(common::NodeID{0}, common::NodeLevel{12345});
+    EXPECT_EQ(columnar.getNode(common::NodeID{0})->getLvl(), common::NodeLevel{12345});
+    EXPECT_EQ(columnar.getNode(common::NodeID{0})->get().getLvl(), common::NodeLevel{12345});
+}
+
+TEST(OffsetArrayTest, FixedPointColumnarNodesTest)
+{
+    using RowNode = graphs::FMINode<true>;
+    using ColumnarNode = graphs::ColumnarNode<RowNode, true>;
+
+    auto example_graph = data_dir + "ch-andorra.txt";
+    auto row_opt = parsing::parseFromFMIFile<RowNode, graphs::FMIEdge<true>>(example_graph);
+    auto columnar_opt = parsing::parseFromFMIFile<ColumnarNode, graphs::FMIEdge<true>>(example_graph);
+
+    ASSERT_TRUE(row_opt);
+    ASSERT_TRUE(columnar_opt);
+
+    auto row = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(row_opt.value()));
+    auto columnar = algorithms::distoracle::prepareGraphForCHDijkstra(std::move(columnar_opt.value()));
+
+    static_assert(std::is_same_v<decltype(columnar.getLatitudes()), std::span<const std::int32_t>>);
+
+    for(std::size_t i = 0; i < row.numberOfNodes(); i++) {
+        const common::NodeID id{i};
+        const auto* row_node = row.getNode(id);
+        const auto columnar_node = columnar.getNode(id);
+
+        EXPECT_NEAR(columnar_node->getLat().get(), row_node->getLat().get(), 1e-7);
+        EXPECT_NEAR(columnar_node->getLng().get(), row_node->getLng().get(), 1e-7);
+
+        // a rebuilt node has the rounded coordinates of the columns
+        EXPECT_NEAR(columnar_node->get().getLat().get(), row_node->getLat().get(), 1e-7);
+        EXPECT_EQ(columnar_node->get().getID2(), row_node->getID2());
+    }
+
+    // the ch query only reads the level column
+    const algorithms::distoracle::CHDijkstra row_dijkstra{row};
+    const algorithms::distoracle::CHDijkstra columnar_dijkstra{columnar};
+
+    for(std::size_t i = 0; i < 200; i++) {
+        const common::NodeID source{(i * 7919) % row.numberOfNodes()};
+        const common::NodeID target{(i * 104729 + 13) % row.numberOfNodes()};
+        EXPECT_EQ(columnar_dijkstra.distanceBetween(source, target),
+                  row_dijkstra.distanceBetween(source, target));
+    }
+}
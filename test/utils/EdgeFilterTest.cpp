@@ -0,0 +1,153 @@
+// all the includes you want to use before the gtest include
+
+#include "../globals.hpp"
+#include <algorithms/distoracle/dijkstra/Dijkstra.hpp>
+#include <algorithms/pathfinding/dijkstra/BidirectionalDijkstra.hpp>
+#include <graphs/edges/FMIEdge.hpp>
+#include <graphs/nodes/FMINode.hpp>
+#include <graphs/offsetarray/OffsetArray.hpp>
+#include <memory>
+#include <parsing/offsetarray/Parser.hpp>
+#include <utils/EdgeFilter.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(EdgeFilterTest, EdgeMaskTest)
+{
+    util::EdgeMask mask{130};
+
+    EXPECT_EQ(mask.numberOfEdges(), 130ul);
+    EXPECT_EQ(mask.numberOfBlockedEdges(), 0ul);
+
+    mask.block(common::EdgeID{0});
+    mask.block(common::EdgeID{64});
+    mask.block(common::EdgeID{129});
+    mask.block(common::EdgeID{129});
+
+    EXPECT_TRUE(mask.isBlocked(common::EdgeID{0}));
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{1}));
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{63}));
+    EXPECT_TRUE(mask.isBlocked(common::EdgeID{64}));
+    EXPECT_TRUE(mask.isBlocked(common::EdgeID{129}));
+    EXPECT_EQ(mask.numberOfBlockedEdges(), 3ul);
+
+    // edges added to the graph after the mask was created are not blocked
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{130}));
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{1000}));
+
+    // neither in the padding of the last word nor past the words
+    mask.block(common::EdgeID{130});
+    mask.block(common::EdgeID{1000});
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{130}));
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{1000}));
+    EXPECT_EQ(mask.numberOfBlockedEdges(), 3ul);
+    mask.unblock(common::EdgeID{1000});
+    EXPECT_EQ(mask.numberOfBlockedEdges(), 3ul);
+
+    mask.unblock(common::EdgeID{64});
+    EXPECT_FALSE(mask.isBlocked(common::EdgeID{64}));
+    EXPECT_EQ(mask.numberOfBlockedEdges(), 2ul);
+}
+
+TEST(EdgeFilterTest, AndorraEdgeTypeFilterTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+    using Graph = std::remove_cvref_t<decltype(graph)>;
+
+    const auto is_blocked_type = [](const auto type) {
+        return type == common::Type{3};
+    };
+
+    // the reference graph does not contain the blocked edges at all
+    std::vector<graphs::FMIEdge<false>> edges;
+    for(std::size_t i = 0; i < graph.numberOfEdges(); i++) {
+        const auto& edge = *graph.getEdge(common::EdgeID{i});
+        if(!is_blocked_type(edge.getEdgeType())) {
+            edges.emplace_back(edge);
+        }
+    }
+    ASSERT_LT(edges.size(), graph.numberOfEdges());
+
+    const auto nodes = graph.getNodes();
+    const Graph reduced{std::vector(std::begin(nodes), std::end(nodes)), std::move(edges)};
+
+    const util::EdgeTypeFilter filter{is_blocked_type};
+    const algorithms::distoracle::Dijkstra<Graph, util::NoStatistics, decltype(filter)> filtered{graph, filter};
+    const algorithms::distoracle::Dijkstra reference{reduced};
+    algorithms::pathfinding::BidirectionalDijkstra bidirectional{graph, filter};
+
+    for(std::size_t i = 0; i < 10; i++) {
+        const common::NodeID source{(i * 7919) % graph.numberOfNodes()};
+        EXPECT_EQ(filtered.distancesFrom(source), reference.distancesFrom(source));
+
+        for(std::size_t j = 0; j < 10; j++) {
+            const common::NodeID target{(j * 104729 + 13) % graph.numberOfNodes()};
+            EXPECT_EQ(bidirectional.distanceBetween(source, target),
+                      reference.distanceBetween(source, target));
+        }
+    }
+}
+
+TEST(EdgeFilterTest, AndorraSwapEdgeMaskTest)
+{
+    auto example_graph = data_dir + "andorra.txt";
+    auto graph_opt = parsing::parseFromFMIFile<graphs::FMINode<false>, graphs::FMIEdge<false>>(example_graph);
+
+    ASSERT_TRUE(graph_opt);
+    const auto graph = std::move(graph_opt.value());
+    using Graph = std::remove_cvref_t<decltype(graph)>;
+
+    // the default filter and its generation counter take no space in the engine
+    static_assert(sizeof(algorithms::distoracle::Dijkstra<Graph>)
+                  < sizeof(algorithms::distoracle::Dijkstra<Graph, util::NoStatistics, util::EdgeMaskFilter>));
+
+    auto empty_mask = std::make_shared<const util::EdgeMask>(graph.numberOfEdges());
+    algorithms::distoracle::Dijkstra<Graph, util::NoStatistics, util::EdgeMaskFilter> dijkstra{graph, util::EdgeMaskFilter{empty_mask}};
+    algorithms::pathfinding::BidirectionalDijkstra bidirectional{graph, util::EdgeMaskFilter{empty_mask}};
+
+    const common::NodeID source{0};
+    const common::NodeID target{graph.numberOfNodes() / 2};
+
+    const auto path = bidirectional.pathBetween(source, target);
+    ASSERT_TRUE(path);
+    ASSERT_GT(path->getNumberOfNodes(), 1ul);
+    EXPECT_EQ(dijkstra.distanceBetween(source, target), path->getCost());
+
+    // close the first road of the path, the graph itself stays untouched
+    const auto closed = graph.getForwardEdgeIDBetween((*path)[0], (*path)[1]);
+    ASSERT_TRUE(closed);
+
+    auto closure = std::make_shared<util::EdgeMask>(graph.numberOfEdges());
+    closure->block(closed.value());
+    const util::EdgeMaskFilter closure_filter{std::move(closure)};
+
+    dijkstra.setEdgeFilter(closure_filter);
+    bidirectional.setEdgeFilter(closure_filter);
+
+    const auto detour = bidirectional.pathBetween(source, target);
+    const auto detour_cost = detour ? detour->getCost() : common::INFINITY_WEIGHT;
+    EXPECT_GE(detour_cost, path->getCost());
+    EXPECT_EQ(dijkstra.distanceBetween(source, target), detour_cost);
+
+    if(detour) {
+        for(std::size_t i = 0; i + 1 < detour->getNumberOfNodes(); i++) {
+            const auto id = graph.getForwardEdgeIDBetween((*detour)[static_cast<int>(i)], (*detour)[static_cast<int>(i + 1)]);
+            ASSERT_TRUE(id);
+            EXPECT_FALSE(closure_filter.getMask()->isBlocked(id.value()));
+        }
+    }
+
+    // the mask is shared by all threads computing the table
+    const std::vector sources{source, target};
+    std::vector<common::Weight> table(sources.size() * sources.size());
+    ASSERT_TRUE(dijkstra.distanceTable(sources, sources, table));
+    EXPECT_EQ(table[1], detour_cost);
+
+    dijkstra.setEdgeFilter(util::EdgeMaskFilter{empty_mask});
+    EXPECT_EQ(dijkstra.distanceBetween(source, target), path->getCost());
+}
@@ -1,5 +1,8 @@
 // all the includes you want to use before the gtest include
+#include <algorithm>
 #include <fmt/ranges.h>
+#include <numeric>
+#include <random>
 #include <utils/Permutation.hpp>
 
 #include <gtest/gtest.h>
@@ -182,4 +185,54 @@ TEST(PermutationTest, CombinePermutationTest2)
     EXPECT_EQ(combined2[4], 4);
 }
 
+TEST(PermutationTest, ApplyLargePermutationInParallelTest)
+{
+    // large enough to take the parallel gather path
+    const std::size_t size = 100000;
+    std::vector<std::size_t> permutation(size);
+    std::iota(std::begin(permutation), std::end(permutation), 0);
+    std::shuffle(std::begin(permutation), std::end(permutation), std::mt19937{42});
+
+    std::vector<std::size_t> data(size);
+    std::iota(std::begin(data), std::end(data), 0);
+
+    const auto gathered = util::applyPermutation(data, permutation);
+    const auto in_place = util::applyPermutationInPlace(data, permutation);
+
+    EXPECT_EQ(gathered, permutation);
+    EXPECT_EQ(in_place, permutation);
+
+    const auto inverse = util::inversePermutation(permutation);
+    EXPECT_EQ(util::combine(permutation, inverse), data);
+}
+
+namespace {
+
+struct NoDefaultConstructor
+{
+    explicit NoDefaultConstructor(int value) noexcept
+        : value_(value) {}
 
+    int value_;
+};
+
+} // namespace
+
+TEST(PermutationTest, ApplyPermutationWithoutDefaultConstructorTest)
+{
+    // the elements cannot be default constructed, hence the copy based gather is used
+    std::vector<std::size_t> permutation{5, 4, 0, 1, 2, 3};
+    std::vector<NoDefaultConstructor> data;
+    for(int i = 0; i < 6; i++) {
+        data.emplace_back(i);
+    }
+
+    data = util::applyPermutation(std::move(data), permutation);
+
+    EXPECT_EQ(data[0].value_, 5);
+    EXPECT_EQ(data[1].value_, 4);
+    EXPECT_EQ(data[2].value_, 0);
+    EXPECT_EQ(data[3].value_, 1);
+    EXPECT_EQ(data[4].value_, 2);
+    EXPECT_EQ(data[5].value_, 3);
+}
@@ -0,0 +1,32 @@
+// all the includes you want to use before the gtest include
+#include <utils/Polyline.hpp>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+TEST(PolylineTest, ReferenceExampleTest)
+{
+    const std::vector<std::pair<common::Latitude, common::Longitude>> coordinates{
+        {common::Latitude{38.5}, common::Longitude{-120.2}},
+        {common::Latitude{40.7}, common::Longitude{-120.95}},
+        {common::Latitude{43.252}, common::Longitude{-126.453}}};
+
+    EXPECT_EQ(util::encodePolyline(coordinates), "_p~iF~ps|U_ulLnnqC_mqNvxq`@");
+}
+
+TEST(PolylineTest, AppendTest)
+{
+    const std::vector<std::pair<common::Latitude, common::Longitude>> empty;
+    EXPECT_EQ(util::encodePolyline(empty), "");
+
+    const std::vector<std::pair<common::Latitude, common::Longitude>> coordinates{
+        {common::Latitude{38.5}, common::Longitude{-120.2}}};
+
+    std::string out = "prefix";
+    util::appendPolyline(out, coordinates);
+    EXPECT_EQ(out, "prefix_p~iF~ps|U");
+
+    // with 6 decimal places every value is ten times larger
+    EXPECT_EQ(util::encodePolyline(coordinates, 6), "_izlhA~rlgdF");
+}
@@ -0,0 +1,65 @@
+// all the includes you want to use before the gtest include
+#include <utils/QueryStatistics.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(QueryStatisticsTest, AggregatesQueriesTest)
+{
+    util::QueryStatistics statistics;
+
+    statistics.beginQuery();
+    statistics.count(util::QueryCounter::SETTLED_NODES, 5);
+    statistics.count(util::QueryCounter::RELAXED_EDGES);
+    statistics.endQuery();
+
+    EXPECT_EQ(statistics.numberOfQueries(), 1ul);
+    EXPECT_EQ(statistics.lastQuery(util::QueryCounter::SETTLED_NODES), 5ul);
+    EXPECT_EQ(statistics.lastQuery(util::QueryCounter::RELAXED_EDGES), 1ul);
+
+    {
+        const util::QueryScope scope{statistics};
+        statistics.count(util::QueryCounter::SETTLED_NODES, 2);
+    }
+
+    EXPECT_EQ(statistics.numberOfQueries(), 2ul);
+    EXPECT_EQ(statistics.lastQuery(util::QueryCounter::SETTLED_NODES), 2ul);
+    EXPECT_EQ(statistics.lastQuery(util::QueryCounter::RELAXED_EDGES), 0ul);
+    EXPECT_EQ(statistics.total(util::QueryCounter::SETTLED_NODES), 7ul);
+    EXPECT_EQ(statistics.max(util::QueryCounter::SETTLED_NODES), 5ul);
+
+    // 5 falls into the bucket 4-7 and 2 into the bucket 2-3
+    const auto& histogram = statistics.histogram(util::QueryCounter::SETTLED_NODES);
+    EXPECT_EQ(histogram[3], 1ul);
+    EXPECT_EQ(histogram[2], 1ul);
+    EXPECT_EQ(statistics.histogram(util::QueryCounter::RELAXED_EDGES)[0], 1ul);
+    EXPECT_EQ(statistics.histogram(util::QueryCounter::RELAXED_EDGES)[1], 1ul);
+}
+
+TEST(QueryStatisticsTest, MergeAndJsonTest)
+{
+    util::QueryStatistics first;
+    util::QueryStatistics second;
+
+    {
+        const util::QueryScope scope{first};
+        first.count(util::QueryCounter::QUEUE_PUSHES, 3);
+    }
+    {
+        const util::QueryScope scope{second};
+        second.count(util::QueryCounter::QUEUE_PUSHES, 8);
+    }
+
+    first.merge(second);
+
+    EXPECT_EQ(first.numberOfQueries(), 2ul);
+    EXPECT_EQ(first.total(util::QueryCounter::QUEUE_PUSHES), 11ul);
+    EXPECT_EQ(first.max(util::QueryCounter::QUEUE_PUSHES), 8ul);
+
+    const auto json = first.toJson();
+    EXPECT_NE(json.find("\"queries\": 2"), std::string::npos);
+    EXPECT_NE(json.find("\"queue_pushes\": {\"total\": 11, \"max\": 8, \"histogram\": {\"3\": 1, \"15\": 1}}"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"settled_nodes\": {\"total\": 0, \"max\": 0, \"histogram\": {\"0\": 2}}"),
+              std::string::npos);
+}
@@ -0,0 +1,89 @@
+// all the includes you want to use before the gtest include
+#include <utils/VersionedArray.hpp>
+
+#include <gtest/gtest.h>
+
+
+TEST(VersionedArrayTest, ClearInvalidatesEntriesTest)
+{
+    util::VersionedArray array(5, -1);
+
+    for(std::size_t i = 0; i < array.size(); i++) {
+        EXPECT_EQ(array[i], -1);
+        EXPECT_FALSE(array.isSet(i));
+    }
+
+    array.set(1, 10);
+    array.set(3, 30);
+
+    EXPECT_EQ(array[1], 10);
+    EXPECT_EQ(array[3], 30);
+    EXPECT_TRUE(array.isSet(1));
+    EXPECT_FALSE(array.isSet(2));
+
+    array.clear();
+
+    for(std::size_t i = 0; i < array.size(); i++) {
+        EXPECT_EQ(array[i], -1);
+        EXPECT_FALSE(array.isSet(i));
+    }
+
+    array.set(3, 5);
+    EXPECT_EQ(array[3], 5);
+    EXPECT_EQ(array[1], -1);
+}
+
+TEST(VersionedArrayTest, SettleTest)
+{
+    util::VersionedArray array(3, -1);
+
+    array.set(0, 7);
+    array.settle(0);
+    array.settle(1);
+
+    EXPECT_TRUE(array.isSettled(0));
+    EXPECT_TRUE(array.isSettled(1));
+    EXPECT_FALSE(array.isSettled(2));
+
+    // settling keeps the value, unwritten entries read as the default value
+    EXPECT_EQ(array[0], 7);
+    EXPECT_EQ(array[1], -1);
+
+    // writing a settled entry does not unsettle it
+    array.set(0, 3);
+    EXPECT_EQ(array[0], 3);
+    EXPECT_TRUE(array.isSettled(0));
+
+    array.clear();
+
+    EXPECT_FALSE(array.isSettled(0));
+    EXPECT_FALSE(array.isSettled(1));
+    EXPECT_EQ(array[0], -1);
+}
+
+TEST(VersionedArrayTest, ExportTest)
+{
+    util::VersionedArray array(4, 0);
+    array.set(2, 4);
+    array.clear();
+    array.set(1, 2);
+
+    std::vector<int> out;
+    array.exportTo(out);
+
+    EXPECT_EQ(out, (std::vector{0, 2, 0, 0}));
+}
+
+TEST(VersionedArrayTest, ManyGenerationsTest)
+{
+    util::VersionedArray array(2, -1);
+
+    for(int i = 0; i < 100000; i++) {
+        array.clear();
+        EXPECT_FALSE(array.isSet(0));
+        array.set(0, i);
+        array.settle(1);
+        EXPECT_EQ(array[0], i);
+        EXPECT_TRUE(array.isSettled(1));
+    }
+}